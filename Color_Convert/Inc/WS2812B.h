@@ -15,10 +15,160 @@
 #include "main.h"
 #include <stdint.h>
 
+#ifndef LED_NUM
 #define LED_NUM                8
+#endif
 #define WS2812B_LED_NUM        LED_NUM
 #define WS2812B_DATA_SIZE      (24 * WS2812B_LED_NUM)
 
+/**
+ * @brief Strip panjang: di atas 150 LED, default buffer modul lain diperkecil
+ *        agar firmware tetap muat di 20 KB SRAM STM32F103C8.
+ *
+ * Perkiraan RAM build WS2812B_BENCHMARK (semua modul, ukuran ARM 32-bit):
+ * | Buffer                                | 60 LED        | 300 LED       |
+ * |---------------------------------------|---------------|---------------|
+ * | pwmData (24 B per LED + 50)           | 1490 B        | 7250 B        |
+ * | Framebuffer RGB (WS2812B_Frame)       | 180 B         | 900 B         |
+ * | Protocol: buffer paket + ring RX      | 182 + 2048 B  | 902 + 2048 B  |
+ * | Tween (kedalaman 4 / 2)               | 720 B         | 1800 B        |
+ * | Frame HSV (WS2812B_Blend)             | 240 B         | 1200 B        |
+ * | Record (256 / 72 entri)               | 2048 B        | 576 B         |
+ * | Palette + indeks (256 / 64 warna)     | 828 B         | 492 B         |
+ * | Cycle cache (lihat WS2812B_Cycle.h)   | 0 B           | 0 B           |
+ * | Modul lain (queue, stream, script...) | ~2.0 KB       | ~2.0 KB       |
+ * | main.c: handle HAL + scratch benchmark| ~0.6 KB       | ~1.6 KB       |
+ * | .RamFunc (kode di SRAM)               | ~4.5 KB       | 0 B           |
+ * | Stack + heap minimum (linker script)  | 1.5 KB        | 1.5 KB        |
+ * | Total                                 | ~16.5 KB      | ~19.8 KB      |
+ *
+ * Tanpa WS2812B_BENCHMARK, frame HSV dan scratch benchmark dibuang linker
+ * (sekitar 17,5 KB untuk 300 LED). Setiap default bisa ditimpa dengan -D.
+ */
+#define WS2812B_LONG_STRIP     (LED_NUM > 150)
+
+/**
+ * @brief Menempatkan fungsi kritis di SRAM (.RamFunc, disalin bersama .data saat startup).
+ *
+ * Menghilangkan 2 wait state flash (konfigurasi 72 MHz) dari loop utama.
+ * Memakan SRAM sebesar ukuran fungsi (~4,5 KB); build dengan -DWS2812B_NO_RAMFUNC
+ * agar semua berjalan dari flash (mis. untuk membandingkan jumlah siklus).
+ * Strip panjang (WS2812B_LONG_STRIP) selalu berjalan dari flash: SRAM-nya
+ * dipakai untuk buffer.
+ */
+#if !defined(WS2812B_NO_RAMFUNC) && !WS2812B_LONG_STRIP
+#define WS2812B_RAMFUNC        __attribute__((section(".RamFunc"), noinline))
+#else
+#define WS2812B_RAMFUNC
+#endif
+
+/**
+ * @brief Menempatkan variabel di .noinit (tidak di-nol-kan saat reset).
+ *
+ * Isi variabel bertahan setelah soft reset / watchdog reset, tetapi acak setelah
+ * power-on; selalu validasi dengan checksum (lihat WS2812B_Warm.h).
+ */
+#define WS2812B_NOINIT         __attribute__((section(".noinit")))
+
+/**
+ * @brief Satu slot PWM: nilai compare TIM3 untuk satu bit.
+ *
+ * Selebar 1 byte karena periode bit maksimal 90 tick (TIM3 72 MHz). DMA
+ * membaca byte dari memori dan menulis halfword ke CCR1 (MSIZE 8 bit, PSIZE
+ * 16 bit, di-extend dengan nol), sehingga pwmData hanya 24 byte per LED:
+ * 300 LED = 7,2 KB, bukan 14,4 KB.
+ */
+typedef uint8_t ws2812b_pwm_t;
+
+/** @brief Buffer PWM untuk DMA (24 bit per LED + 50 bit reset), didefinisikan di WS2812B.c */
+extern ws2812b_pwm_t pwmData[WS2812B_DATA_SIZE + 50];
+
+/**
+ * @brief Timing PWM untuk satu clock timer.
+ */
+typedef struct {
+    uint16_t period;    ///< Nilai auto-reload TIM3 (periode bit = period + 1 tick)
+    uint16_t t1h;       ///< Nilai compare untuk bit "1" (~800 ns HIGH)
+    uint16_t t0h;       ///< Nilai compare untuk bit "0" (~400 ns HIGH)
+} ws2812b_timing_t;
+
+/**
+ * @brief Mode cermin/simetri: efek hanya me-render 1/N strip pertama.
+ *
+ * Nilai enum = log2(N). Sisa strip diisi WS2812B_ApplyMirror() dengan menyalin
+ * blok PWM yang sudah di-encode (terbalik), jadi biaya render efek turun ~N kali.
+ */
+typedef enum {
+    WS2812B_MIRROR_NONE = 0,    ///< Tanpa cermin
+    WS2812B_MIRROR_2 = 1,       ///< Simetris terhadap tengah strip
+    WS2812B_MIRROR_4 = 2,       ///< Kaleidoskop 4 bagian
+    WS2812B_MIRROR_8 = 3        ///< Kaleidoskop 8 bagian
+} ws2812b_mirror_t;
+
+// === Timing ===
+
+/**
+ * @brief Menghitung periode TIM3 dan lebar pulsa bit untuk clock timer tertentu.
+ * @param timer_hz Clock input TIM3 (Hz, prescaler 0)
+ * @param[out] timing Hasil perhitungan
+ */
+void WS2812B_ComputeTiming(uint32_t timer_hz, ws2812b_timing_t *timing);
+
+/**
+ * @brief Menerapkan timing untuk clock TIM3 tertentu (periode + lebar pulsa).
+ * @param timer_hz Clock input TIM3 (Hz)
+ */
+void WS2812B_SetTiming(uint32_t timer_hz);
+
+/**
+ * @brief Mendeteksi clock TIM3 dari konfigurasi RCC lalu menerapkan timing yang sesuai.
+ * @note Panggil setelah MX_TIM3_Init(). Juga mengatur lebar memori DMA TIM3
+ *       ke byte (lihat @ref ws2812b_pwm_t).
+ */
+void WS2812B_InitTiming(void);
+
+// === Cermin / Simetri ===
+
+/**
+ * @brief Mengatur mode cermin.
+ * @param mode Lihat @ref ws2812b_mirror_t
+ */
+void WS2812B_SetMirror(ws2812b_mirror_t mode);
+
+/**
+ * @brief Mode cermin saat ini.
+ * @return Lihat @ref ws2812b_mirror_t
+ */
+ws2812b_mirror_t WS2812B_GetMirror(void);
+
+/**
+ * @brief Jumlah LED yang perlu di-render efek pada mode cermin saat ini.
+ * @return LED_NUM tanpa cermin, ceil(LED_NUM / N) dengan cermin N bagian.
+ */
+uint16_t WS2812B_RenderLength(void);
+
+/**
+ * @brief Menyalin LED 0 .. RenderLength()-1 secara terbalik ke sisa strip.
+ * @note Dipanggil oleh efek yang me-render RenderLength() LED (Rainbow,
+ *       RainbowChase, Pattern_Encode), bukan oleh WS2812B_Send(): frame dari
+ *       framebuffer, tween, dan kirim ulang warm tetap utuh.
+ */
+void WS2812B_ApplyMirror(void);
+
+// === Skala Output (Pembatas Arus) ===
+
+/**
+ * @brief Mengatur faktor skala yang dikalikan ke setiap warna saat encode.
+ * @param scale Q8: 256 = penuh, 128 = setengah (dipakai oleh WS2812B_Current)
+ * @note Berlaku untuk semua jalur output (efek, framebuffer, stream), mulai dari frame berikutnya yang di-encode.
+ */
+void WS2812B_SetOutputScale(uint16_t scale);
+
+/**
+ * @brief Faktor skala output saat ini (Q8, 256 = penuh).
+ */
+uint16_t WS2812B_GetOutputScale(void);
+
 // === Fungsi Dasar (RGB) ===
 
 /**
@@ -48,6 +198,15 @@ void WS2812B_SetPixelRGB(uint16_t pixel, uint8_t red, uint8_t green, uint8_t blu
  */
 void WS2812B_SetColorRGB(uint8_t red, uint8_t green, uint8_t blue);
 
+/**
+ * @brief Meng-encode satu warna RGB menjadi 24 nilai compare PWM.
+ * @param dst   Buffer tujuan (24 elemen)
+ * @param red   Komponen merah (0–255)
+ * @param green Komponen hijau (0–255)
+ * @param blue  Komponen biru (0–255)
+ */
+void WS2812B_EncodeRGB(ws2812b_pwm_t *dst, uint8_t red, uint8_t green, uint8_t blue);
+
 // === HSV (Hue, Saturation, Value) ===
 
 /**
@@ -67,6 +226,58 @@ void WS2812B_SetColorHSV(uint16_t hue, uint8_t sat, uint8_t val);
  */
 void WS2812B_SetPixelHSV(uint16_t pixel, uint16_t hue, uint8_t sat, uint8_t val);
 
+/**
+ * @brief Konversi HSV ke RGB tanpa mengubah strip.
+ * @param hue   Hue (0–359)
+ * @param sat   Saturasi (0–100%)
+ * @param val   Nilai (0–100%)
+ * @param[out] red, green, blue Hasil RGB (0–255)
+ */
+void WS2812B_HSVToRGB(uint16_t hue, uint8_t sat, uint8_t val, uint8_t *red, uint8_t *green, uint8_t *blue);
+
+// === HSV dengan hue 16-bit (animasi lambat yang halus) ===
+
+/** @brief Derajat (0–359) ke hue 16-bit (0–65535 = satu putaran penuh). */
+#define WS2812B_HUE16(deg)              ((uint16_t)((((uint32_t)(deg) % 360U) * 65536UL + 359U) / 360U))
+
+/** @brief Hue 16-bit ke derajat (0–359, dibulatkan ke bawah). */
+#define WS2812B_HUE16_TO_DEG(hue16)     ((uint16_t)(((uint32_t)(hue16) * 360U) >> 16))
+
+/**
+ * @brief Langkah fase 8.8 (derajat x 256 per frame) ke langkah hue 16-bit.
+ * @note Sama dengan round(step x 65536 / 92160), tanpa overflow untuk langkah
+ *       di atas 0xFFFF; hasil di atas satu putaran berputar sendiri.
+ */
+#define WS2812B_HUE16_STEP(step_8_8)    ((uint16_t)(((uint32_t)(step_8_8) * 32U + 22U) / 45U))
+
+/**
+ * @brief Konversi HSV (hue 16-bit) ke RGB tanpa mengubah strip.
+ * @param hue16 Hue (0–65535 = 0–360°, resolusi ~0,0055°)
+ * @param sat   Saturasi (0–100%)
+ * @param val   Nilai (0–100%)
+ * @param[out] red, green, blue Hasil RGB (0–255)
+ * @note Hue 16-bit berputar sendiri saat overflow, jadi akumulator fase
+ *       tidak perlu modulo 360.
+ */
+void WS2812B_HSV16ToRGB(uint16_t hue16, uint8_t sat, uint8_t val, uint8_t *red, uint8_t *green, uint8_t *blue);
+
+/**
+ * @brief Mengatur semua LED dengan warna HSV (hue 16-bit).
+ * @param hue16 Hue (0–65535)
+ * @param sat   Saturasi (0–100%)
+ * @param val   Nilai (0–100%)
+ */
+void WS2812B_SetColorHSV16(uint16_t hue16, uint8_t sat, uint8_t val);
+
+/**
+ * @brief Mengatur satu LED dengan warna HSV (hue 16-bit).
+ * @param pixel Indeks LED
+ * @param hue16 Hue (0–65535)
+ * @param sat   Saturasi (0–100%)
+ * @param val   Nilai (0–100%)
+ */
+void WS2812B_SetPixelHSV16(uint16_t pixel, uint16_t hue16, uint8_t sat, uint8_t val);
+
 // === HSL (Hue, Saturation, Lightness) ===
 
 /**
@@ -86,6 +297,15 @@ void WS2812B_SetColorHSL(uint16_t hue, uint8_t sat, uint8_t light);
  */
 void WS2812B_SetPixelHSL(uint16_t pixel, uint16_t hue, uint8_t sat, uint8_t light);
 
+/**
+ * @brief Konversi HSL ke RGB tanpa mengubah strip.
+ * @param hue   Hue (0–359)
+ * @param sat   Saturasi (0–100%)
+ * @param light Kecerahan (0–100%)
+ * @param[out] red, green, blue Hasil RGB (0–255)
+ */
+void WS2812B_HSLToRGB(uint16_t hue, uint8_t sat, uint8_t light, uint8_t *red, uint8_t *green, uint8_t *blue);
+
 // === Efek Dasar (Legacy - bisa diganti dengan Effects API) ===
 
 void WS2812B_RainbowClassic(void);
@@ -94,4 +314,19 @@ void WS2812B_PastelLoop(uint16_t *hue);
 void WS2812B_MonochromeBreathe(uint16_t hue, uint8_t *brightness, int8_t *direction);
 void WS2812B_TheaterChaseSimple(uint16_t hue, uint8_t frame);
 
+/**
+ * @brief Theater chase sederhana dengan hue 16-bit (rotasi warna di bawah satu derajat).
+ */
+void WS2812B_TheaterChaseHSV16(uint16_t hue16, uint8_t frame);
+
+/**
+ * @brief Baca state generator acak efek api (untuk snapshot WS2812B_Warm dan WS2812B_Record).
+ */
+uint32_t WS2812B_GetFireSeed(void);
+
+/**
+ * @brief Pulihkan state generator acak efek api (0 diabaikan).
+ */
+void WS2812B_SetFireSeed(uint32_t seed);
+
 #endif /* WS2812B_H */
\ No newline at end of file
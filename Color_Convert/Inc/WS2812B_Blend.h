@@ -0,0 +1,133 @@
+/**
+ * @file WS2812B_Blend.h
+ * @brief Hue-aware color blending and an HSV framebuffer converted once at encode.
+ *
+ * A linear RGB crossfade from red to magenta passes through dull, darker
+ * mixes, and a naive hue lerp from 350° to 10° turns the long way round the
+ * wheel. WS2812B_Blend_Hue() interpolates on the 16-bit hue circle along a
+ * chosen arc (shortest, or a fixed direction), and WS2812B_Blend_HSV() also
+ * handles greys, whose hue is meaningless, by keeping the other end's hue.
+ *
+ * The HSV framebuffer stores hue (16-bit), saturation and value per LED, so
+ * transitions between two HSV frames stay in HSV space and each LED is
+ * converted to RGB exactly once, while encoding (WS2812B_HSVFrame_Show()) or
+ * streaming (WS2812B_Shader_HSVFrame with WS2812B_Stream_Start()).
+ *
+ * RAM: 4 bytes per LED (1200 B for 300 LEDs) plus any source frames the
+ * caller keeps for crossfades.
+ */
+
+#ifndef WS2812B_BLEND_H
+#define WS2812B_BLEND_H
+
+#include "WS2812B.h"
+#include <stdint.h>
+
+/**
+ * @brief Which way round the hue circle a blend travels.
+ */
+typedef enum {
+    WS2812B_HUE_SHORTEST = 0,   ///< Shorter arc (ties go clockwise)
+    WS2812B_HUE_CW,             ///< Always towards increasing hue
+    WS2812B_HUE_CCW             ///< Always towards decreasing hue
+} ws2812b_hue_path_t;
+
+/**
+ * @brief One HSV color (4 bytes).
+ */
+typedef struct {
+    uint16_t hue;               ///< Hue, 0–65535 = 0–360° (see WS2812B_HUE16())
+    uint8_t sat;                ///< Saturation (0–100%)
+    uint8_t val;                ///< Value (0–100%)
+} ws2812b_hsv_t;
+
+// ===================================================================
+// ============================= BLENDING ============================
+// ===================================================================
+
+/**
+ * @brief Interpolate between two hues along the given arc.
+ * @param from Start hue (16-bit)
+ * @param to End hue (16-bit)
+ * @param amount 0 = @p from, 255 = @p to
+ * @param path @ref ws2812b_hue_path_t
+ * @return Blended hue (16-bit).
+ */
+uint16_t WS2812B_Blend_Hue(uint16_t from, uint16_t to, uint8_t amount, ws2812b_hue_path_t path);
+
+/**
+ * @brief Interpolate between two HSV colors.
+ * @param from Start color
+ * @param to End color
+ * @param amount 0 = @p from, 255 = @p to
+ * @param path Hue arc
+ * @return Blended color.
+ * @note A fully desaturated end takes the other end's hue, so a fade from
+ *       white or black to a color does not sweep through the wheel.
+ */
+ws2812b_hsv_t WS2812B_Blend_HSV(ws2812b_hsv_t from, ws2812b_hsv_t to, uint8_t amount, ws2812b_hue_path_t path);
+
+/**
+ * @brief Interpolate between two RGB colors component-wise.
+ * @param from Start color (R, G, B)
+ * @param to End color (R, G, B)
+ * @param amount 0 = @p from, 255 = @p to
+ * @param[out] out Blended color (R, G, B)
+ */
+void WS2812B_Blend_RGB(const uint8_t from[3], const uint8_t to[3], uint8_t amount, uint8_t out[3]);
+
+// ===================================================================
+// ========================== HSV FRAMEBUFFER ========================
+// ===================================================================
+
+/**
+ * @brief Set one LED of the HSV framebuffer.
+ * @param pixel LED index (0 to LED_NUM - 1)
+ * @param color HSV color
+ */
+void WS2812B_HSVFrame_SetPixel(uint16_t pixel, ws2812b_hsv_t color);
+
+/**
+ * @brief Read one LED of the HSV framebuffer (black if out of range).
+ */
+ws2812b_hsv_t WS2812B_HSVFrame_GetPixel(uint16_t pixel);
+
+/**
+ * @brief Set every LED to the same HSV color.
+ */
+void WS2812B_HSVFrame_Fill(ws2812b_hsv_t color);
+
+/**
+ * @brief Direct access to the LED_NUM-entry framebuffer (e.g. to snapshot it).
+ */
+ws2812b_hsv_t* WS2812B_HSVFrame_Buffer(void);
+
+/**
+ * @brief Crossfade two HSV frames into the framebuffer.
+ * @param from Start frame (LED_NUM entries)
+ * @param to End frame (LED_NUM entries)
+ * @param amount 0 = @p from, 255 = @p to
+ * @param path Hue arc
+ * @note @p from or @p to may be WS2812B_HSVFrame_Buffer() itself.
+ */
+void WS2812B_HSVFrame_Crossfade(const ws2812b_hsv_t *from, const ws2812b_hsv_t *to,
+                                uint8_t amount, ws2812b_hue_path_t path);
+
+/**
+ * @brief Convert and encode the HSV framebuffer into the PWM buffer.
+ */
+void WS2812B_HSVFrame_Encode(void);
+
+/**
+ * @brief Encode and transmit the HSV framebuffer.
+ */
+void WS2812B_HSVFrame_Show(void);
+
+/**
+ * @brief Pixel shader converting the HSV framebuffer, for WS2812B_Stream_Start().
+ * @note LEDs beyond LED_NUM are black. ctx is unused.
+ */
+void WS2812B_Shader_HSVFrame(uint16_t index, uint32_t time, const void *ctx,
+                             uint8_t *red, uint8_t *green, uint8_t *blue);
+
+#endif /* WS2812B_BLEND_H */
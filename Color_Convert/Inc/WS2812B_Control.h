@@ -0,0 +1,150 @@
+/**
+ * @file WS2812B_Control.h
+ * @brief Lock-free handoff of effect parameters and commands from ISRs to the render loop.
+ *
+ * Two mechanisms, neither of which disables interrupts:
+ * - A double-buffered parameter block guarded by a sequence counter. One
+ *   producer (e.g. the UART ISR) publishes a complete @ref ws2812b_params_t;
+ *   the renderer takes a consistent snapshot once per frame.
+ * - Single-producer/single-consumer command queues for discrete events
+ *   (next effect, brightness step, power). Give each interrupt source its own
+ *   queue; WS2812B_Control_Post() uses the default one.
+ *
+ * The render loop calls WS2812B_Control_Apply() once per frame, before
+ * WS2812B_Effects_Handle(), so parameters never change mid-frame.
+ */
+
+#ifndef WS2812B_CONTROL_H
+#define WS2812B_CONTROL_H
+
+#include "WS2812B_Effects.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_CMD_QUEUE_SIZE
+#define WS2812B_CMD_QUEUE_SIZE  16  ///< Commands per queue (power of two)
+#endif
+
+/**
+ * @brief Complete parameter set published by a producer.
+ */
+typedef struct {
+    ws2812b_effect_t effect;    ///< Effect to run
+    uint16_t hue;               ///< Base hue (0–359)
+    uint8_t brightness;         ///< Global brightness (0–100%)
+    uint8_t speed;              ///< Speed level (1–100)
+    bool auto_cycle;            ///< Automatic effect rotation
+    uint32_t cycle_duration;    ///< Time per effect in milliseconds
+} ws2812b_params_t;
+
+/**
+ * @brief Discrete command types.
+ */
+typedef enum {
+    CMD_NONE,
+    CMD_SET_EFFECT,         ///< value = @ref ws2812b_effect_t (disables auto-cycle)
+    CMD_NEXT_EFFECT,        ///< Step to the next auto-cycle effect
+    CMD_SET_HUE,            ///< value = hue (0–359)
+    CMD_SET_BRIGHTNESS,     ///< value = brightness (0–100%)
+    CMD_ADJUST_BRIGHTNESS,  ///< value = signed brightness step (clamped to 0–100%)
+    CMD_SET_SPEED,          ///< value = speed (1–100)
+    CMD_SET_AUTO_CYCLE,     ///< value = 0/1
+    CMD_POWER,              ///< value = 0 off, 1 on, -1 toggle
+    CMD_RECALL_PRESET,      ///< value = preset index | (crossfade frames << 8)
+    CMD_SAVE_PRESET,        ///< value = user slot; stores the current state as preset BUILTIN_COUNT + slot
+    CMD_SET_MIRROR,         ///< value = @ref ws2812b_mirror_t (0 = off, 1/2/3 = 2/4/8 parts)
+    CMD_SET_HUE_STEP,       ///< value = hue advance per frame, 8.8 fixed-point degrees
+    CMD_PLAYLIST,           ///< value = @ref ws2812b_playlist_action_t
+    CMD_RECORD,             ///< value = @ref ws2812b_record_action_t
+    CMD_SET_CURRENT_LIMIT,  ///< value = supply current limit in mA (0 = off)
+    CMD_STATUS              ///< value ignored; replies with PACKET_STATUS
+} ws2812b_cmd_type_t;
+
+/**
+ * @brief One command.
+ */
+typedef struct {
+    uint8_t type;           ///< @ref ws2812b_cmd_type_t
+    int32_t value;          ///< Command argument
+} ws2812b_cmd_t;
+
+/**
+ * @brief SPSC command ring (one producer context, one consumer context).
+ */
+typedef struct {
+    ws2812b_cmd_t buf[WS2812B_CMD_QUEUE_SIZE];
+    volatile uint16_t head;     ///< Written by the producer only
+    volatile uint16_t tail;     ///< Written by the consumer only
+} ws2812b_cmd_queue_t;
+
+// ===================================================================
+// ========================= PARAMETER BLOCK =========================
+// ===================================================================
+
+/**
+ * @brief Publish a complete parameter set (single producer, ISR-safe, wait-free).
+ * @param params New parameters.
+ */
+void WS2812B_Params_Publish(const ws2812b_params_t *params);
+
+/**
+ * @brief Take a consistent snapshot of the latest parameters.
+ * @param[out] params Snapshot.
+ * @return Sequence number of the snapshot (0 = nothing published yet).
+ */
+uint32_t WS2812B_Params_Snapshot(ws2812b_params_t *params);
+
+// ===================================================================
+// ========================== COMMAND QUEUE ==========================
+// ===================================================================
+
+/**
+ * @brief Reset a command queue to empty (call before the producer starts).
+ */
+void WS2812B_CmdQueue_Init(ws2812b_cmd_queue_t *queue);
+
+/**
+ * @brief Push a command (producer side).
+ * @return false if the queue is full (command dropped).
+ */
+bool WS2812B_CmdQueue_Push(ws2812b_cmd_queue_t *queue, uint8_t type, int32_t value);
+
+/**
+ * @brief Pop a command (consumer side).
+ * @return false if the queue is empty.
+ */
+bool WS2812B_CmdQueue_Pop(ws2812b_cmd_queue_t *queue, ws2812b_cmd_t *cmd);
+
+/**
+ * @brief Post a command to the default queue (one producer context only).
+ * @return false if the queue is full.
+ */
+bool WS2812B_Control_Post(uint8_t type, int32_t value);
+
+/**
+ * @brief Register an extra queue drained by WS2812B_Control_Apply().
+ * @return false if no registration slot is left.
+ */
+bool WS2812B_Control_AddQueue(ws2812b_cmd_queue_t *queue);
+
+// ===================================================================
+// ============================ RENDERER =============================
+// ===================================================================
+
+/**
+ * @brief Apply new parameters and queued commands to the effect state.
+ * @param effects Effect state owned by the render loop.
+ * @return true if output is enabled, false if the strip is switched off.
+ * @note Call once per frame from the render loop only.
+ */
+bool WS2812B_Control_Apply(ws2812b_effects_t *effects);
+
+/**
+ * @brief Apply a single command immediately (render-loop context only).
+ * @param effects Effect state owned by the render loop.
+ * @param type @ref ws2812b_cmd_type_t
+ * @param value Command argument
+ */
+void WS2812B_Control_Execute(ws2812b_effects_t *effects, uint8_t type, int32_t value);
+
+#endif /* WS2812B_CONTROL_H */
@@ -0,0 +1,162 @@
+/**
+ * @file WS2812B_Current.h
+ * @brief Closed-loop supply current limit: shunt amplifier on ADC1 + DMA, integer PI on the output scale.
+ *
+ * Brightness caps derived from an estimated mA-per-LED figure are only as
+ * good as the estimate, and that varies between strip batches, supplies and
+ * cable runs. This module measures instead: a shunt in the strip supply feeds
+ * a current-sense amplifier (e.g. INA180A2, 50 V/V) on an ADC input that is
+ * converted continuously into a circular DMA buffer. Once per frame
+ * WS2812B_Current_Tick() averages the buffer, converts it to mA and updates
+ * the encoder's output scale (WS2812B_SetOutputScale()), so the limit holds
+ * for every output path: effects, presets, streamed frames.
+ *
+ * - PI: the loop regulates 1/32 under the limit, so noise on the reading
+ *   stays under it. The error is taken relative to that setpoint and
+ *   multiplied by the current scale. This normalizes the loop gain: the strip
+ *   current is proportional to the scale, so the same gains work for a dim
+ *   pattern barely over the limit and for full white at almost twice it.
+ * - Fast attack: a reading more than WS2812B_CURRENT_ATTACK_PCT over the
+ *   limit (a sudden white frame) cuts the scale in one step to where that
+ *   reading would sit 1/16 under the limit, and restarts the integrator there.
+ * - Release: when the content gets darker the integrator raises the scale
+ *   again at the PI rate, and never above 256 (no windup while under the limit).
+ *
+ * The ADC sees the frame that was on the strip during the previous loop,
+ * so a sudden white frame is shown once at the old scale before the attack
+ * cuts it (one frame period, 20–50 ms). Size the supply and the fuse for
+ * that peak, or set the limit below the supply rating by the same margin.
+ *
+ * Host simulation (plant model: 60 LEDs at 20 mA/channel plus 1 mA quiescent,
+ * 3% supply sag at full load = 3.55 A full white, +-3% noise per ADC sample,
+ * 12-bit quantization), 2 A limit, defaults above; host/test_current.c runs
+ * it and checks these figures. "First" is the frame that shows the new
+ * content at the old scale; "settle" counts frames until the current stays
+ * within +-5% of the setpoint; "overshoot" is the highest current after the
+ * first frame, over the limit; "steady" is the mean and RMS ripple of the
+ * last 60 of 120 frames:
+ * | Scenario                          | Attack | First | Settle         | Overshoot      | Steady (of limit) |
+ * |-----------------------------------|--------|-------|----------------|----------------|-------------------|
+ * | Black -> white                    | yes    | 177%  | 1 frame        | 0%             | 97.0% +-0.2%      |
+ * | Black -> white                    | off    | 177%  | 4 frames       | 7.9%           | 97.0% +-0.2%      |
+ * | Limited 2.6 A pattern -> white    | yes    | 136%  | 1 frame        | 0%             | 97.0% +-0.2%      |
+ * | Limited 2.6 A pattern -> white    | off    | 136%  | 5 frames       | 14.7%          | 97.0% +-0.1%      |
+ * | White, 15 mA/channel batch        | yes    | 135%  | 1 frame        | 0%             | 96.9% +-0.0%      |
+ * | Demand ramp 0.95 -> 3.55 A, 40 fr | yes    | -     | tracks         | 1.9% (ramp lag)| 97.1% +-0.4%      |
+ * | White -> 30% pattern              | yes    | -     | 2 frames to 256| -              | unlimited         |
+ * "Attack off" is WS2812B_CURRENT_ATTACK_PCT=10000 (PI only).
+ *
+ * Hardware: shunt amplifier output on PA0 (ADC1_IN0), DMA1 channel 1,
+ * continuous conversion at 239.5 cycles (21 us per sample at 12 MHz), so the
+ * default 128 samples average 2.7 ms, one full period of the LEDs' own
+ * ~400 Hz PWM. Build with -DWS2812B_CURRENT to enable it in main.c.
+ */
+
+#ifndef WS2812B_CURRENT_H
+#define WS2812B_CURRENT_H
+
+#include "WS2812B.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_CURRENT_LIMIT_MA
+#define WS2812B_CURRENT_LIMIT_MA    2000    ///< Default limit (0 = off)
+#endif
+
+#ifndef WS2812B_CURRENT_SAMPLES
+#define WS2812B_CURRENT_SAMPLES     128     ///< DMA buffer, averaged once per frame
+#endif
+
+#ifndef WS2812B_CURRENT_VREF_MV
+#define WS2812B_CURRENT_VREF_MV     3300    ///< ADC reference
+#endif
+
+#ifndef WS2812B_CURRENT_GAIN
+#define WS2812B_CURRENT_GAIN        50      ///< Amplifier gain, V/V
+#endif
+
+#ifndef WS2812B_CURRENT_SHUNT_MOHM
+#define WS2812B_CURRENT_SHUNT_MOHM  10      ///< Shunt resistance, mOhm (10 mOhm x 50 = 6.6 A full scale)
+#endif
+
+#ifndef WS2812B_CURRENT_OFFSET
+#define WS2812B_CURRENT_OFFSET      0       ///< ADC counts at zero current (amplifier offset)
+#endif
+
+#ifndef WS2812B_CURRENT_KP
+#define WS2812B_CURRENT_KP          96      ///< Proportional gain, Q8 (0.375)
+#endif
+
+#ifndef WS2812B_CURRENT_KI
+#define WS2812B_CURRENT_KI          160     ///< Integral gain per frame, Q8 (0.625)
+#endif
+
+#ifndef WS2812B_CURRENT_ATTACK_PCT
+#define WS2812B_CURRENT_ATTACK_PCT  10      ///< Over-limit reading that triggers the one-step cut
+#endif
+
+#ifndef WS2812B_CURRENT_SCALE_MIN
+#define WS2812B_CURRENT_SCALE_MIN   8       ///< Lowest output scale, Q8 (3%)
+#endif
+
+/**
+ * @brief Limiter statistics.
+ */
+typedef struct {
+    uint16_t current_ma;        ///< Latest reading
+    uint16_t peak_ma;           ///< Highest reading since the last reset
+    uint16_t limit_ma;          ///< Active limit (0 = off)
+    uint16_t scale;             ///< Output scale, Q8 (256 = not limiting)
+    uint32_t limited_frames;    ///< Frames shown with scale < 256
+    uint32_t attacks;           ///< Fast-attack cuts
+} ws2812b_current_stats_t;
+
+/**
+ * @brief Reset the controller (full scale) and the statistics.
+ */
+void WS2812B_Current_Reset(void);
+
+/**
+ * @brief Set the current limit.
+ * @param limit_ma Limit in mA; 0 turns limiting off (scale 256)
+ */
+void WS2812B_Current_SetLimit(uint16_t limit_ma);
+
+/**
+ * @brief Run the controller on one reading.
+ * @param measured_ma Supply current during the last frame, mA
+ * @return New output scale (Q8), also applied with WS2812B_SetOutputScale().
+ * @note No HAL dependency, so the loop can be driven by a host plant model.
+ */
+uint16_t WS2812B_Current_Update(uint16_t measured_ma);
+
+/**
+ * @brief Convert a sum of WS2812B_CURRENT_SAMPLES ADC readings to mA.
+ */
+uint16_t WS2812B_Current_CountsToMilliamps(uint32_t sum);
+
+/**
+ * @brief Copy the statistics.
+ * @param[out] stats Statistics
+ */
+void WS2812B_Current_GetStats(ws2812b_current_stats_t *stats);
+
+// ===================================================================
+// ============================ ADC GLUE =============================
+// ===================================================================
+
+/**
+ * @brief Calibrate the ADC and start continuous conversion into the circular DMA buffer.
+ * @param hadc ADC handle (its DMA channel is switched to circular mode)
+ * @return true on success.
+ */
+bool WS2812B_Current_Start(ADC_HandleTypeDef *hadc);
+
+/**
+ * @brief Average the DMA buffer and update the output scale.
+ * @note Call once per frame from the render loop, before rendering. Does
+ *       nothing until WS2812B_Current_Start() succeeded.
+ */
+void WS2812B_Current_Tick(void);
+
+#endif /* WS2812B_CURRENT_H */
@@ -0,0 +1,84 @@
+/**
+ * @file WS2812B_Cycle.h
+ * @brief Cycle cache: precompute one period of a periodic effect and play it back by index.
+ *
+ * Effects such as WS2812B_Rainbow() (hue +2 per frame, period 180) and
+ * WS2812B_RainbowChase() (hue +3 per frame, period 120) repeat exactly. On
+ * short strips the whole period fits in RAM as RGB frames: the colors are
+ * converted once when the effect starts, and every following frame is only
+ * the encode of a cached frame, with no color conversion at all.
+ *
+ * The cache is keyed by a caller-chosen value (effect, color space,
+ * brightness) plus the period and LED count. WS2812B_Cycle_Prepare() fails
+ * when the period does not fit in WS2812B_CYCLE_CACHE_BYTES, and the effect
+ * keeps rendering live.
+ *
+ * RAM needed (RGB frames, period x LEDs x 3 bytes):
+ * | LEDs | Rainbow (180) | RainbowChase (120) |
+ * |------|---------------|--------------------|
+ * | 8    | 4320 B        | 2880 B             |
+ * | 12   | 6480 B        | 4320 B             |
+ * | 60   | 32400 B       | 21600 B            |
+ *
+ * The default budget follows LED_NUM: the Rainbow period up to 8 LEDs, the
+ * RainbowChase period up to 12, and no cache beyond that (every frame is
+ * rendered live, as without the cache). Define WS2812B_CYCLE_CACHE_BYTES
+ * to opt in on longer strips when the RAM is there.
+ *
+ * Encoded frames would cost 8x more (24 bytes per LED), so only the RGB
+ * frames are cached and the encode stays per frame.
+ */
+
+#ifndef WS2812B_CYCLE_H
+#define WS2812B_CYCLE_H
+
+#include "WS2812B.h"
+#include "WS2812B_Stream.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_CYCLE_CACHE_BYTES
+#if LED_NUM <= 8
+#define WS2812B_CYCLE_CACHE_BYTES   (180 * 3 * LED_NUM)     ///< Cache RAM budget: one Rainbow period
+#elif LED_NUM <= 12
+#define WS2812B_CYCLE_CACHE_BYTES   (120 * 3 * LED_NUM)     ///< Cache RAM budget: one RainbowChase period
+#else
+#define WS2812B_CYCLE_CACHE_BYTES   0       ///< Cache RAM budget (0 = disabled, always render live)
+#endif
+#endif
+
+/**
+ * @brief Make sure the cache holds the period identified by @p key.
+ * @param key Identifies the effect and the parameters that change its frames,
+ *            see WS2812B_CYCLE_KEY()
+ * @param period Frames per period
+ * @param led_count LEDs per frame
+ * @param shader Computes one LED; called with time = frame index (0 to period - 1)
+ * @param ctx Shader context
+ * @return true if the frames are cached (playback is available), false if
+ *         the period does not fit the RAM budget.
+ * @note Renders the whole period only when the key changes.
+ */
+bool WS2812B_Cycle_Prepare(uint32_t key, uint16_t period, uint16_t led_count,
+                           ws2812b_shader_t shader, const void *ctx);
+
+/**
+ * @brief Encode one cached frame into the PWM buffer.
+ * @param frame Frame index (taken modulo the period)
+ * @note Call only after WS2812B_Cycle_Prepare() returned true.
+ */
+void WS2812B_Cycle_Encode(uint16_t frame);
+
+/**
+ * @brief Drop the cached period (the next Prepare() renders again).
+ */
+void WS2812B_Cycle_Invalidate(void);
+
+/**
+ * @brief Build a cache key from an effect id and two 8-bit parameters.
+ * @note Period and LED count are compared separately.
+ */
+#define WS2812B_CYCLE_KEY(effect, a, b) \
+    (((uint32_t)(effect) << 16) | ((uint32_t)(uint8_t)(a) << 8) | (uint8_t)(b))
+
+#endif /* WS2812B_CYCLE_H */
@@ -22,15 +22,21 @@ typedef enum {
     EFFECT_FIRE,            ///< Flickering fire simulation
     EFFECT_BREATHE,         ///< Smooth brightness pulse
     EFFECT_THEATER_CHASE,   ///< "Knight Rider" style chase
-    EFFECT_TWINKLE          ///< Random star-like twinkles
+    EFFECT_TWINKLE,         ///< Random star-like twinkles
+    EFFECT_SCRIPT           ///< Run active WS2812B_Script scripts (not auto-cycled)
 } ws2812b_effect_t;
 
+#define WS2812B_EFFECT_COUNT        (EFFECT_SCRIPT + 1)     ///< Number of effects
+#define WS2812B_EFFECT_CYCLE_COUNT  (EFFECT_TWINKLE + 1)    ///< Effects visited by auto-cycle
+
 /**
  * @brief Effect configuration and state structure.
  */
 typedef struct {
     ws2812b_effect_t current_effect;  ///< Currently active effect
     uint16_t hue;                     ///< Base hue for dynamic effects (0–359)
+    uint16_t hue16;                   ///< Hue phase accumulator (0–65535 = 0–360°), kept in sync with hue
+    uint16_t hue_step;                ///< Hue advance per frame, 8.8 fixed-point degrees (0x0100 = 1°)
     uint8_t brightness;               ///< Global brightness (0–100%)
     int8_t breathe_direction;         ///< Breathing direction (+1 or -1)
     uint8_t theater_frame;            ///< Current theater chase frame (0–2)
@@ -39,6 +45,20 @@ typedef struct {
     uint32_t cycle_duration;          ///< Time per effect in milliseconds
 } ws2812b_effects_t;
 
+/**
+ * @brief Animation state the effect code keeps outside ws2812b_effects_t.
+ * @note Saved by WS2812B_Warm so effects resume after a reset, and part of the
+ *       WS2812B_Record snapshot so a replay can start mid-session.
+ */
+typedef struct {
+    uint16_t rainbow_hue;             ///< WS2812B_Rainbow() phase (0–359)
+    uint16_t chase_offset;            ///< WS2812B_RainbowChase() phase (0–359)
+    uint8_t breathe_val;              ///< WS2812B_Breathe() level
+    int8_t breathe_dir;               ///< WS2812B_Breathe() direction (+1 or -1)
+    uint32_t cycle_elapsed;           ///< Milliseconds since the last auto-cycle step
+    uint32_t fire_seed;               ///< WS2812B_FireEffect() generator state
+} ws2812b_effects_phase_t;
+
 // ===================================================================
 // ====================== EFFECT MANAGEMENT API ======================
 // ===================================================================
@@ -63,6 +83,18 @@ void WS2812B_Effects_Handle(ws2812b_effects_t* effects);
  */
 void WS2812B_Effects_SetEffect(ws2812b_effects_t* effects, ws2812b_effect_t new_effect);
 
+/**
+ * @brief Read the animation state kept inside the effect code.
+ * @param phase Filled with the current phases.
+ */
+void WS2812B_Effects_GetPhase(ws2812b_effects_phase_t* phase);
+
+/**
+ * @brief Restore the animation state read by WS2812B_Effects_GetPhase().
+ * @param phase Phases to continue from.
+ */
+void WS2812B_Effects_SetPhase(const ws2812b_effects_phase_t* phase);
+
 // ===================================================================
 // ======================= COLOR SPACE SUPPORT =======================
 // ===================================================================
@@ -92,6 +124,13 @@ void WS2812B_Rainbow(color_space_t colorspace);
  */
 void WS2812B_RainbowChase(color_space_t colorspace);
 
+/**
+ * @brief Rainbow scrolled one LED per frame via the framebuffer ring offset.
+ * @param colorspace Color space to use.
+ * @note Renders the rainbow once; later frames only rotate and re-encode.
+ */
+void WS2812B_RainbowScroll(color_space_t colorspace);
+
 /**
  * @brief Smooth breathing/pulsing effect.
  * @param colorspace Color space.
@@ -101,6 +140,13 @@ void WS2812B_RainbowChase(color_space_t colorspace);
  */
 void WS2812B_Breathe(color_space_t colorspace, uint16_t hue_or_red, uint8_t sat_or_green, uint8_t val_or_blue);
 
+/**
+ * @brief Breathing effect in HSV with a 16-bit hue.
+ * @param hue16 Hue (0–65535 = 0–360°).
+ * @param sat Saturation (0–100%).
+ */
+void WS2812B_BreatheHSV16(uint16_t hue16, uint8_t sat);
+
 /**
  * @brief Set all LEDs to a solid color.
  * @param colorspace Color space.
@@ -150,4 +196,16 @@ void WS2812B_SetBrightness(uint8_t brightness);
  */
 void WS2812B_SetSpeed(uint8_t speed);
 
+/**
+ * @brief Get global brightness.
+ * @return Brightness in percent (0–100).
+ */
+uint8_t WS2812B_GetBrightness(void);
+
+/**
+ * @brief Get animation speed.
+ * @return Speed level (1–100).
+ */
+uint8_t WS2812B_GetSpeed(void);
+
 #endif /* SRC_WS2812B_EFFECTS_H_ */
\ No newline at end of file
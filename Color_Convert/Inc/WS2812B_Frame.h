@@ -0,0 +1,112 @@
+/**
+ * @file WS2812B_Frame.h
+ * @brief RGB framebuffer with O(1) scrolling for WS2812B strips.
+ *
+ * Effects draw into a 3-byte-per-LED framebuffer addressed by logical LED
+ * index. The buffer is a ring: scrolling only moves a start offset, and the
+ * rotation is applied when the frame is encoded (WS2812B_Frame_Show()) or
+ * streamed (WS2812B_Shader_Frame). A shifting pattern therefore costs one
+ * offset update plus rendering the pixel(s) entering at the edge, instead of
+ * recomputing every LED.
+ *
+ * Render scale: with WS2812B_Frame_SetScale(2 or 4) an effect renders only
+ * WS2812B_Frame_Length() samples, one every 2nd/4th LED, and the encoder fills
+ * the LEDs in between by linear interpolation. Smooth effects (gradients,
+ * noise, fire) cost 2–4x less to render with little visible difference;
+ * logical pixel indices and scroll steps are then in samples, not LEDs.
+ */
+
+#ifndef WS2812B_FRAME_H
+#define WS2812B_FRAME_H
+
+#include "WS2812B.h"
+#include <stdint.h>
+
+/**
+ * @brief Clear the framebuffer to black and reset the scroll offset.
+ */
+void WS2812B_Frame_Clear(void);
+
+/**
+ * @brief Set the render scale (samples are this many LEDs apart).
+ * @param scale 1 (full resolution), 2, 4 or 8
+ * @note Clears the framebuffer.
+ */
+void WS2812B_Frame_SetScale(uint8_t scale);
+
+/**
+ * @brief Current render scale.
+ * @return 1, 2, 4 or 8.
+ */
+uint8_t WS2812B_Frame_GetScale(void);
+
+/**
+ * @brief Number of logical pixels an effect has to render.
+ * @return LED_NUM at scale 1, ceil((LED_NUM - 1) / scale) + 1 otherwise.
+ */
+uint16_t WS2812B_Frame_Length(void);
+
+/**
+ * @brief Set one logical pixel.
+ * @param pixel Logical LED index (0 to WS2812B_Frame_Length() - 1)
+ * @param red Red (0–255)
+ * @param green Green (0–255)
+ * @param blue Blue (0–255)
+ */
+void WS2812B_Frame_SetPixelRGB(uint16_t pixel, uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+ * @brief Set one logical pixel from HSV.
+ * @param pixel Logical LED index
+ * @param hue Hue (0–359)
+ * @param sat Saturation (0–100%)
+ * @param val Value (0–100%)
+ */
+void WS2812B_Frame_SetPixelHSV(uint16_t pixel, uint16_t hue, uint8_t sat, uint8_t val);
+
+/**
+ * @brief Set one logical pixel from HSL.
+ * @param pixel Logical LED index
+ * @param hue Hue (0–359)
+ * @param sat Saturation (0–100%)
+ * @param light Lightness (0–100%)
+ */
+void WS2812B_Frame_SetPixelHSL(uint16_t pixel, uint16_t hue, uint8_t sat, uint8_t light);
+
+/**
+ * @brief Read one logical pixel.
+ * @param pixel Logical LED index
+ * @param[out] red, green, blue Stored color (black if out of range)
+ */
+void WS2812B_Frame_GetPixelRGB(uint16_t pixel, uint8_t *red, uint8_t *green, uint8_t *blue);
+
+/**
+ * @brief Scroll the whole frame in O(1).
+ * @param steps Positive: pattern moves towards higher indices and the pixels
+ *              entering at index 0.. hold stale data. Negative: pattern moves
+ *              towards index 0 and the pixels at the end are stale.
+ * @note For patterns whose period equals the strip length (e.g. a full
+ *       rainbow) the stale pixels are already correct: scrolling is a pure
+ *       rotation.
+ */
+void WS2812B_Frame_Scroll(int16_t steps);
+
+/**
+ * @brief Encode the framebuffer (with scroll offset) into the PWM buffer.
+ * @note Upscales by linear interpolation when the render scale is > 1.
+ */
+void WS2812B_Frame_Encode(void);
+
+/**
+ * @brief Encode and transmit the framebuffer.
+ */
+void WS2812B_Frame_Show(void);
+
+/**
+ * @brief Pixel shader reading the framebuffer, for WS2812B_Stream_Start().
+ * @note Lets a streamed frame apply the scroll offset without an encode pass.
+ */
+void WS2812B_Shader_Frame(uint16_t index, uint32_t time, const void *ctx,
+                          uint8_t *red, uint8_t *green, uint8_t *blue);
+
+#endif /* WS2812B_FRAME_H */
@@ -0,0 +1,82 @@
+/**
+ * @file WS2812B_Input.h
+ * @brief EXTI-driven push button and rotary encoder input for the effect engine.
+ *
+ * Edges are caught by EXTI interrupts; debounce and long-press timing run in
+ * the 1 ms SysTick interrupt, which posts commands to a dedicated queue of
+ * WS2812B_Control. The main loop never polls the pins, and an event is
+ * applied at the next WS2812B_Control_Apply(), i.e. within one frame.
+ *
+ * | Input            | Command                             |
+ * |------------------|-------------------------------------|
+ * | Short press      | CMD_NEXT_EFFECT                     |
+ * | Long press       | CMD_POWER (toggle)                  |
+ * | Encoder detent   | CMD_ADJUST_BRIGHTNESS (±step)       |
+ *
+ * Wiring (see main.h): button BTN_Pin to GND, encoder A/B on ENC_A_Pin /
+ * ENC_B_Pin with common to GND; internal pull-ups enabled.
+ */
+
+#ifndef WS2812B_INPUT_H
+#define WS2812B_INPUT_H
+
+#include "WS2812B_Control.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_INPUT_DEBOUNCE_MS
+#define WS2812B_INPUT_DEBOUNCE_MS       20  ///< Button must be stable this long
+#endif
+
+#ifndef WS2812B_INPUT_LONG_PRESS_MS
+#define WS2812B_INPUT_LONG_PRESS_MS     800 ///< Hold time for a long press
+#endif
+
+#ifndef WS2812B_INPUT_STEPS_PER_DETENT
+#define WS2812B_INPUT_STEPS_PER_DETENT  4   ///< Quadrature steps per encoder click
+#endif
+
+#ifndef WS2812B_INPUT_BRIGHTNESS_STEP
+#define WS2812B_INPUT_BRIGHTNESS_STEP   5   ///< Brightness change per detent (%)
+#endif
+
+/**
+ * @brief Register the input command queue and latch the initial encoder state.
+ * @note Call after MX_GPIO_Init(), before the EXTI interrupts fire.
+ */
+void WS2812B_Input_Init(void);
+
+/**
+ * @brief 1 ms tick (call from SysTick_Handler).
+ */
+void WS2812B_Input_Tick1ms(void);
+
+// ===================================================================
+// ================= PIN-INDEPENDENT CORE (simulation) ===============
+// ===================================================================
+
+/**
+ * @brief Button edge seen by EXTI.
+ * @param now Current time in ms
+ */
+void WS2812B_Input_ButtonEdge(uint32_t now);
+
+/**
+ * @brief Encoder edge seen by EXTI.
+ * @param ab Current encoder levels: bit 1 = A, bit 0 = B
+ */
+void WS2812B_Input_EncoderEdge(uint8_t ab);
+
+/**
+ * @brief Debounce / long-press / detent processing.
+ * @param now Current time in ms
+ * @param pressed Current (raw) button level, true = pressed
+ */
+void WS2812B_Input_Tick(uint32_t now, bool pressed);
+
+/**
+ * @brief Reset the core state (encoder state = @p ab, button released).
+ */
+void WS2812B_Input_Reset(uint8_t ab);
+
+#endif /* WS2812B_INPUT_H */
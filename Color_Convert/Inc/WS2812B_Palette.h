@@ -0,0 +1,126 @@
+/**
+ * @file WS2812B_Palette.h
+ * @brief Indexed-color framebuffer (1 byte per LED) with a palette resolved at encode time.
+ *
+ * Each LED stores an 8-bit palette index; the palette is looked up while the
+ * frame is encoded (WS2812B_Indexed_Show()) or streamed (WS2812B_Shader_Indexed
+ * with WS2812B_Stream_Start()). Palette animation (color cycling) changes the
+ * whole strip without touching a single pixel or palette entry: it moves a
+ * rotation offset applied at lookup, so it is safe while streaming.
+ *
+ * RAM budget (streaming output; the palette defaults to 256 entries, 64 on
+ * long strips, see WS2812B_LONG_STRIP):
+ * | LEDs | Index buffer | Palette | Stream buffer | Total   | RGB framebuffer |
+ * |------|--------------|---------|---------------|---------|-----------------|
+ * | 60   | 60 B         | 768 B   | 192 B         | ~1.0 KB | 180 B + 192 B   |
+ * | 1000 | 1000 B       | 192 B   | 192 B         | ~1.4 KB | 3000 B + 192 B  |
+ * | 2000 | 2000 B       | 192 B   | 192 B         | ~2.4 KB | 6000 B + 192 B  |
+ *
+ * A full pwmData buffer would need 24 bytes per LED (24 KB for 1000 LEDs),
+ * so strips that long must use streaming output.
+ */
+
+#ifndef WS2812B_PALETTE_H
+#define WS2812B_PALETTE_H
+
+#include "WS2812B.h"
+#include <stdint.h>
+
+#ifndef WS2812B_PALETTE_SIZE
+#if WS2812B_LONG_STRIP
+#define WS2812B_PALETTE_SIZE        64      ///< Palette entries (power of two, 2–256)
+#else
+#define WS2812B_PALETTE_SIZE        256     ///< Palette entries (power of two, 2–256)
+#endif
+#endif
+
+#ifndef WS2812B_INDEXED_LED_NUM
+#define WS2812B_INDEXED_LED_NUM     LED_NUM ///< LEDs in the indexed framebuffer
+#endif
+
+// ===================================================================
+// ============================= PALETTE =============================
+// ===================================================================
+
+/**
+ * @brief Set one palette entry.
+ * @param index Palette index
+ * @param red Red (0–255)
+ * @param green Green (0–255)
+ * @param blue Blue (0–255)
+ */
+void WS2812B_Palette_Set(uint8_t index, uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+ * @brief Set one palette entry from HSV.
+ * @param index Palette index
+ * @param hue Hue (0–359)
+ * @param sat Saturation (0–100%)
+ * @param val Value (0–100%)
+ */
+void WS2812B_Palette_SetHSV(uint8_t index, uint16_t hue, uint8_t sat, uint8_t val);
+
+/**
+ * @brief Fill a palette range with a full hue wheel.
+ * @param first First palette index
+ * @param count Number of entries
+ * @param sat Saturation (0–100%)
+ * @param val Value (0–100%)
+ */
+void WS2812B_Palette_Rainbow(uint8_t first, uint16_t count, uint8_t sat, uint8_t val);
+
+/**
+ * @brief Rotate a palette range (color cycling).
+ * @param first First palette index of the range
+ * @param count Number of entries in the range
+ * @param steps Entries to rotate (positive = colors move to lower indices)
+ * @note O(1), tear-free while streaming. One range cycles at a time; calling
+ *       with another range restarts the rotation. WS2812B_Palette_Set() keeps
+ *       addressing the unrotated entries.
+ */
+void WS2812B_Palette_Cycle(uint8_t first, uint16_t count, int16_t steps);
+
+/**
+ * @brief Stop color cycling (rotation back to 0).
+ */
+void WS2812B_Palette_ResetCycle(void);
+
+// ===================================================================
+// ======================== INDEXED FRAMEBUFFER ======================
+// ===================================================================
+
+/**
+ * @brief Set the palette index of one LED.
+ * @param pixel LED index (0 to WS2812B_INDEXED_LED_NUM - 1)
+ * @param index Palette index
+ */
+void WS2812B_Indexed_SetPixel(uint16_t pixel, uint8_t index);
+
+/**
+ * @brief Read the palette index of one LED (0 if out of range).
+ */
+uint8_t WS2812B_Indexed_GetPixel(uint16_t pixel);
+
+/**
+ * @brief Set every LED to the same palette index.
+ */
+void WS2812B_Indexed_Fill(uint8_t index);
+
+/**
+ * @brief Resolve the palette and encode the first LED_NUM LEDs into the PWM buffer.
+ */
+void WS2812B_Indexed_Encode(void);
+
+/**
+ * @brief Encode and transmit the indexed framebuffer.
+ */
+void WS2812B_Indexed_Show(void);
+
+/**
+ * @brief Pixel shader resolving the indexed framebuffer, for WS2812B_Stream_Start().
+ * @note Use with led_count = WS2812B_INDEXED_LED_NUM. ctx is unused.
+ */
+void WS2812B_Shader_Indexed(uint16_t index, uint32_t time, const void *ctx,
+                            uint8_t *red, uint8_t *green, uint8_t *blue);
+
+#endif /* WS2812B_PALETTE_H */
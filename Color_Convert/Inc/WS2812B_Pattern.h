@@ -0,0 +1,108 @@
+/**
+ * @file WS2812B_Pattern.h
+ * @brief Repeating chase patterns: a run-length template moved by a rotating phase.
+ *
+ * A pattern is a short template of runs ({length, color index}) repeated
+ * along the strip; its period is the sum of the run lengths. Advancing the
+ * phase moves the whole pattern. Encoding walks the runs with a down-counter,
+ * so there is no per-pixel modulo or division, and each of the (at most
+ * WS2812B_PATTERN_MAX_COLORS) colors is encoded once per frame and then
+ * copied into place.
+ *
+ * @code
+ * // Theater chase: every 3rd LED lit
+ * WS2812B_Pattern_FromMask(&p, 0x1, 3);
+ * WS2812B_Pattern_SetColor(&p, 1, 255, 120, 0);
+ *
+ * // Dashed line: 4 on, 4 off
+ * WS2812B_Pattern_FromMask(&p, 0x0F, 8);
+ *
+ * // Three-color marquee
+ * static const ws2812b_pattern_run_t marquee[] = { {3, 0}, {3, 1}, {3, 2} };
+ * WS2812B_Pattern_SetRuns(&p, marquee, 3);
+ * @endcode
+ */
+
+#ifndef WS2812B_PATTERN_H
+#define WS2812B_PATTERN_H
+
+#include "WS2812B.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_PATTERN_MAX_RUNS
+#define WS2812B_PATTERN_MAX_RUNS    32      ///< Runs per template (a 32-bit mask needs up to 32)
+#endif
+
+#define WS2812B_PATTERN_MAX_COLORS  4       ///< Colors per pattern
+
+/**
+ * @brief One run of the template.
+ */
+typedef struct {
+    uint8_t length;             ///< LEDs in the run (1–255)
+    uint8_t color;              ///< Color index (0 to WS2812B_PATTERN_MAX_COLORS - 1)
+} ws2812b_pattern_run_t;
+
+/**
+ * @brief Pattern state (a zero-initialised pattern is empty and renders black).
+ */
+typedef struct {
+    ws2812b_pattern_run_t runs[WS2812B_PATTERN_MAX_RUNS];
+    uint8_t run_count;
+    uint8_t colors[WS2812B_PATTERN_MAX_COLORS][3];  ///< R, G, B per color index
+    uint16_t period;            ///< Sum of run lengths
+    uint16_t phase;             ///< Template offset (0 to period - 1)
+} ws2812b_pattern_t;
+
+/**
+ * @brief Install a run-length template (colors are kept, phase is reset).
+ * @param p Pattern
+ * @param runs Runs (copied)
+ * @param count Number of runs (1 to WS2812B_PATTERN_MAX_RUNS)
+ * @return false if a run is empty, uses an invalid color or there are too many.
+ */
+bool WS2812B_Pattern_SetRuns(ws2812b_pattern_t *p, const ws2812b_pattern_run_t *runs, uint8_t count);
+
+/**
+ * @brief Install a two-color template from a bitmask (colors are kept, phase is reset).
+ * @param p Pattern
+ * @param mask Bit n set = LED n of the period uses color 1, clear = color 0
+ * @param period Template length in LEDs (1–32)
+ * @return false if period is out of range.
+ */
+bool WS2812B_Pattern_FromMask(ws2812b_pattern_t *p, uint32_t mask, uint8_t period);
+
+/**
+ * @brief Set one color of the pattern.
+ * @param p Pattern
+ * @param index Color index
+ * @param red Red (0–255)
+ * @param green Green (0–255)
+ * @param blue Blue (0–255)
+ */
+void WS2812B_Pattern_SetColor(ws2812b_pattern_t *p, uint8_t index, uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+ * @brief Set the phase directly.
+ * @param p Pattern
+ * @param phase LED n shows template position (n - phase) mod period
+ */
+void WS2812B_Pattern_SetPhase(ws2812b_pattern_t *p, uint16_t phase);
+
+/**
+ * @brief Move the pattern.
+ * @param p Pattern
+ * @param steps LEDs to move (positive = towards higher indices)
+ */
+void WS2812B_Pattern_Step(ws2812b_pattern_t *p, int16_t steps);
+
+/**
+ * @brief Encode the pattern into the PWM buffer.
+ * @param p Pattern
+ * @note Renders WS2812B_RenderLength() LEDs and mirrors them over the rest
+ *       of the strip, so it follows the mirror mode.
+ */
+void WS2812B_Pattern_Encode(const ws2812b_pattern_t *p);
+
+#endif /* WS2812B_PATTERN_H */
@@ -0,0 +1,157 @@
+/**
+ * @file WS2812B_Playlist.h
+ * @brief Playlist of effects and presets with per-entry durations, weights and shuffle.
+ *
+ * Replaces the single global auto-cycle (every effect for cycle_duration, in
+ * enum order) with a list of entries, each naming an effect or a preset, its
+ * own play time, a shuffle weight and a transition. WS2812B_Playlist_Tick()
+ * runs once per frame from the render loop and does O(1) work except on the
+ * frame that switches entries (O(entries), at most WS2812B_PLAYLIST_MAX_ENTRIES).
+ *
+ * - Sequential: entries play in order; weight 0 skips an entry.
+ * - Shuffle (PLAYLIST_FLAG_SHUFFLE): weighted random order without repeats.
+ *   Every entry with a non-zero weight plays once per round, higher weights
+ *   tend to come earlier, and a new round never starts with the entry that
+ *   just ended.
+ * - Transition: fade_frames > 0 recalls a preset entry with the preset
+ *   dip-to-black crossfade; effect entries always cut.
+ *
+ * The playlist can be loaded over the serial protocol (PACKET_PLAYLIST,
+ * see WS2812B_Playlist_Load() for the payload), started, stopped and saved
+ * with CMD_PLAYLIST, and is kept in its own 1 KB flash page (_splaylist).
+ */
+
+#ifndef WS2812B_PLAYLIST_H
+#define WS2812B_PLAYLIST_H
+
+#include "WS2812B_Effects.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define WS2812B_PLAYLIST_MAX_ENTRIES    16      ///< Entries per playlist
+
+#define PLAYLIST_ENTRY_EFFECT           0       ///< Entry index is a @ref ws2812b_effect_t
+#define PLAYLIST_ENTRY_PRESET           1       ///< Entry index is a preset index
+
+#define PLAYLIST_FLAG_SHUFFLE           0x01    ///< Weighted random order without repeats
+#define PLAYLIST_FLAG_AUTOSTART         0x02    ///< Start the stored playlist at boot
+
+/** @brief Serial payload size of a playlist with @p n entries. */
+#define WS2812B_PLAYLIST_WIRE_SIZE(n)   (2 + 6 * (n))
+
+/**
+ * @brief CMD_PLAYLIST arguments.
+ */
+typedef enum {
+    PLAYLIST_STOP = 0,          ///< Stop; the current effect keeps running
+    PLAYLIST_START = 1,         ///< (Re)start from the first entry
+    PLAYLIST_NEXT = 2,          ///< Skip to the next entry
+    PLAYLIST_SAVE = 3           ///< Store the playlist in flash
+} ws2812b_playlist_action_t;
+
+/**
+ * @brief One playlist entry (6 bytes).
+ */
+typedef struct {
+    uint8_t type;               ///< PLAYLIST_ENTRY_EFFECT or PLAYLIST_ENTRY_PRESET
+    uint8_t index;              ///< Effect or preset index
+    uint8_t weight;             ///< Shuffle weight (0 = never played)
+    uint8_t fade_frames;        ///< Transition: 0 = cut, else crossfade frames (preset entries)
+    uint16_t duration_ds;       ///< Play time in 0.1 s units (1–65535)
+} ws2812b_playlist_entry_t;
+
+/**
+ * @brief Playlist (flash layout).
+ */
+typedef struct {
+    uint8_t count;              ///< Entries in use
+    uint8_t flags;              ///< PLAYLIST_FLAG_*
+    uint8_t reserved;           ///< 0
+    uint8_t check;              ///< Checksum of every other byte (flash copy only)
+    ws2812b_playlist_entry_t entries[WS2812B_PLAYLIST_MAX_ENTRIES];
+} ws2812b_playlist_t;
+
+/**
+ * @brief Load the playlist stored in flash and start it if it has PLAYLIST_FLAG_AUTOSTART.
+ * @note Also seeds the shuffle from boot timing (DWT cycle counter, SysTick)
+ *       and the RTC counter, so shuffled playlists differ from boot to boot.
+ *       Call after MX_RTC_Init(), with the DWT counter enabled since boot.
+ */
+void WS2812B_Playlist_Init(void);
+
+/**
+ * @brief Install a playlist (stops the running one).
+ * @param playlist Playlist to copy
+ * @return false if it is invalid (unknown type, index out of range, zero duration).
+ */
+bool WS2812B_Playlist_Set(const ws2812b_playlist_t* playlist);
+
+/**
+ * @brief Install a playlist from its serial form.
+ * @param data Payload: count (1), flags (1), then per entry
+ *             type (1), index (1), weight (1), fade_frames (1), duration_ds (uint16 LE)
+ * @param len Payload length, must equal WS2812B_PLAYLIST_WIRE_SIZE(count)
+ * @return false if the payload is malformed or the playlist invalid.
+ */
+bool WS2812B_Playlist_Load(const uint8_t* data, uint16_t len);
+
+/**
+ * @brief Current playlist.
+ */
+const ws2812b_playlist_t* WS2812B_Playlist_Get(void);
+
+/**
+ * @brief Start the playlist; the first entry is applied on the next Tick.
+ * @return false if no entry has a non-zero weight.
+ */
+bool WS2812B_Playlist_Start(void);
+
+/**
+ * @brief Stop the playlist.
+ */
+void WS2812B_Playlist_Stop(void);
+
+/**
+ * @brief Switch to the next entry on the next Tick.
+ */
+void WS2812B_Playlist_Next(void);
+
+/**
+ * @brief Check whether the playlist is running.
+ */
+bool WS2812B_Playlist_IsActive(void);
+
+/**
+ * @brief Index of the entry playing now, or -1.
+ */
+int WS2812B_Playlist_Current(void);
+
+/**
+ * @brief Seed the shuffle generator (for reproducible runs, after WS2812B_Playlist_Init()).
+ * @param seed Any value (0 is replaced by a fixed non-zero seed)
+ */
+void WS2812B_Playlist_Seed(uint32_t seed);
+
+/**
+ * @brief Advance the playlist (call once per frame, after WS2812B_Preset_Tick()).
+ * @param effects Effect state owned by the render loop.
+ * @note Keeps auto_cycle off while active, including right after a preset
+ *       crossfade applied a preset with PRESET_FLAG_AUTO_CYCLE.
+ */
+void WS2812B_Playlist_Tick(ws2812b_effects_t* effects);
+
+/**
+ * @brief Advance the playlist at an explicit time (simulation).
+ * @param effects Effect state owned by the render loop.
+ * @param now Time in ms
+ */
+void WS2812B_Playlist_TickAt(ws2812b_effects_t* effects, uint32_t now);
+
+/**
+ * @brief Store the current playlist in its flash page.
+ * @return false on a flash error.
+ * @note Erases one page: stalls the CPU for ~20–40 ms. Never call from an interrupt.
+ */
+bool WS2812B_Playlist_Save(void);
+
+#endif /* WS2812B_PLAYLIST_H */
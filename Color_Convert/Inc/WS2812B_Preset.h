@@ -0,0 +1,117 @@
+/**
+ * @file WS2812B_Preset.h
+ * @brief Scene presets: complete engine configurations recalled by index.
+ *
+ * A preset is a compact 20-byte record (@ref ws2812b_preset_t) holding the
+ * effect, base hue, brightness, speed, auto-cycle setting and an optional
+ * palette. Presets come from two tables in flash:
+ *
+ * | Index                                   | Source                          |
+ * |-----------------------------------------|---------------------------------|
+ * | 0 .. WS2812B_PRESET_BUILTIN_COUNT-1     | Built-in table (const, .rodata) |
+ * | WS2812B_PRESET_BUILTIN_COUNT .. +USER-1 | User slots in the .presets page |
+ *
+ * Recall is O(1): the index selects a record that is read in place from flash.
+ * With a crossfade, the strip dips to black and back over the given number of
+ * frames. The new configuration is applied at the darkest frame. Effects render
+ * straight into pwmData, so there is no second frame to mix with.
+ *
+ * Typical use in the render loop:
+ * @code
+ * WS2812B_Control_Post(CMD_RECALL_PRESET, index | (fade_frames << 8));
+ * WS2812B_Control_Post(CMD_SAVE_PRESET, slot);     // Current state -> index BUILTIN_COUNT + slot
+ * ...
+ * if (WS2812B_Control_Apply(&led_effects))
+ * {
+ *     WS2812B_Preset_Tick(&led_effects);
+ *     WS2812B_Effects_Handle(&led_effects);
+ * }
+ * @endcode
+ */
+
+#ifndef WS2812B_PRESET_H
+#define WS2812B_PRESET_H
+
+#include "WS2812B_Effects.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_PRESET_USER_SLOTS
+#define WS2812B_PRESET_USER_SLOTS       8   ///< User presets in the flash page (max 1024 / 20)
+#endif
+
+#define WS2812B_PRESET_NAME_LEN         8   ///< Name length (zero-padded, not necessarily terminated)
+
+#define PRESET_FLAG_AUTO_CYCLE          0x01    ///< Enable automatic effect rotation
+#define PRESET_FLAG_PALETTE             0x02    ///< Regenerate the rainbow palette on recall
+
+/**
+ * @brief Serialized engine configuration (stored in flash).
+ */
+typedef struct {
+    char name[WS2812B_PRESET_NAME_LEN]; ///< Display name
+    uint8_t effect;                     ///< @ref ws2812b_effect_t
+    uint8_t brightness;                 ///< Global brightness (0–100%)
+    uint8_t speed;                      ///< Speed level (1–100)
+    uint8_t flags;                      ///< PRESET_FLAG_*
+    uint16_t hue;                       ///< Base hue (0–359)
+    uint16_t cycle_ds;                  ///< Time per effect in 0.1 s units
+    uint8_t palette_sat;                ///< Palette saturation (0–100%), if PRESET_FLAG_PALETTE
+    uint8_t palette_val;                ///< Palette value (0–100%), if PRESET_FLAG_PALETTE
+    uint8_t reserved;                   ///< 0
+    uint8_t check;                      ///< Checksum of the bytes above (user slots only)
+} ws2812b_preset_t;
+
+#define WS2812B_PRESET_BUILTIN_COUNT    6   ///< Entries in the built-in table
+#define WS2812B_PRESET_COUNT            (WS2812B_PRESET_BUILTIN_COUNT + WS2812B_PRESET_USER_SLOTS)
+
+/**
+ * @brief Get a preset record.
+ * @param index Preset index
+ * @return Pointer into flash, or NULL if the index is out of range or the user slot is empty.
+ */
+const ws2812b_preset_t* WS2812B_Preset_Get(uint8_t index);
+
+/**
+ * @brief Recall a preset.
+ * @param effects Effect state owned by the render loop.
+ * @param index Preset index
+ * @param fade_frames Crossfade length in frames (0 = switch immediately)
+ * @return false if the preset does not exist (state unchanged).
+ * @note Render-loop context only. With a fade, the switch happens in WS2812B_Preset_Tick().
+ */
+bool WS2812B_Preset_Recall(ws2812b_effects_t* effects, uint8_t index, uint16_t fade_frames);
+
+/**
+ * @brief Advance a running crossfade by one frame.
+ * @param effects Effect state owned by the render loop.
+ * @note Call once per frame before WS2812B_Effects_Handle(). Constant time
+ *       except on the switch frame, which may regenerate the palette.
+ */
+void WS2812B_Preset_Tick(ws2812b_effects_t* effects);
+
+/**
+ * @brief Check whether a crossfade is in progress.
+ */
+bool WS2812B_Preset_IsFading(void);
+
+/**
+ * @brief Serialize the current engine state into a preset record.
+ * @param effects Current effect state.
+ * @param name Name (truncated to WS2812B_PRESET_NAME_LEN)
+ * @param[out] preset Record to fill (palette fields are left disabled).
+ */
+void WS2812B_Preset_Capture(const ws2812b_effects_t* effects, const char* name, ws2812b_preset_t* preset);
+
+/**
+ * @brief Store a record in a user slot.
+ * @param slot User slot (0 .. WS2812B_PRESET_USER_SLOTS-1)
+ * @param preset Record to store (the stored copy gets a fresh checksum).
+ * @return false on an invalid slot or a flash error.
+ * @note Writing to an empty slot only programs it. Otherwise the whole page is
+ *       erased and rewritten, which stalls the CPU for ~20–40 ms (DMA output
+ *       keeps running). Never call this from an interrupt.
+ */
+bool WS2812B_Preset_Save(uint8_t slot, const ws2812b_preset_t* preset);
+
+#endif /* WS2812B_PRESET_H */
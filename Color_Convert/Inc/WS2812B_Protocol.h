@@ -0,0 +1,233 @@
+/**
+ * @file WS2812B_Protocol.h
+ * @brief Serial control/streaming protocol (USART1 + circular DMA) with a hardened parser.
+ *
+ * Packet format (little-endian):
+ * | Field   | Size | Notes                                           |
+ * |---------|------|-------------------------------------------------|
+ * | sync    | 1    | 0xA5                                            |
+ * | type    | 1    | @ref ws2812b_packet_type_t                      |
+ * | length  | 2    | Payload length, <= WS2812B_PROTOCOL_MAX_PAYLOAD |
+ * | payload | n    |                                                 |
+ * | crc     | 1    | CRC-8 (poly 0x07) over type, length, payload    |
+ *
+ * Payloads:
+ * - PACKET_COMMAND: cmd type (1) + value (int32), queued to WS2812B_Control.
+ * - PACKET_FRAME: first pixel (uint16) + RGB triplets.
+ * - PACKET_FRAME_RLE: first pixel (uint16) + runs of {count (1–255), R, G, B}.
+ * - PACKET_PLAYLIST: a whole playlist, see WS2812B_Playlist_Load(). It replaces
+ *   the current one (stopped); start or save it with CMD_PLAYLIST.
+ * - PACKET_RECORD (device to host): a chunk of the input log, sent by
+ *   WS2812B_Record_Dump(); see WS2812B_Record.h.
+ * - PACKET_STATUS (device to host): the reply to CMD_STATUS, a
+ *   @ref ws2812b_status_t serialized by WS2812B_Protocol_PackStatus().
+ *
+ * A packet is applied only after its CRC matched and it was fully validated,
+ * so a corrupt or oversized packet never writes a single pixel. Frames go to
+ * the WS2812B_Frame framebuffer; every write is bounds-checked against LED_NUM.
+ * Each applied frame is then copied into the WS2812B_Tween jitter buffer,
+ * which plays the stream out at the local frame rate.
+ *
+ * The parser core (Reset/Feed/Stats/BuildPacket) has no HAL dependency and a
+ * single byte-stream entry point, so it can be driven directly by a host
+ * fuzzer. libFuzzer targets (build lines in each file, -fsanitize=fuzzer,address):
+ * - host/fuzz_protocol.c: any byte stream, fed whole and split at arbitrary points.
+ * - host/fuzz_frame_rle.c: PACKET_FRAME_RLE payloads against a reference decoder.
+ * - host/fuzz_playlist_load.c: PACKET_PLAYLIST payloads, then playback.
+ * host/bench_protocol.c measures the throughput of each parser on valid input.
+ *
+ * Hardware: USART1 (PA9 TX, PA10 RX), RX on DMA1 channel 5. The DMA buffer is
+ * drained by WS2812B_Protocol_Poll() once per frame, so parsing never races
+ * the render loop.
+ */
+
+#ifndef WS2812B_PROTOCOL_H
+#define WS2812B_PROTOCOL_H
+
+#include "WS2812B.h"
+#include "WS2812B_Control.h"
+#include "WS2812B_Playlist.h"
+#include "WS2812B_Tween.h"
+#include "WS2812B_Current.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define WS2812B_PROTOCOL_SYNC       0xA5    ///< Packet start byte
+#define WS2812B_PROTOCOL_OVERHEAD   5       ///< sync + type + length + crc
+#define WS2812B_STATUS_VERSION      1       ///< First byte of a PACKET_STATUS payload
+#define WS2812B_STATUS_SIZE         84      ///< PACKET_STATUS payload length
+
+#ifndef WS2812B_PROTOCOL_MAX_PAYLOAD
+/// Largest accepted payload (one full frame, or a full playlist on very short strips)
+#define WS2812B_PROTOCOL_MAX_PAYLOAD    ((2 + 3 * LED_NUM) > WS2812B_PLAYLIST_WIRE_SIZE(WS2812B_PLAYLIST_MAX_ENTRIES) ? \
+                                         (2 + 3 * LED_NUM) : WS2812B_PLAYLIST_WIRE_SIZE(WS2812B_PLAYLIST_MAX_ENTRIES))
+#endif
+
+#ifndef WS2812B_PROTOCOL_BAUD
+#define WS2812B_PROTOCOL_BAUD           230400  ///< USART1 baud rate, also the host tools' default
+#endif
+
+#ifndef WS2812B_PROTOCOL_RX_SIZE
+#define WS2812B_PROTOCOL_RX_SIZE        2048    ///< DMA ring (power of two); must hold baud/10 x one loop period
+#endif
+
+#ifndef WS2812B_PROTOCOL_HOLD_MS
+#define WS2812B_PROTOCOL_HOLD_MS        1000    ///< Streamed frames own the strip this long after the last one
+#endif
+
+#ifndef WS2812B_PROTOCOL_TX_TIMEOUT_MS
+#define WS2812B_PROTOCOL_TX_TIMEOUT_MS  100     ///< Blocking transmit timeout per packet part
+#endif
+
+/**
+ * @brief Packet types.
+ */
+typedef enum {
+    PACKET_COMMAND = 0x01,      ///< One control command
+    PACKET_FRAME = 0x02,        ///< Raw RGB pixels
+    PACKET_FRAME_RLE = 0x03,    ///< Run-length encoded RGB pixels
+    PACKET_PLAYLIST = 0x04,     ///< Playlist definition
+    PACKET_RECORD = 0x05,       ///< Input log chunk (device to host only)
+    PACKET_STATUS = 0x06        ///< Status reply to CMD_STATUS (device to host only)
+} ws2812b_packet_type_t;
+
+/**
+ * @brief Parser statistics.
+ */
+typedef struct {
+    uint32_t packets;           ///< Packets accepted
+    uint32_t frames;            ///< Frame packets applied
+    uint32_t commands;          ///< Commands queued
+    uint32_t crc_errors;        ///< Packets dropped on CRC mismatch
+    uint32_t length_errors;     ///< Packets dropped on an oversized length
+    uint32_t decode_errors;     ///< Packets dropped on invalid contents
+    uint32_t dropped_bytes;     ///< Bytes skipped while searching for sync
+    uint32_t uart_errors;       ///< UART errors (overrun, framing, noise)
+} ws2812b_protocol_stats_t;
+
+/**
+ * @brief Device status, sent in reply to CMD_STATUS.
+ */
+typedef struct {
+    uint8_t version;                    ///< WS2812B_STATUS_VERSION
+    uint8_t clock_path;                 ///< @ref clock_path_t the system clock came up on
+    uint16_t timer_period;              ///< TIM3 period in timer ticks (timer clock / 800 kHz)
+    uint32_t uptime_ms;                 ///< HAL_GetTick()
+    uint16_t output_scale;              ///< WS2812B_GetOutputScale()
+    ws2812b_protocol_stats_t protocol;  ///< Parser statistics
+    ws2812b_tween_stats_t tween;        ///< Jitter buffer statistics
+    ws2812b_current_stats_t current;    ///< Current limiter statistics
+} ws2812b_status_t;
+
+// ===================================================================
+// ========================== PARSER CORE ============================
+// ===================================================================
+
+/**
+ * @brief Reset the parser to the sync-hunting state (statistics are kept).
+ */
+void WS2812B_Protocol_Reset(void);
+
+/**
+ * @brief Parse received bytes and apply every complete, valid packet.
+ * @param data Received bytes (any split across calls is allowed)
+ * @param len Number of bytes
+ * @note Render-loop context (writes the framebuffer).
+ */
+void WS2812B_Protocol_Feed(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Parse received bytes that arrived at a known time.
+ * @param data Received bytes
+ * @param len Number of bytes
+ * @param now Arrival time in ms; frame packets are pushed to WS2812B_Tween with it
+ * @note WS2812B_Protocol_Feed() reuses the time of the previous call.
+ */
+void WS2812B_Protocol_FeedAt(const uint8_t *data, uint32_t len, uint32_t now);
+
+/**
+ * @brief Check for and clear the "new frame received" flag.
+ * @return true if at least one frame packet was applied since the last call.
+ */
+bool WS2812B_Protocol_TakeFrame(void);
+
+/**
+ * @brief Copy the parser statistics.
+ * @param[out] stats Statistics
+ */
+void WS2812B_Protocol_GetStats(ws2812b_protocol_stats_t *stats);
+
+/**
+ * @brief Build a packet (for tests, benchmarks and host tools).
+ * @param type @ref ws2812b_packet_type_t
+ * @param payload Payload bytes; may already sit in place at @p out + 4
+ * @param len Payload length
+ * @param[out] out Buffer of at least len + WS2812B_PROTOCOL_OVERHEAD bytes
+ * @return Packet length in bytes.
+ */
+uint32_t WS2812B_Protocol_BuildPacket(uint8_t type, const uint8_t *payload, uint16_t len, uint8_t *out);
+
+/**
+ * @brief Collect the device status from the modules.
+ * @param[out] status Status
+ */
+void WS2812B_Protocol_GetStatus(ws2812b_status_t *status);
+
+/**
+ * @brief Serialize a status, little-endian.
+ * @param status Status
+ * @param[out] out Buffer of WS2812B_STATUS_SIZE bytes
+ */
+void WS2812B_Protocol_PackStatus(const ws2812b_status_t *status, uint8_t *out);
+
+/**
+ * @brief Deserialize a PACKET_STATUS payload.
+ * @param in Payload
+ * @param len Payload length
+ * @param[out] status Status
+ * @return false if the length or version does not match.
+ */
+bool WS2812B_Protocol_UnpackStatus(const uint8_t *in, uint16_t len, ws2812b_status_t *status);
+
+// ===================================================================
+// ============================ UART GLUE ============================
+// ===================================================================
+
+/**
+ * @brief Start circular DMA reception and register the command queue.
+ * @param huart UART handle (its RX DMA channel is switched to circular mode)
+ * @return true on success; false if no RX DMA channel is linked to @p huart
+ *         (see HAL_UART_MspInit() in main.c).
+ */
+bool WS2812B_Protocol_Start(UART_HandleTypeDef *huart);
+
+/**
+ * @brief Send a packet to the host (blocking, on the UART given to WS2812B_Protocol_Start()).
+ * @param type @ref ws2812b_packet_type_t
+ * @param payload Payload bytes
+ * @param len Payload length
+ * @return false if the protocol is not started or the transmit failed.
+ * @note Render-loop context only; takes (len + 5) x 10 / baud seconds.
+ */
+bool WS2812B_Protocol_Send(uint8_t type, const uint8_t *payload, uint16_t len);
+
+/**
+ * @brief Send the device status as a PACKET_STATUS packet.
+ * @return false if the protocol is not started or the transmit failed.
+ * @note Called by WS2812B_Control for CMD_STATUS (render-loop context).
+ */
+bool WS2812B_Protocol_SendStatus(void);
+
+/**
+ * @brief Feed everything the DMA received since the last call to the parser.
+ * @note Call once per frame from the render loop.
+ */
+void WS2812B_Protocol_Poll(void);
+
+/**
+ * @brief Check whether streamed frames currently own the strip.
+ * @return true if a frame arrived within WS2812B_PROTOCOL_HOLD_MS.
+ */
+bool WS2812B_Protocol_StreamActive(void);
+
+#endif /* WS2812B_PROTOCOL_H */
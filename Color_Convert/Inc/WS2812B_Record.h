@@ -0,0 +1,213 @@
+/**
+ * @file WS2812B_Record.h
+ * @brief Recording of control input and frame checksums for deterministic replay on the host.
+ *
+ * A glitch seen on the strip ("the rainbow stutters after a preset recall")
+ * is hard to chase on the target. While recording, every input that changes
+ * the effect engine is logged with its time: parameter blocks taken by
+ * WS2812B_Control_Apply(), commands run by WS2812B_Control_Execute() (buttons,
+ * encoder, serial protocol) and one entry per rendered frame carrying the
+ * tick the frame was rendered at and a checksum of the PWM buffer it sent. The host replay tool (host/ws2812b_replay.c) runs the
+ * same effect code against a virtual clock set from the log, feeds it the
+ * same inputs at the same ticks and compares every frame checksum, so the
+ * first frame that differs pinpoints the divergence, and the frame can be
+ * stepped through in a debugger.
+ *
+ * The log is a ring that keeps the latest part of the session. Replay needs
+ * a known state to start from, so the log opens with a keyframe: a marker
+ * and a snapshot of the effect state, including the phases the effect code
+ * keeps to itself (WS2812B_Effects_GetPhase(): rainbow, breathe, auto-cycle
+ * timer, fire noise). After every half ring of entries another keyframe is
+ * written at the end of a frame; when the ring wraps over the oldest
+ * keyframe, the whole stretch up to the next one is dropped, so the log
+ * always starts at a keyframe and holds half to all of the ring. The
+ * current limiter's output scale depends on a measurement, so it is logged
+ * when it changes and replayed as logged. Not recorded: streamed frames
+ * (marked, not verified), playlist packets, the contents of the
+ * preset/playlist flash pages, and the state of a running playlist or
+ * preset crossfade, so a log that starts at a keyframe inside one of those
+ * may differ until it ends.
+ *
+ * Cost: WS2812B_RECORD_SIZE x 8 bytes of RAM; per frame one FNV-1a pass over
+ * the PWM buffer while recording, nothing otherwise. At 20 fps the default
+ * 256 entries hold the last 6 to 12 s; long strips (WS2812B_LONG_STRIP)
+ * default to 72 entries, the last 0.5 to 2 s.
+ *
+ * Dump: CMD_RECORD with RECORD_DUMP sends the log over the protocol UART as
+ * PACKET_RECORD packets (blocking, ~90 ms for 2 KB at 230400 baud):
+ * | Field   | Size | Notes                                      |
+ * |---------|------|--------------------------------------------|
+ * | first   | 2    | Index of the first entry in this packet    |
+ * | total   | 2    | Entries in the log (oldest keyframe first) |
+ * | entries | 8 n  | n <= WS2812B_RECORD_DUMP_ENTRIES, see below|
+ * The dump is complete when first + n == total. Entry (little-endian):
+ * dt_ms (uint16), kind (uint8), type (uint8), value (int32).
+ */
+
+#ifndef WS2812B_RECORD_H
+#define WS2812B_RECORD_H
+
+#include "WS2812B_Effects.h"
+#include "WS2812B_Control.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_RECORD_SIZE
+#if WS2812B_LONG_STRIP
+#define WS2812B_RECORD_SIZE         72      ///< Log entries (8 bytes each)
+#else
+#define WS2812B_RECORD_SIZE         256     ///< Log entries (8 bytes each)
+#endif
+#endif
+
+#define WS2812B_RECORD_DUMP_ENTRIES 32      ///< Entries per PACKET_RECORD
+#define WS2812B_RECORD_ENTRY_SIZE   8       ///< Serialized entry size
+#define WS2812B_RECORD_VERSION      2       ///< Log format, in the keyframe markers
+
+/**
+ * @brief CMD_RECORD arguments.
+ */
+typedef enum {
+    RECORD_STOP = 0,            ///< Stop recording; the log is kept
+    RECORD_START = 1,           ///< Clear the log and start recording (overwrites the oldest entries when full)
+    RECORD_DUMP = 2             ///< Send the log over the protocol UART
+} ws2812b_record_action_t;
+
+/**
+ * @brief Entry kinds.
+ */
+typedef enum {
+    RECORD_START_MARK = 0,      ///< Keyframe at the start of the session: type = format version, value = tick (absolute)
+    RECORD_STATE,               ///< Snapshot field: type = @ref ws2812b_record_field_t
+    RECORD_PARAMS,              ///< Parameter block, part 1: type = effect, value = hue | brightness << 16 | speed << 24
+    RECORD_PARAMS_CYCLE,        ///< Parameter block, part 2: type = auto_cycle, value = cycle_duration
+    RECORD_COMMAND,             ///< type = @ref ws2812b_cmd_type_t, value = argument
+    RECORD_FRAME,               ///< type = @ref ws2812b_record_source_t, value = WS2812B_Record_FrameHash()
+    RECORD_TIME,                ///< Time gap beyond 65535 ms: value = gap in ms
+    RECORD_KEYFRAME,            ///< Keyframe later in the session: type = format version, value = tick (absolute)
+    RECORD_SCALE                ///< Output scale changed (current limiter): value = WS2812B_GetOutputScale()
+} ws2812b_record_kind_t;
+
+/**
+ * @brief Effect state fields in the snapshot that follows a keyframe marker.
+ */
+typedef enum {
+    FIELD_LED_NUM = 0,          ///< LED_NUM of the firmware (replay must match)
+    FIELD_TIMER_PERIOD,         ///< TIM3 auto-reload (bit timing of the PWM buffer)
+    FIELD_OUTPUT,               ///< Output enabled (CMD_POWER state)
+    FIELD_EFFECT,
+    FIELD_HUE,
+    FIELD_HUE16,
+    FIELD_HUE_STEP,
+    FIELD_BRIGHTNESS,
+    FIELD_BREATHE_DIRECTION,
+    FIELD_THEATER_FRAME,
+    FIELD_EFFECT_SPEED,
+    FIELD_AUTO_CYCLE,
+    FIELD_CYCLE_DURATION,
+    FIELD_GLOBAL_BRIGHTNESS,    ///< WS2812B_GetBrightness()
+    FIELD_GLOBAL_SPEED,         ///< WS2812B_GetSpeed()
+    FIELD_MIRROR,               ///< WS2812B_GetMirror()
+    FIELD_RAINBOW_HUE,          ///< ws2812b_effects_phase_t fields from here on
+    FIELD_CHASE_OFFSET,
+    FIELD_BREATHE_LEVEL,
+    FIELD_BREATHE_STEP,
+    FIELD_CYCLE_ELAPSED,
+    FIELD_FIRE_SEED,
+    FIELD_COUNT
+} ws2812b_record_field_t;
+
+/**
+ * @brief What produced a frame.
+ */
+typedef enum {
+    FRAME_EFFECTS = 0,          ///< Preset/playlist tick + WS2812B_Effects_Handle()
+    FRAME_OFF,                  ///< Output disabled, WS2812B_Off()
+    FRAME_STREAM                ///< Host stream (not reproducible, not verified)
+} ws2812b_record_source_t;
+
+/**
+ * @brief One log entry.
+ */
+typedef struct {
+    uint16_t dt_ms;             ///< Time since the previous entry
+    uint8_t kind;               ///< @ref ws2812b_record_kind_t
+    uint8_t type;               ///< Meaning depends on kind
+    int32_t value;              ///< Meaning depends on kind
+} ws2812b_record_entry_t;
+
+/**
+ * @brief Clear the log, write the first keyframe and start recording.
+ * @param effects Effect state owned by the render loop
+ * @param output_enabled Current CMD_POWER state
+ */
+void WS2812B_Record_Start(const ws2812b_effects_t *effects, bool output_enabled);
+
+/**
+ * @brief Stop recording (the log is kept for dumping).
+ */
+void WS2812B_Record_Stop(void);
+
+/**
+ * @brief Check whether recording is on.
+ */
+bool WS2812B_Record_Active(void);
+
+/**
+ * @brief Mark the start of a frame: later entries of this frame carry its tick.
+ * @note Call once per frame from the render loop, before WS2812B_Control_Apply().
+ */
+void WS2812B_Record_BeginFrame(void);
+
+/**
+ * @brief Log a parameter block taken by WS2812B_Control_Apply().
+ */
+void WS2812B_Record_Params(const ws2812b_params_t *params);
+
+/**
+ * @brief Log a command run by WS2812B_Control_Execute() (CMD_RECORD and CMD_STATUS are not logged).
+ */
+void WS2812B_Record_Command(uint8_t type, int32_t value);
+
+/**
+ * @brief Close the frame: log its source and the checksum of the PWM buffer
+ *        (preceded by the output scale if it changed), then a keyframe if one is due.
+ * @param source @ref ws2812b_record_source_t
+ */
+void WS2812B_Record_EndFrame(uint8_t source);
+
+/**
+ * @brief FNV-1a checksum of the encoded frame (pwmData, WS2812B_DATA_SIZE values).
+ */
+uint32_t WS2812B_Record_FrameHash(void);
+
+/**
+ * @brief Number of entries in the log (at most WS2812B_RECORD_SIZE).
+ */
+uint16_t WS2812B_Record_Count(void);
+
+/**
+ * @brief Copy one entry out of the log.
+ * @param index 0 is the marker of the oldest keyframe
+ * @return false if @p index is out of range.
+ */
+bool WS2812B_Record_Get(uint16_t index, ws2812b_record_entry_t *entry);
+
+/**
+ * @brief Serialize an entry (WS2812B_RECORD_ENTRY_SIZE bytes, little-endian).
+ */
+void WS2812B_Record_Pack(const ws2812b_record_entry_t *entry, uint8_t *out);
+
+/**
+ * @brief Deserialize an entry written by WS2812B_Record_Pack().
+ */
+void WS2812B_Record_Unpack(const uint8_t *in, ws2812b_record_entry_t *entry);
+
+/**
+ * @brief Send the log as PACKET_RECORD packets over the protocol UART.
+ * @return false if the UART is not started or a transmit failed.
+ * @note Blocking: takes (entries x 8 + packets x 9) x 10 / baud seconds.
+ */
+bool WS2812B_Record_Dump(void);
+
+#endif /* WS2812B_RECORD_H */
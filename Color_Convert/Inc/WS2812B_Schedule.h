@@ -0,0 +1,112 @@
+/**
+ * @file WS2812B_Schedule.h
+ * @brief Time-of-day schedule (RTC/LSE): switch presets and ramp brightness at fixed times.
+ *
+ * The RTC second interrupt evaluates the schedule once per second and posts
+ * commands to a dedicated WS2812B_Control queue, so the render loop is never
+ * touched and frame timing is unaffected. Evaluation is a pure function of the
+ * time of day, so a reset or a clock change resumes the right scene and ramp
+ * position immediately.
+ *
+ * - Preset: recalled when its entry becomes the active one (the last entry
+ *   at or before now; before the first entry, the last one from yesterday).
+ * - Brightness: ramps linearly from the previous entry's brightness to the
+ *   entry's own over @c ramp_s seconds, one CMD_SET_BRIGHTNESS per 1% step.
+ *   When any entry sets a brightness, the schedule owns the brightness and
+ *   re-applies it after each preset recall.
+ *
+ * @code
+ * static const ws2812b_schedule_entry_t shop[] = {
+ *     { WS2812B_SCHEDULE_TIME(7, 0),  1,                     80, 15 * 60 },
+ *     { WS2812B_SCHEDULE_TIME(19, 0), 2,                     40, 30 * 60 },
+ *     { WS2812B_SCHEDULE_TIME(23, 0), WS2812B_SCHEDULE_KEEP, 5,  60 * 60 },
+ * };
+ * WS2812B_Schedule_Init(shop, 3);
+ * @endcode
+ */
+
+#ifndef WS2812B_SCHEDULE_H
+#define WS2812B_SCHEDULE_H
+
+#include "WS2812B_Control.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define WS2812B_SCHEDULE_DAY        86400UL ///< Seconds per day
+#define WS2812B_SCHEDULE_KEEP       0xFF    ///< Entry field not changed by this entry
+
+/** @brief Seconds since midnight for @p h:@p m. */
+#define WS2812B_SCHEDULE_TIME(h, m) ((uint32_t)(h) * 3600UL + (uint32_t)(m) * 60UL)
+
+/**
+ * @brief One schedule entry.
+ */
+typedef struct {
+    uint32_t time;          ///< Seconds since midnight
+    uint8_t preset;         ///< Preset index to recall, or WS2812B_SCHEDULE_KEEP
+    uint8_t brightness;     ///< Target brightness (0–100%), or WS2812B_SCHEDULE_KEEP
+    uint16_t ramp_s;        ///< Brightness ramp length in seconds (0 = jump)
+} ws2812b_schedule_entry_t;
+
+/**
+ * @brief Install a schedule and start the RTC second interrupt.
+ * @param table Entries sorted by time (must stay valid, typically const)
+ * @param count Number of entries (0 disables the schedule)
+ * @note Call after MX_RTC_Init(). The RTC keeps counting on LSE across resets.
+ */
+void WS2812B_Schedule_Init(const ws2812b_schedule_entry_t* table, uint8_t count);
+
+/**
+ * @brief Set the RTC time of day.
+ * @param hours Hours (0–23)
+ * @param minutes Minutes (0–59)
+ * @param seconds Seconds (0–59)
+ * @return false if the RTC rejected the time.
+ * @note Main-loop context only. Fails if the RTC is not running (no LSE).
+ */
+bool WS2812B_Schedule_SetClock(uint8_t hours, uint8_t minutes, uint8_t seconds);
+
+/**
+ * @brief Current RTC time of day.
+ * @return Seconds since midnight.
+ */
+uint32_t WS2812B_Schedule_Now(void);
+
+// ===================================================================
+// ================= CLOCK-INDEPENDENT CORE (simulation) =============
+// ===================================================================
+
+/**
+ * @brief Install a schedule without touching the RTC.
+ * @param table Entries sorted by time
+ * @param count Number of entries
+ */
+void WS2812B_Schedule_SetTable(const ws2812b_schedule_entry_t* table, uint8_t count);
+
+/**
+ * @brief Evaluate the schedule and post commands for any change.
+ * @param now Seconds since midnight (values >= one day wrap)
+ * @note Called once per second by the RTC interrupt.
+ */
+void WS2812B_Schedule_Evaluate(uint32_t now);
+
+/**
+ * @brief Index of the active entry.
+ * @param now Seconds since midnight
+ * @return Entry index, or -1 if the table is empty.
+ */
+int WS2812B_Schedule_ActiveEntry(uint32_t now);
+
+/**
+ * @brief Scheduled brightness.
+ * @param now Seconds since midnight
+ * @return Brightness (0–100%), or -1 if no entry sets a brightness.
+ */
+int WS2812B_Schedule_BrightnessAt(uint32_t now);
+
+/**
+ * @brief Command queue fed by the schedule (for inspection in simulation).
+ */
+ws2812b_cmd_queue_t* WS2812B_Schedule_Queue(void);
+
+#endif /* WS2812B_SCHEDULE_H */
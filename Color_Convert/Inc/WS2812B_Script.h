@@ -0,0 +1,167 @@
+/**
+ * @file WS2812B_Script.h
+ * @brief Sequential animation scripts (stackless coroutines) for WS2812B effects.
+ *
+ * A script is a plain C function written top-to-bottom that suspends itself
+ * with the WS2812B_SCRIPT_* macros and is resumed once per frame by
+ * WS2812B_Script_Tick(). This replaces hand-written state machines such as
+ * the `breathe_dir` / `theater_frame` statics in WS2812B_Effects.c.
+ *
+ * Script state lives in a fixed pool (no heap). Local C variables do NOT
+ * survive a suspension point; keep anything that must persist in
+ * `script->local[]`.
+ *
+ * Example:
+ * @code
+ * bool MyScript(ws2812b_script_t *s)
+ * {
+ *     WS2812B_SCRIPT_BEGIN(s);
+ *     for (s->local[0] = 0; s->local[0] < 3; s->local[0]++) {
+ *         WS2812B_SCRIPT_FADE_TO(s, 255, 0, 0, WS2812B_SCRIPT_MS(500));
+ *         WS2812B_SCRIPT_FRAMES(s, 30);
+ *         WS2812B_SCRIPT_FADE_TO(s, 0, 0, 0, WS2812B_SCRIPT_MS(500));
+ *     }
+ *     WS2812B_SCRIPT_END(s);
+ * }
+ * @endcode
+ */
+
+#ifndef WS2812B_SCRIPT_H
+#define WS2812B_SCRIPT_H
+
+#include "WS2812B.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_SCRIPT_POOL_SIZE
+#define WS2812B_SCRIPT_POOL_SIZE   4    ///< Maximum number of concurrently running scripts
+#endif
+
+#ifndef WS2812B_SCRIPT_LOCALS
+#define WS2812B_SCRIPT_LOCALS      4    ///< Persistent variables per script
+#endif
+
+#ifndef WS2812B_SCRIPT_FRAME_MS
+#define WS2812B_SCRIPT_FRAME_MS    20   ///< Nominal frame period used by WS2812B_SCRIPT_MS()
+#endif
+
+/** @brief Convert a duration in milliseconds to a frame count (rounded up). */
+#define WS2812B_SCRIPT_MS(ms) \
+    ((uint16_t)(((ms) + WS2812B_SCRIPT_FRAME_MS - 1) / WS2812B_SCRIPT_FRAME_MS))
+
+/** @brief Marks the intentional fall-through into a resume label. */
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+#define WS2812B_SCRIPT_FALLTHROUGH  __attribute__((fallthrough))
+#else
+#define WS2812B_SCRIPT_FALLTHROUGH  ((void)0)
+#endif
+
+typedef struct ws2812b_script ws2812b_script_t;
+
+/**
+ * @brief Script body.
+ * @param script The script's own state block.
+ * @return true while the script is still running, false when finished.
+ */
+typedef bool (*ws2812b_script_fn_t)(ws2812b_script_t *script);
+
+/**
+ * @brief Script state block (one pool slot).
+ */
+struct ws2812b_script {
+    ws2812b_script_fn_t fn;                 ///< Script body (NULL = free slot)
+    uint16_t resume;                        ///< Resume point (line of last suspension, 0 = start)
+    uint16_t wait;                          ///< Frames left in the current wait/fade
+    uint16_t fade_len;                      ///< Total frames of the current fade
+    uint8_t rgb[3];                         ///< Color currently shown by this script
+    uint8_t from[3];                        ///< Fade start color
+    uint8_t to[3];                          ///< Fade target color
+    int32_t local[WS2812B_SCRIPT_LOCALS];   ///< Variables preserved across suspensions
+    void *user;                             ///< User context passed to WS2812B_Script_Start()
+};
+
+// ===================================================================
+// ======================== SCRIPT BODY MACROS =======================
+// ===================================================================
+
+/** @brief Must be the first statement of a script body. */
+#define WS2812B_SCRIPT_BEGIN(s)     switch ((s)->resume) { case 0:
+
+/** @brief Must be the last statement of a script body. */
+#define WS2812B_SCRIPT_END(s)       } (s)->resume = 0; return false
+
+/** @brief Suspend until the next frame. */
+#define WS2812B_SCRIPT_YIELD(s)                                         \
+    do {                                                                \
+        (s)->resume = __LINE__; return true; case __LINE__:;            \
+    } while (0)
+
+/** @brief Suspend for @p n frames. */
+#define WS2812B_SCRIPT_FRAMES(s, n)                                     \
+    do {                                                                \
+        (s)->wait = (n);                                                \
+        (s)->resume = __LINE__; WS2812B_SCRIPT_FALLTHROUGH;             \
+        case __LINE__:                                                  \
+        if ((s)->wait) { (s)->wait--; return true; }                    \
+    } while (0)
+
+/** @brief Fill the strip with a linear fade to (r, g, b) over @p frames frames. */
+#define WS2812B_SCRIPT_FADE_TO(s, r, g, b, frames)                      \
+    do {                                                                \
+        WS2812B_Script_FadeBegin((s), (r), (g), (b), (frames));         \
+        (s)->resume = __LINE__; WS2812B_SCRIPT_FALLTHROUGH;             \
+        case __LINE__:                                                  \
+        if (WS2812B_Script_FadeStep(s)) return true;                    \
+    } while (0)
+
+// ===================================================================
+// ============================ SCHEDULER ============================
+// ===================================================================
+
+/**
+ * @brief Start a script in a free pool slot.
+ * @param fn   Script body.
+ * @param user User context stored in `script->user`.
+ * @return The script's state block, or NULL if the pool is full.
+ */
+ws2812b_script_t* WS2812B_Script_Start(ws2812b_script_fn_t fn, void *user);
+
+/**
+ * @brief Stop a running script and release its pool slot.
+ * @param script Script returned by WS2812B_Script_Start().
+ */
+void WS2812B_Script_Stop(ws2812b_script_t *script);
+
+/**
+ * @brief Stop all running scripts.
+ */
+void WS2812B_Script_StopAll(void);
+
+/**
+ * @brief Resume every running script once (call once per frame, before WS2812B_Send()).
+ * @return Number of scripts still running.
+ */
+uint8_t WS2812B_Script_Tick(void);
+
+/**
+ * @brief Prepare a fade (used by WS2812B_SCRIPT_FADE_TO).
+ */
+void WS2812B_Script_FadeBegin(ws2812b_script_t *script, uint8_t red, uint8_t green, uint8_t blue, uint16_t frames);
+
+/**
+ * @brief Render the next fade frame (used by WS2812B_SCRIPT_FADE_TO).
+ * @return true if a frame was rendered, false when the fade is complete.
+ */
+bool WS2812B_Script_FadeStep(ws2812b_script_t *script);
+
+// ===================================================================
+// ========================= BUILT-IN SCRIPTS ========================
+// ===================================================================
+
+/**
+ * @brief Breathing effect written as a script.
+ * @note Uses `local[0..2]` = RGB color, `local[3]` = frames per half period.
+ */
+bool WS2812B_Script_Breathe(ws2812b_script_t *script);
+
+#endif /* WS2812B_SCRIPT_H */
@@ -0,0 +1,107 @@
+/**
+ * @file WS2812B_Stream.h
+ * @brief Framebuffer-less "pixel shader" rendering straight into the DMA bitstream.
+ *
+ * An effect is a pure function color = f(index, time) evaluated from the DMA
+ * half/complete interrupts for the next chunk of pixels and encoded into a
+ * small circular PWM buffer. RAM use is independent of the strip length, so
+ * strips far longer than LED_NUM can be driven.
+ *
+ * While a stream is running it owns TIM3/DMA; WS2812B_Send() is ignored.
+ * Each chunk must be rendered faster than it is transmitted
+ * (24 bits × 1.25 µs ≈ 30 µs per LED); see WS2812B_Stream_GetStats().
+ */
+
+#ifndef WS2812B_STREAM_H
+#define WS2812B_STREAM_H
+
+#include "WS2812B.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_STREAM_CHUNK
+#define WS2812B_STREAM_CHUNK        4   ///< LEDs rendered per DMA half-transfer
+#endif
+
+#ifndef WS2812B_STREAM_RESET_SLOTS
+#define WS2812B_STREAM_RESET_SLOTS  3   ///< Zero LED slots after each frame (72 bits ≈ 90 µs latch)
+#endif
+
+/**
+ * @brief Pixel shader: compute the color of one LED.
+ * @param index LED index (0 to led_count - 1)
+ * @param time  Frame timestamp in ms (identical for all LEDs of a frame)
+ * @param ctx   User context given to WS2812B_Stream_Start()
+ * @param[out] red, green, blue Output color (0–255)
+ * @note Runs in interrupt context; must not block.
+ */
+typedef void (*ws2812b_shader_t)(uint16_t index, uint32_t time, const void *ctx,
+                                 uint8_t *red, uint8_t *green, uint8_t *blue);
+
+/**
+ * @brief Parameters for the built-in shaders.
+ */
+typedef struct {
+    uint16_t hue;           ///< Base hue (0–359)
+    uint8_t sat;            ///< Saturation (0–100%)
+    uint8_t val;            ///< Value / peak brightness (0–100%)
+    uint16_t spacing;       ///< Rainbow: hue step per LED. Chase: LEDs per lit pixel
+    uint16_t period_ms;     ///< Time for one full cycle of the animation
+} ws2812b_shader_params_t;
+
+/**
+ * @brief Stream timing statistics (CPU cycles, DWT based).
+ */
+typedef struct {
+    uint32_t frames;            ///< Frames emitted since start
+    uint32_t max_chunk_cycles;  ///< Worst-case render time of one chunk
+    uint32_t budget_cycles;     ///< Transmit time of one chunk (render must stay below)
+    uint32_t over_budget;       ///< Chunks whose render time exceeded the budget
+} ws2812b_stream_stats_t;
+
+/**
+ * @brief Start continuous streaming of a shader.
+ * @param led_count Number of LEDs on the strip (may exceed LED_NUM).
+ * @param shader    Pixel shader.
+ * @param ctx       Context passed to the shader (may be NULL).
+ * @return HAL status of the DMA start.
+ */
+HAL_StatusTypeDef WS2812B_Stream_Start(uint16_t led_count, ws2812b_shader_t shader, const void *ctx);
+
+/**
+ * @brief Stop streaming and return TIM3/DMA to single-shot mode.
+ */
+void WS2812B_Stream_Stop(void);
+
+/**
+ * @brief Check whether a stream currently owns the DMA channel.
+ */
+bool WS2812B_Stream_IsActive(void);
+
+/**
+ * @brief Get timing statistics of the running stream.
+ */
+void WS2812B_Stream_GetStats(ws2812b_stream_stats_t *stats);
+
+/**
+ * @brief Refill the second buffer half (called from the PWM-finished callback).
+ */
+void WS2812B_Stream_TransferComplete(void);
+
+// ===================================================================
+// ========================= BUILT-IN SHADERS ========================
+// ===================================================================
+
+/** @brief Moving rainbow: hue advances `spacing` degrees per LED, one turn per `period_ms`. */
+void WS2812B_Shader_Rainbow(uint16_t index, uint32_t time, const void *ctx,
+                            uint8_t *red, uint8_t *green, uint8_t *blue);
+
+/** @brief Whole-strip breathing between 10% and `val`, one pulse per `period_ms`. */
+void WS2812B_Shader_Breathe(uint16_t index, uint32_t time, const void *ctx,
+                            uint8_t *red, uint8_t *green, uint8_t *blue);
+
+/** @brief Theater chase: every `spacing`-th LED lit, pattern shifts `spacing` steps per `period_ms`. */
+void WS2812B_Shader_Chase(uint16_t index, uint32_t time, const void *ctx,
+                          uint8_t *red, uint8_t *green, uint8_t *blue);
+
+#endif /* WS2812B_STREAM_H */
@@ -0,0 +1,131 @@
+/**
+ * @file WS2812B_Tween.h
+ * @brief Jitter buffer and frame interpolation for streamed frames.
+ *
+ * A host streaming at 20–25 fps looks choppy next to local effects. Every
+ * frame packet the protocol applies is copied into a small ring of frames
+ * together with its arrival time, and the render loop shows the stream at its
+ * own (higher) rate by interpolating between the two frames that bracket
+ * the playout time, now - delay.
+ *
+ * Each frame gets a presentation time on a smoothed timeline: the previous
+ * presentation time plus the average arrival interval, kept within
+ * ±delay/2 of the actual arrival. Frames that arrive in bursts (several in
+ * one poll, then a gap) are therefore played out evenly. The delay must
+ * cover one source interval plus the arrival jitter, or the output holds the
+ * last frame until the next one arrives (an underrun).
+ *
+ * Added latency: a frame is fully shown about @c delay ms after it arrived
+ * (plus up to one local frame period). WS2812B_Tween_GetStats() reports the
+ * measured arrival-to-shown latency together with the estimated source
+ * interval and jitter, so the delay can be tuned on the target. Delay 0
+ * disables buffering: the newest frame is shown as is, with no added latency.
+ *
+ * RAM: WS2812B_TWEEN_DEPTH x LED_NUM x 3 bytes. The buffer must hold
+ * delay / interval + 2 frames, otherwise the oldest frames are dropped
+ * (counted as overflows). Long strips (WS2812B_LONG_STRIP) default to 2
+ * frames, and to a 30 ms delay: a full frame of 300 LEDs takes 39 ms at
+ * 230400 baud, so the source interval is at least that long.
+ *
+ * Host simulation, 25 fps source polled every 10 ms, output value vs. an ideal ramp:
+ * | Arrival               | Delay | RMS step error | Latency avg / max |
+ * |-----------------------|-------|----------------|-------------------|
+ * | Steady                | 0     | 1.74           | 0 / 0 ms          |
+ * | Steady                | 60    | 0.11           | 70 / 90 ms        |
+ * | ±20 ms jitter         | 0     | 1.72           | 0 / 0 ms          |
+ * | ±20 ms jitter         | 60    | 0.26           | 67 / 80 ms        |
+ * | Bursts of 3 per 120ms | 0     | 3.33           | 0 / 0 ms          |
+ * | Bursts of 3 per 120ms | 60    | 0.86           | 63 / 100 ms       |
+ */
+
+#ifndef WS2812B_TWEEN_H
+#define WS2812B_TWEEN_H
+
+#include "WS2812B.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef WS2812B_TWEEN_DEPTH
+#if WS2812B_LONG_STRIP
+#define WS2812B_TWEEN_DEPTH         2       ///< Frames in the jitter buffer (>= 2)
+#else
+#define WS2812B_TWEEN_DEPTH         4       ///< Frames in the jitter buffer (>= 2)
+#endif
+#endif
+
+#ifndef WS2812B_TWEEN_DELAY_MS
+#if WS2812B_LONG_STRIP
+#define WS2812B_TWEEN_DELAY_MS      30      ///< Default playout delay (below one source interval)
+#else
+#define WS2812B_TWEEN_DELAY_MS      60      ///< Default playout delay (25 fps source with ±20 ms jitter)
+#endif
+#endif
+
+#ifndef WS2812B_TWEEN_FRAME_MS
+#define WS2812B_TWEEN_FRAME_MS      10      ///< Local output period while streaming
+#endif
+
+#ifndef WS2812B_TWEEN_RESYNC_MS
+#define WS2812B_TWEEN_RESYNC_MS     1000    ///< Arrival gap that restarts the timeline
+#endif
+
+/**
+ * @brief Jitter buffer statistics.
+ */
+typedef struct {
+    uint32_t frames;            ///< Frames pushed
+    uint32_t overflows;         ///< Oldest frame dropped because the buffer was full
+    uint32_t underruns;         ///< Times the output held a frame because the next one was late
+    uint32_t resyncs;           ///< Timeline restarts (stream start, gap, arrival beyond ±delay/2)
+    uint16_t interval_ms;       ///< Estimated source frame interval
+    uint16_t jitter_ms;         ///< Mean deviation of the arrival interval
+    uint16_t latency_ms;        ///< Arrival to fully shown, most recent frame
+    uint16_t latency_avg_ms;    ///< Arrival to fully shown, running average
+    uint16_t latency_max_ms;    ///< Arrival to fully shown, maximum since the last reset
+} ws2812b_tween_stats_t;
+
+/**
+ * @brief Empty the buffer and clear the statistics.
+ */
+void WS2812B_Tween_Reset(void);
+
+/**
+ * @brief Set the playout delay.
+ * @param delay_ms Delay in ms; 0 shows the newest frame without interpolation
+ * @note Empties the buffer.
+ */
+void WS2812B_Tween_SetDelay(uint16_t delay_ms);
+
+/**
+ * @brief Current playout delay in ms.
+ */
+uint16_t WS2812B_Tween_GetDelay(void);
+
+/**
+ * @brief Copy the WS2812B_Frame framebuffer into the jitter buffer.
+ * @param now Arrival time in ms
+ * @note Called by the protocol for every frame packet it applies.
+ */
+void WS2812B_Tween_Push(uint32_t now);
+
+/**
+ * @brief Encode the output frame for time @p now into the PWM buffer.
+ * @param now Time in ms
+ * @return false if the buffer is empty or the output is unchanged since the
+ *         last call (nothing needs to be sent).
+ */
+bool WS2812B_Tween_Encode(uint32_t now);
+
+/**
+ * @brief Encode and transmit the output frame if it changed.
+ * @note Call once per local frame while the stream is active.
+ */
+void WS2812B_Tween_Show(void);
+
+/**
+ * @brief Copy the statistics.
+ * @param[out] stats Statistics
+ */
+void WS2812B_Tween_GetStats(ws2812b_tween_stats_t *stats);
+
+#endif /* WS2812B_TWEEN_H */
@@ -0,0 +1,67 @@
+/**
+ * @file WS2812B_Warm.h
+ * @brief Warm restart: re-send the last frame and resume effects after a soft/watchdog reset.
+ *
+ * The encoded frame (pwmData) and a snapshot of the effect engine state live
+ * in the .noinit RAM section, which the startup code does not clear. Both are
+ * protected by a checksum; after power-on (random SRAM) or a firmware change
+ * the check fails and the firmware cold-starts as before. A reset that hits
+ * while the next frame is half-rendered into pwmData also fails the check.
+ *
+ * Boot sequence in main():
+ * @code
+ * MX_TIM3_Init();
+ * if (!WS2812B_Warm_ResendLastFrame()) { WS2812B_Clear(); WS2812B_Send(); }
+ * if (!WS2812B_Warm_Restore(&led_effects)) WS2812B_Effects_Init(&led_effects);
+ * // ... remaining peripheral init ...
+ * @endcode
+ */
+
+#ifndef WS2812B_WARM_H
+#define WS2812B_WARM_H
+
+#include "WS2812B_Effects.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Record the checksum of pwmData (called by WS2812B_Send()).
+ */
+void WS2812B_Warm_FrameSent(void);
+
+/**
+ * @brief Re-send the frame that was on the strip before the reset.
+ * @return true if a valid frame was found and sent, false on cold boot.
+ * @note Needs only clocks, DMA and TIM3 initialized.
+ */
+bool WS2812B_Warm_ResendLastFrame(void);
+
+/**
+ * @brief Snapshot the engine state (call once per frame after WS2812B_Effects_Handle()).
+ * @param effects Current effect state.
+ */
+void WS2812B_Warm_Save(const ws2812b_effects_t* effects);
+
+/**
+ * @brief Restore the engine state saved before the reset.
+ * @param[out] effects Effect state to restore into.
+ * @return true if a valid snapshot was restored, false on cold boot.
+ * @note Also restores global brightness and speed, and the effect phases
+ *       (WS2812B_Effects_SetPhase()), so animations continue where they were.
+ */
+bool WS2812B_Warm_Restore(ws2812b_effects_t* effects);
+
+/**
+ * @brief Invalidate the saved frame and state (e.g. before an intentional power-down).
+ */
+void WS2812B_Warm_Invalidate(void);
+
+/**
+ * @brief HAL tick (ms since HAL_Init()) at which the first frame of this boot was latched.
+ * @return Tick of the first latch, or 0 if no frame was sent yet.
+ * @note The startup code before main() (.data copy, .bss clear) is not
+ *       included; measure reset to first latch on NRST and DIN with a scope.
+ */
+uint32_t WS2812B_Warm_FirstFrameTick(void);
+
+#endif /* WS2812B_WARM_H */
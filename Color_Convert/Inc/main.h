@@ -35,7 +35,13 @@ extern "C" {
 
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
-
+/**
+ * @brief System clock path selected by SystemClock_Config().
+ */
+typedef enum {
+  CLOCK_PATH_HSE_72MHZ,   /*!< HSE 8 MHz x 9 = 72 MHz (normal) */
+  CLOCK_PATH_HSI_64MHZ    /*!< HSI/2 x 16 = 64 MHz (HSE failed to start) */
+} clock_path_t;
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
@@ -65,7 +71,19 @@ void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
+#define BTN_Pin GPIO_PIN_0
+#define BTN_GPIO_Port GPIOB
+#define BTN_EXTI_IRQn EXTI0_IRQn
+#define ENC_A_Pin GPIO_PIN_6
+#define ENC_A_GPIO_Port GPIOB
+#define ENC_A_EXTI_IRQn EXTI9_5_IRQn
+#define ENC_B_Pin GPIO_PIN_7
+#define ENC_B_GPIO_Port GPIOB
+#define ENC_B_EXTI_IRQn EXTI9_5_IRQn
+
 /* USER CODE BEGIN Private defines */
+#define ISENSE_Pin GPIO_PIN_0         // Shunt amplifier output (ADC1_IN0), see WS2812B_Current.h
+#define ISENSE_GPIO_Port GPIOA
 
 /* USER CODE END Private defines */
 
@@ -77,6 +95,10 @@ void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim);
 extern TIM_HandleTypeDef htim3;
 extern DMA_HandleTypeDef hdma_tim3_ch1_trig;
 
+/**
+ * @brief Active clock path (telemetry), set by SystemClock_Config().
+ */
+extern volatile clock_path_t system_clock_path;
 /* USER CODE END PV */
 
 #ifdef __cplusplus
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Decode TIM3 CCR1 writes from a Renode peripheral-access log into WS2812B frames.
+
+Each non-zero CCR1 value is one bit; values above 48% of the timer period
+(ARR + 1, taken from the logged ARR writes) are ones. Without an ARR write
+the midpoint between the shortest and longest pulse of the frame is used. A run of zero writes (the reset
+gap) ends a frame. Exit status is non-zero if no frame was seen or if any
+frame does not have exactly 24 bits per LED, so it can gate CI.
+"""
+
+import argparse
+import re
+import sys
+
+TIM3_SPAN = 0x400  # Renode logs the offset in TIM3 or the bus address 0x400004xx
+ARR_OFFSET = 0x2C
+CCR1_OFFSET = 0x34
+
+ACCESS_RE = re.compile(r"[Ww]rite\w*\s+to\s+0x([0-9A-Fa-f]+).*?value\s+0x([0-9A-Fa-f]+)")
+
+
+def read_writes(path):
+    """Yield (offset, value) for every TIM3 register write."""
+    with open(path, encoding="utf-8", errors="replace") as log:
+        for line in log:
+            match = ACCESS_RE.search(line)
+            if match:
+                yield int(match.group(1), 16) % TIM3_SPAN, int(match.group(2), 16)
+
+
+def split_frames(writes):
+    """Group consecutive non-zero CCR1 values into (frame, period) tuples."""
+    frame = []
+    period = 0
+    for offset, value in writes:
+        if offset == ARR_OFFSET:
+            period = value + 1
+        elif offset != CCR1_OFFSET:
+            continue
+        elif value:
+            frame.append(value)
+        elif frame:
+            yield frame, period
+            frame = []
+    if frame:
+        yield frame, period
+
+
+def decode(frame, period):
+    """Return (rgb list, t0h, t1h) for one frame of compare values."""
+    low, high = min(frame), max(frame)
+    threshold = period * 0.48 if period else (low + high) / 2
+    bits = [1 if v > threshold else 0 for v in frame]
+    pixels = []
+    for i in range(0, len(bits) - len(bits) % 24, 24):
+        byte = [int("".join(map(str, bits[i + j:i + j + 8])), 2) for j in (0, 8, 16)]
+        green, red, blue = byte
+        pixels.append((red, green, blue))
+    return pixels, low, high
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="Renode log file with TIM3 accesses")
+    parser.add_argument("--leds", type=int, default=8, help="LED_NUM the firmware was built with")
+    parser.add_argument("--seconds", type=float, default=0, help="virtual run time, for frames/second")
+    parser.add_argument("--show", type=int, default=3, help="number of frames to print")
+    args = parser.parse_args()
+
+    expected = 24 * args.leds
+    frames = bad = 0
+    timings = set()
+
+    for frame, period in split_frames(read_writes(args.log)):
+        frames += 1
+        pixels, t0h, t1h = decode(frame, period)
+        timings.add((t0h, t1h))
+        if len(frame) != expected:
+            bad += 1
+            print(f"frame {frames}: {len(frame)} bits, expected {expected}")
+        elif frames <= args.show:
+            print(f"frame {frames}: " + " ".join(f"{r:02x}{g:02x}{b:02x}" for r, g, b in pixels))
+
+    print(f"frames: {frames}, malformed: {bad}")
+    print("compare values (T0H, T1H): " + ", ".join(f"{a}/{b}" for a, b in sorted(timings)))
+    if args.seconds > 0:
+        print(f"frame rate: {frames / args.seconds:.1f} fps (virtual time)")
+
+    return 1 if frames == 0 or bad else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Tests for decode_ws2812b.py against the committed TIM3 sample log.
+
+testdata/tim3_sample.log is host/ws2812b_tim3_log output for LED_NUM=8: the
+ARR write of WS2812B_InitTiming() at 72 MHz, then three frames of a fixed
+pattern as the TIM3 DMA writes them to CCR1 (one byte of pwmData per bit,
+50 zero slots of reset gap). make -C host check-emulation regenerates it and
+fails when it differs, then runs these tests:
+
+    python3 emulation/test_decode_ws2812b.py
+"""
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import unittest
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, HERE)
+
+import decode_ws2812b  # noqa: E402
+
+SAMPLE = os.path.join(HERE, "testdata", "tim3_sample.log")
+DECODER = os.path.join(HERE, "decode_ws2812b.py")
+LEDS = 8
+FRAMES = 3
+T0H, T1H = 29, 58  # 400 / 800 ns at 72 MHz
+
+
+def pattern(frame, led):
+    """The colors host/ws2812b_tim3_log.c sends (pattern())."""
+    return ((led * 32 + frame * 8) & 0xFF, (0xFF - led * 32) & 0xFF, ((frame * 0x55) ^ (led * 3)) & 0xFF)
+
+
+def run_decoder(path, *args):
+    """Run the decoder as CI does; return (exit status, output)."""
+    result = subprocess.run([sys.executable, DECODER, path, "--leds", str(LEDS), *args],
+                            capture_output=True, text=True, check=False)
+    return result.returncode, result.stdout
+
+
+def rewrite_log(transform):
+    """Write the sample with every CCR1 line passed through transform(line) to a temporary file."""
+    with open(SAMPLE, encoding="utf-8") as log:
+        lines = [transform(line) if "CaptureCompare1" in line else line for line in log]
+    handle, path = tempfile.mkstemp(suffix=".log")
+    with os.fdopen(handle, "w", encoding="utf-8") as out:
+        out.writelines(line for line in lines if line is not None)
+    return path
+
+
+class SampleLog(unittest.TestCase):
+    def test_frames_and_compare_values(self):
+        frames = list(decode_ws2812b.split_frames(decode_ws2812b.read_writes(SAMPLE)))
+        self.assertEqual(len(frames), FRAMES)
+        for f, (values, period) in enumerate(frames):
+            self.assertEqual(period, 91, "ARR 90 from WS2812B_InitTiming() at 72 MHz")
+            self.assertEqual(len(values), 24 * LEDS)
+            self.assertEqual(set(values), {T0H, T1H})
+            pixels, t0h, t1h = decode_ws2812b.decode(values, period)
+            self.assertEqual((t0h, t1h), (T0H, T1H))
+            self.assertEqual(pixels, [pattern(f, i) for i in range(LEDS)])
+
+    def test_command_line(self):
+        status, out = run_decoder(SAMPLE, "--seconds", "1")
+        self.assertEqual(status, 0, out)
+        self.assertIn(f"frames: {FRAMES}, malformed: 0", out)
+        self.assertIn(f"compare values (T0H, T1H): {T0H}/{T1H}", out)
+        self.assertIn(f"frame rate: {FRAMES:.1f} fps", out)
+
+    def test_bus_addresses(self):
+        """A log with bus addresses (0x40000434) decodes the same as one with offsets."""
+        path = rewrite_log(lambda line: line.replace("to 0x34", "to 0x40000434"))
+        try:
+            status, out = run_decoder(path)
+        finally:
+            os.unlink(path)
+        self.assertEqual(status, 0, out)
+        self.assertIn(f"frames: {FRAMES}, malformed: 0", out)
+
+
+class BrokenCaptures(unittest.TestCase):
+    def test_halfword_dma_of_byte_buffer(self):
+        """The DMA reading pwmData as halfwords writes two bits per CCR1 value: every frame is malformed."""
+        values = []
+
+        def pack(line):
+            value = int(re.search(r"value 0x([0-9A-F]+)", line).group(1), 16)
+            values.append(value)
+            if len(values) % 2:
+                return None
+            return re.sub(r"value 0x[0-9A-F]+", f"value 0x{values[-2] | (values[-1] << 8):X}", line)
+
+        path = rewrite_log(pack)
+        try:
+            status, out = run_decoder(path)
+        finally:
+            os.unlink(path)
+        self.assertNotEqual(status, 0, out)
+        self.assertNotIn("malformed: 0", out)
+
+    def test_no_dma_request(self):
+        """Without the CC1 DMA request only the ARR write is logged: no frame, failure."""
+        path = rewrite_log(lambda line: None)
+        try:
+            status, out = run_decoder(path)
+        finally:
+            os.unlink(path)
+        self.assertNotEqual(status, 0, out)
+        self.assertIn("frames: 0", out)
+
+
+if __name__ == "__main__":
+    unittest.main()
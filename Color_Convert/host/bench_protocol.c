@@ -0,0 +1,192 @@
+/**
+ * @file bench_protocol.c
+ * @brief Host benchmark: protocol parser throughput per packet type on valid input.
+ *
+ * Builds a stream of valid packets of one type (commands, raw frames, RLE
+ * frames, playlists), feeds it to WS2812B_Protocol_Feed() for a fixed time,
+ * and prints MB/s and packets/s, once in one call per stream and once in
+ * 32-byte chunks (packets split across DMA drains). Queued commands are
+ * drained with WS2812B_Control_Apply() after each stream, as the render loop
+ * does, and that time is included.
+ *
+ * Every packet must be accepted: the run fails if the parser reports a CRC,
+ * length or decode error, so an optimization that speeds up a parser by
+ * rejecting valid input shows up here. Pair it with the host/fuzz_*.c targets,
+ * which catch the overruns. Host numbers only compare parser versions; the
+ * cycles per packet on the target come from the WS2812B_BENCHMARK build
+ * (protocol_frame, protocol_rle).
+ *
+ * Build and run (from Color_Convert/):
+ * @code
+ * make -C host build/bench_protocol && host/build/bench_protocol [seconds per case]
+ * @endcode
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "WS2812B_Protocol.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define STREAM_SIZE     16384
+#define CHUNK           32
+
+static uint8_t stream[STREAM_SIZE];
+static uint32_t stream_len;
+static uint32_t stream_packets;
+static ws2812b_effects_t fx;
+static int failures = 0;
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Append one packet to the stream.
+ * @return false if the stream is full.
+ */
+static bool add_packet(uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    if (stream_len + len + WS2812B_PROTOCOL_OVERHEAD > STREAM_SIZE) return false;
+    stream_len += WS2812B_Protocol_BuildPacket(type, payload, len, &stream[stream_len]);
+    stream_packets++;
+    return true;
+}
+
+/**
+ * @brief Command stream: one queue's worth of CMD_SET_BRIGHTNESS.
+ */
+static void build_commands(void)
+{
+    for (int i = 0; i < WS2812B_CMD_QUEUE_SIZE; i++)
+    {
+        uint8_t p[5] = { CMD_SET_BRIGHTNESS, (uint8_t)(20 + i), 0, 0, 0 };
+        add_packet(PACKET_COMMAND, p, sizeof(p));
+    }
+}
+
+/**
+ * @brief Raw frame stream: full frames of changing pixels.
+ */
+static void build_frames(void)
+{
+    uint8_t p[2 + 3 * LED_NUM] = { 0, 0 };
+    for (uint32_t n = 0; ; n++)
+    {
+        for (uint32_t i = 2; i < sizeof(p); i++) p[i] = (uint8_t)(i * 7U + n);
+        if (!add_packet(PACKET_FRAME, p, sizeof(p))) return;
+    }
+}
+
+/**
+ * @brief RLE frame stream: full frames of runs of 1 to 8 pixels.
+ */
+static void build_rle_frames(void)
+{
+    uint8_t p[2 + 4 * LED_NUM] = { 0, 0 };
+    for (uint32_t n = 0; ; n++)
+    {
+        uint16_t len = 2;
+        for (uint32_t pixel = 0, run = 0; pixel < LED_NUM; pixel += p[len - 4], run++)
+        {
+            uint32_t count = 1U + (run + n) % 8U;
+            p[len++] = (uint8_t)((count < LED_NUM - pixel) ? count : LED_NUM - pixel);
+            p[len++] = (uint8_t)(run * 30U);
+            p[len++] = (uint8_t)(n * 5U);
+            p[len++] = (uint8_t)(run ^ n);
+        }
+        if (len > WS2812B_PROTOCOL_MAX_PAYLOAD || !add_packet(PACKET_FRAME_RLE, p, len)) return;
+    }
+}
+
+/**
+ * @brief Playlist stream: full playlists of effect entries.
+ */
+static void build_playlists(void)
+{
+    uint8_t p[WS2812B_PLAYLIST_WIRE_SIZE(WS2812B_PLAYLIST_MAX_ENTRIES)] = { WS2812B_PLAYLIST_MAX_ENTRIES, 0 };
+    for (uint32_t n = 0; n < WS2812B_CMD_QUEUE_SIZE; n++)
+    {
+        for (uint32_t i = 0; i < WS2812B_PLAYLIST_MAX_ENTRIES; i++)
+        {
+            uint8_t *e = &p[2 + 6 * i];
+            e[0] = PLAYLIST_ENTRY_EFFECT;
+            e[1] = (uint8_t)((i + n) % WS2812B_EFFECT_COUNT);
+            e[2] = (uint8_t)(1U + i);
+            e[3] = 0;
+            e[4] = (uint8_t)(10U + n);
+            e[5] = 0;
+        }
+        if (!add_packet(PACKET_PLAYLIST, p, sizeof(p))) return;
+    }
+}
+
+static void feed_stream(uint32_t chunk)
+{
+    for (uint32_t pos = 0; pos < stream_len; pos += chunk)
+    {
+        WS2812B_Protocol_Feed(&stream[pos], (stream_len - pos < chunk) ? stream_len - pos : chunk);
+    }
+    WS2812B_Protocol_TakeFrame();
+    WS2812B_Control_Apply(&fx);
+}
+
+static void bench(const char *name, void (*build)(void), double seconds)
+{
+    stream_len = 0;
+    stream_packets = 0;
+    build();
+
+    printf("%-9s: %5u B/packet", name, (unsigned)(stream_len / stream_packets));
+    for (int split = 0; split < 2; split++)
+    {
+        uint32_t chunk = split ? CHUNK : stream_len;
+        ws2812b_protocol_stats_t before, after;
+        uint64_t runs = 0;
+
+        WS2812B_Protocol_Reset();
+        WS2812B_Protocol_GetStats(&before);
+        double start = now_s(), elapsed;
+        do
+        {
+            for (int i = 0; i < 16; i++, runs++) feed_stream(chunk);
+            elapsed = now_s() - start;
+        } while (elapsed < seconds);
+        WS2812B_Protocol_GetStats(&after);
+
+        uint64_t packets = runs * stream_packets;
+        printf(" | %s: %7.1f MB/s, %9.0f packets/s", split ? "32 B chunks" : "whole",
+               (double)(runs * stream_len) / elapsed / 1e6, (double)packets / elapsed);
+
+        uint32_t errors = (after.crc_errors - before.crc_errors) + (after.length_errors - before.length_errors) +
+                          (after.decode_errors - before.decode_errors);
+        if (errors != 0 || after.packets - before.packets != (uint32_t)packets)
+        {
+            printf("\nFAIL: %s: %u of %llu valid packets rejected", name, errors, (unsigned long long)packets);
+            failures++;
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = (argc > 1) ? atof(argv[1]) : 0.5;
+
+    // Registers the command queue; the host UART has no DMA, so reception does not start
+    static DMA_HandleTypeDef hdma;
+    static UART_HandleTypeDef huart = { .hdmarx = &hdma };
+    WS2812B_Protocol_Start(&huart);
+
+    bench("command", build_commands, seconds);
+    bench("frame", build_frames, seconds);
+    bench("frame rle", build_rle_frames, seconds);
+    bench("playlist", build_playlists, seconds);
+
+    printf("%s (%d failures)\n", failures ? "FAILED" : "passed", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file bench_script.c
+ * @brief Host benchmark: WS2812B_Script_Tick() resume overhead per frame.
+ *
+ * Times WS2812B_Script_Tick() with the pool empty (the scan of the pool
+ * alone), with one and with every slot running a script that only yields,
+ * and with scripts suspended in WS2812B_SCRIPT_FRAMES() and in a
+ * WS2812B_SCRIPT_FADE_TO() (WS2812B_Script_Breathe(), which also fills the
+ * strip). A hand-written state machine called through a function pointer,
+ * the way the effect statics are stepped, is timed next to them. The resume
+ * cost is the yield case minus the empty pool, per script.
+ *
+ * Every tick must report the expected number of running scripts, otherwise
+ * the run fails. Host numbers only compare scheduler versions; the cycles on
+ * the target come from the WS2812B_BENCHMARK build (script_resume).
+ *
+ * Build and run (from Color_Convert/):
+ * @code
+ * make -C host build/bench_script && host/build/bench_script [seconds per case]
+ * @endcode
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "WS2812B_Script.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TICKS_PER_CHECK 1024
+
+static int failures = 0;
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Script that only yields: the pure resume cost.
+ */
+static bool yield_script(ws2812b_script_t *s)
+{
+    WS2812B_SCRIPT_BEGIN(s);
+    for (;;)
+    {
+        WS2812B_SCRIPT_YIELD(s);
+    }
+    WS2812B_SCRIPT_END(s);
+}
+
+/**
+ * @brief Script that waits in long WS2812B_SCRIPT_FRAMES() pauses.
+ */
+static bool frames_script(ws2812b_script_t *s)
+{
+    WS2812B_SCRIPT_BEGIN(s);
+    for (;;)
+    {
+        WS2812B_SCRIPT_FRAMES(s, 60000);
+    }
+    WS2812B_SCRIPT_END(s);
+}
+
+/**
+ * @brief The same as yield_script() as a hand-written state machine.
+ */
+static bool state_machine(uint8_t *state)
+{
+    *state = (uint8_t)(*state ^ 1U);
+    return true;
+}
+
+static bool (*volatile state_fn)(uint8_t *) = state_machine;
+
+/**
+ * @brief Time ticks until @p seconds have passed.
+ * @param running Number of scripts every tick must report (ignored for the state machine).
+ * @return Nanoseconds per tick.
+ */
+static double time_ticks(const char *name, bool baseline, uint8_t running, double seconds)
+{
+    uint8_t state = 0;
+    uint64_t ticks = 0;
+    uint32_t wrong = 0;
+    double start = now_s(), elapsed;
+
+    do
+    {
+        for (int i = 0; i < TICKS_PER_CHECK; i++)
+        {
+            if (baseline) state_fn(&state);
+            else if (WS2812B_Script_Tick() != running) wrong++;
+        }
+        ticks += TICKS_PER_CHECK;
+        elapsed = now_s() - start;
+    } while (elapsed < seconds);
+
+    if (wrong != 0)
+    {
+        printf("FAIL: %s: %u ticks did not report %u running scripts\n", name, wrong, running);
+        failures++;
+    }
+    return elapsed * 1e9 / (double)ticks;
+}
+
+/**
+ * @brief Fill the pool with @p count instances of @p fn (after stopping all scripts).
+ */
+static void start_scripts(ws2812b_script_fn_t fn, uint8_t count)
+{
+    WS2812B_Script_StopAll();
+    for (uint8_t i = 0; i < count; i++)
+    {
+        ws2812b_script_t *s = WS2812B_Script_Start(fn, NULL);
+        if (s == NULL)
+        {
+            printf("FAIL: pool full after %u scripts\n", i);
+            failures++;
+            return;
+        }
+        s->local[0] = 255;              // WS2812B_Script_Breathe(): color and half period
+        s->local[1] = 128;
+        s->local[2] = 64;
+        s->local[3] = 100;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = (argc > 1) ? atof(argv[1]) : 0.5;
+    const uint8_t pool = WS2812B_SCRIPT_POOL_SIZE;
+
+    start_scripts(yield_script, 0);
+    double empty = time_ticks("empty pool", false, 0, seconds);
+    start_scripts(yield_script, 1);
+    double one = time_ticks("1 yield", false, 1, seconds);
+    start_scripts(yield_script, pool);
+    double full = time_ticks("pool of yields", false, pool, seconds);
+    start_scripts(frames_script, pool);
+    double frames = time_ticks("pool in FRAMES", false, pool, seconds);
+    start_scripts(WS2812B_Script_Breathe, 1);
+    double fade = time_ticks("1 breathe", false, 1, seconds);
+    double baseline = time_ticks("state machine", true, 0, seconds);
+    WS2812B_Script_StopAll();
+
+    printf("empty pool (%u slots)      : %6.1f ns/tick\n", pool, empty);
+    printf("1 yield script            : %6.1f ns/tick, %5.1f ns per resume\n", one, one - empty);
+    printf("%u yield scripts           : %6.1f ns/tick, %5.1f ns per resume\n", pool, full, (full - empty) / pool);
+    printf("%u scripts in FRAMES()     : %6.1f ns/tick, %5.1f ns per resume\n", pool, frames, (frames - empty) / pool);
+    printf("1 breathe script (%3d LEDs): %6.1f ns/tick (fade step and strip fill)\n", LED_NUM, fade);
+    printf("state machine via pointer  : %6.1f ns/frame\n", baseline);
+
+    printf("%s (%d failures)\n", failures ? "FAILED" : "passed", failures);
+    return failures ? 1 : 0;
+}
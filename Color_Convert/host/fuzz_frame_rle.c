@@ -0,0 +1,94 @@
+/**
+ * @file fuzz_frame_rle.c
+ * @brief libFuzzer target: the run-length frame decoder (PACKET_FRAME_RLE payloads).
+ *
+ * The input is the payload: first pixel (uint16 LE), then runs of
+ * {count, R, G, B}. It is wrapped in a packet with a valid CRC by
+ * WS2812B_Protocol_BuildPacket() and fed to the parser, so every input
+ * reaches the decoder. The framebuffer is filled with a known pattern first
+ * and checked against a reference decoder afterwards:
+ * - Rejected payload: not a single pixel changed.
+ * - Accepted payload: the runs landed at the right pixels in the right
+ *   colors, every other pixel is unchanged, and the run total fit the strip.
+ * Overruns of the packet buffer or the framebuffer are reported by
+ * AddressSanitizer.
+ *
+ * Build and run with libFuzzer (clang, from Color_Convert/):
+ * @code
+ * make -C host CC=clang LIBFUZZER=1 build/fuzz_frame_rle && host/build/fuzz_frame_rle -max_len=512
+ * @endcode
+ * Without libFuzzer, link host/fuzz_main.c instead of -fsanitize=fuzzer.
+ */
+
+#include "WS2812B_Protocol.h"
+#include "WS2812B_Frame.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void pattern(uint16_t i, uint8_t rgb[3])
+{
+    rgb[0] = (uint8_t)i;
+    rgb[1] = (uint8_t)(255U - i);
+    rgb[2] = (uint8_t)(i ^ 0x5AU);
+}
+
+/**
+ * @brief Reference decoder.
+ * @param[in,out] frame RGB per LED, updated only if the payload is valid
+ * @return true if the firmware must accept the payload.
+ */
+static bool reference_decode(const uint8_t *p, size_t len, uint8_t frame[][3])
+{
+    if (len < 2 || (len - 2) % 4 != 0) return false;
+
+    size_t pixel = (size_t)p[0] | ((size_t)p[1] << 8);
+    size_t total = 0;
+    for (size_t i = 2; i < len; i += 4)
+    {
+        if (p[i] == 0) return false;
+        total += p[i];
+    }
+    if (pixel + total > LED_NUM) return false;
+
+    for (size_t i = 2; i < len; i += 4)
+    {
+        for (uint8_t n = p[i]; n > 0; n--, pixel++) memcpy(frame[pixel], &p[i + 1], 3);
+    }
+    return true;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static uint8_t packet[WS2812B_PROTOCOL_MAX_PAYLOAD + WS2812B_PROTOCOL_OVERHEAD];
+    uint8_t expected[LED_NUM][3];
+    ws2812b_protocol_stats_t before, after;
+
+    if (size > WS2812B_PROTOCOL_MAX_PAYLOAD) return 0;
+
+    WS2812B_Frame_SetScale(1);
+    for (uint16_t i = 0; i < LED_NUM; i++)
+    {
+        pattern(i, expected[i]);
+        WS2812B_Frame_SetPixelRGB(i, expected[i][0], expected[i][1], expected[i][2]);
+    }
+
+    uint32_t len = WS2812B_Protocol_BuildPacket(PACKET_FRAME_RLE, data, (uint16_t)size, packet);
+    WS2812B_Protocol_Reset();
+    WS2812B_Protocol_GetStats(&before);
+    WS2812B_Protocol_Feed(packet, len);
+    WS2812B_Protocol_GetStats(&after);
+    WS2812B_Protocol_TakeFrame();
+
+    bool valid = reference_decode(data, size, expected);
+    bool accepted = (after.frames != before.frames);
+    if (accepted != valid) abort();
+    if (!accepted && after.decode_errors == before.decode_errors) abort();
+
+    for (uint16_t i = 0; i < LED_NUM; i++)
+    {
+        uint8_t rgb[3];
+        WS2812B_Frame_GetPixelRGB(i, &rgb[0], &rgb[1], &rgb[2]);
+        if (memcmp(rgb, expected[i], 3) != 0) abort();
+    }
+    return 0;
+}
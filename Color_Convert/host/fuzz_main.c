@@ -0,0 +1,194 @@
+/**
+ * @file fuzz_main.c
+ * @brief Standalone driver for the host/fuzz_*.c targets where libFuzzer is not available.
+ *
+ * Link it in place of -fsanitize=fuzzer (gcc, or a clang without the fuzzer
+ * runtime) and keep the sanitizers; host/Makefile does that unless LIBFUZZER is set:
+ * @code
+ * make -C host build/fuzz_protocol && host/build/fuzz_protocol -runs=200000 seeds/
+ * @endcode
+ *
+ * Every file argument (or every file in a directory argument) is run once as
+ * is. Then -runs=N inputs (default 100000) are generated: random bytes (half
+ * of them below 8), or a seed file with a few bits flipped, bytes inserted or
+ * the tail cut, so that deeper paths are reached too. -seed=N makes a run
+ * repeatable. An input that fails a check of the target is saved to
+ * crash-input; pass it back as a file argument to reproduce. This is no
+ * coverage guided search; use libFuzzer for long runs.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <dirent.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define FUZZ_MAX_INPUT  4096
+#define MAX_SEEDS       256
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+} seed_t;
+
+static seed_t seeds[MAX_SEEDS];
+static int seed_count = 0;
+static const uint8_t *running;      ///< Input under test, saved if a target check aborts
+static size_t running_size;
+
+/**
+ * @brief SIGABRT (a failed target check): save the input as crash-input, like libFuzzer.
+ */
+static void on_abort(int sig)
+{
+    FILE *f = fopen("crash-input", "wb");
+    if (f != NULL)
+    {
+        fwrite(running, 1, running_size, f);
+        fclose(f);
+    }
+    fprintf(stderr, "target check failed, input (%zu bytes) saved to crash-input\n", running_size);
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+static void run_one(const uint8_t *data, size_t size)
+{
+    running = data;
+    running_size = size;
+    LLVMFuzzerTestOneInput(data, size);
+}
+
+static void run_file(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        perror(path);
+        return;
+    }
+
+    uint8_t *data = malloc(FUZZ_MAX_INPUT);
+    size_t size = fread(data, 1, FUZZ_MAX_INPUT, f);
+    fclose(f);
+
+    run_one(data, size);
+    if (seed_count < MAX_SEEDS)
+    {
+        seeds[seed_count++] = (seed_t){ data, size };
+    }
+    else
+    {
+        free(data);
+    }
+}
+
+static void run_path(const char *path)
+{
+    struct stat st;
+    if (stat(path, &st) == 0 && S_ISDIR(st.st_mode))
+    {
+        DIR *dir = opendir(path);
+        struct dirent *entry;
+        char file[1024];
+
+        while (dir != NULL && (entry = readdir(dir)) != NULL)
+        {
+            if (entry->d_name[0] == '.') continue;
+            snprintf(file, sizeof(file), "%s/%s", path, entry->d_name);
+            run_file(file);
+        }
+        if (dir != NULL) closedir(dir);
+    }
+    else
+    {
+        run_file(path);
+    }
+}
+
+/**
+ * @brief Random byte, half of them small: lengths, offsets and counts in
+ *        range are then common enough to get past the first checks.
+ */
+static uint8_t random_byte(void)
+{
+    return (uint8_t)((rand() & 1) ? rand() % 8 : rand());
+}
+
+/**
+ * @brief Next input: random bytes, or a mutated seed.
+ */
+static size_t generate(uint8_t *buf)
+{
+    size_t size;
+
+    if (seed_count == 0 || rand() % 4 == 0)
+    {
+        size = (size_t)rand() % 512U;
+        for (size_t i = 0; i < size; i++) buf[i] = random_byte();
+        return size;
+    }
+
+    const seed_t *seed = &seeds[rand() % seed_count];
+    size = seed->size;
+    memcpy(buf, seed->data, size);
+
+    for (int n = 1 + rand() % 4; n > 0; n--)
+    {
+        size_t pos = size ? (size_t)rand() % size : 0;
+        switch (rand() % 3)
+        {
+            case 0:     // Flip bits
+                if (size) buf[pos] ^= (uint8_t)(1U << (rand() % 8));
+                break;
+            case 1:     // Insert a byte
+                if (size < FUZZ_MAX_INPUT)
+                {
+                    memmove(&buf[pos + 1], &buf[pos], size - pos);
+                    buf[pos] = random_byte();
+                    size++;
+                }
+                break;
+            default:    // Cut the tail
+                size = pos;
+                break;
+        }
+    }
+    return size;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long runs = 100000;
+    unsigned seed = 1;
+
+    signal(SIGABRT, on_abort);
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "-runs=", 6) == 0) runs = strtoul(argv[i] + 6, NULL, 10);
+        else if (strncmp(argv[i], "-seed=", 6) == 0) seed = (unsigned)strtoul(argv[i] + 6, NULL, 10);
+        else if (argv[i][0] != '-') run_path(argv[i]);
+    }
+
+    srand(seed);
+    uint8_t *buf = malloc(FUZZ_MAX_INPUT);
+    for (unsigned long r = 0; r < runs; r++)
+    {
+        size_t size = generate(buf);
+        // A copy of exactly @c size bytes, so the sanitizer sees reads past the end
+        uint8_t *input = malloc(size ? size : 1);
+        memcpy(input, buf, size);
+        run_one(input, size);
+        free(input);
+    }
+    free(buf);
+
+    printf("%d seed files, %lu generated inputs, no crash\n", seed_count, runs);
+    return 0;
+}
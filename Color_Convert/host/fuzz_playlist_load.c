@@ -0,0 +1,103 @@
+/**
+ * @file fuzz_playlist_load.c
+ * @brief libFuzzer target: playlist loading over the protocol (PACKET_PLAYLIST payloads) and playback.
+ *
+ * The input is the payload: count, flags, then per entry type, index,
+ * weight, fade_frames, duration_ds (uint16 LE). It is wrapped in a packet
+ * with a valid CRC by WS2812B_Protocol_BuildPacket() and fed to the parser.
+ * - Rejected payload: the installed playlist is unchanged.
+ * - Accepted payload: WS2812B_Playlist_Get() holds exactly the entries sent,
+ *   and each one passes the checks the firmware relies on when it plays
+ *   them (known type, effect or preset index in range, non-zero duration).
+ * An accepted playlist is then started and played through 64 entry
+ * switches on a virtual clock, recalling presets and running their
+ * crossfades; every entry played must have a non-zero weight. Out-of-range
+ * preset or effect indexes are reported by AddressSanitizer.
+ *
+ * Build and run with libFuzzer (clang, from Color_Convert/):
+ * @code
+ * make -C host CC=clang LIBFUZZER=1 build/fuzz_playlist_load && host/build/fuzz_playlist_load -max_len=128
+ * @endcode
+ * Without libFuzzer, link host/fuzz_main.c instead of -fsanitize=fuzzer.
+ */
+
+#include "WS2812B_Protocol.h"
+#include "WS2812B_Playlist.h"
+#include "WS2812B_Preset.h"
+#include "ws2812b_host.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SWITCHES    64
+
+static ws2812b_effects_t fx;
+
+static bool entry_matches(const ws2812b_playlist_entry_t *e, const uint8_t *p)
+{
+    return e->type == p[0] && e->index == p[1] && e->weight == p[2] && e->fade_frames == p[3] &&
+           e->duration_ds == (uint16_t)(p[4] | (p[5] << 8));
+}
+
+static bool entry_playable(const ws2812b_playlist_entry_t *e)
+{
+    if (e->duration_ds == 0) return false;
+    if (e->type == PLAYLIST_ENTRY_EFFECT) return e->index < WS2812B_EFFECT_COUNT;
+    return e->type == PLAYLIST_ENTRY_PRESET && e->index < WS2812B_PRESET_COUNT;
+}
+
+/**
+ * @brief Play the installed playlist through SWITCHES entry changes.
+ */
+static void play(void)
+{
+    const ws2812b_playlist_t *pl = WS2812B_Playlist_Get();
+    uint32_t now = 0;
+
+    if (!WS2812B_Playlist_Start()) return;
+    for (int n = 0; n < SWITCHES && WS2812B_Playlist_IsActive(); n++)
+    {
+        WS2812B_Host_SetTick(now);
+        WS2812B_Preset_Tick(&fx);
+        WS2812B_Playlist_TickAt(&fx, now);
+
+        int current = WS2812B_Playlist_Current();
+        if (current >= 0 && (current >= pl->count || pl->entries[current].weight == 0)) abort();
+
+        // Run a crossfade to its end, then jump to the end of the entry
+        for (int f = 0; f < 256 && WS2812B_Preset_IsFading(); f++) WS2812B_Preset_Tick(&fx);
+        if (current >= 0) now += (uint32_t)pl->entries[current].duration_ds * 100U;
+    }
+    WS2812B_Playlist_Stop();
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static uint8_t packet[WS2812B_PROTOCOL_MAX_PAYLOAD + WS2812B_PROTOCOL_OVERHEAD];
+    ws2812b_playlist_t before;
+    ws2812b_protocol_stats_t stats_before, stats_after;
+
+    if (size > WS2812B_PROTOCOL_MAX_PAYLOAD) return 0;
+
+    before = *WS2812B_Playlist_Get();
+    uint32_t len = WS2812B_Protocol_BuildPacket(PACKET_PLAYLIST, data, (uint16_t)size, packet);
+    WS2812B_Protocol_Reset();
+    WS2812B_Protocol_GetStats(&stats_before);
+    WS2812B_Protocol_Feed(packet, len);
+    WS2812B_Protocol_GetStats(&stats_after);
+
+    const ws2812b_playlist_t *pl = WS2812B_Playlist_Get();
+    if (stats_after.decode_errors != stats_before.decode_errors)
+    {
+        if (memcmp(&before, pl, sizeof(before)) != 0) abort();
+        return 0;
+    }
+
+    if (size != (size_t)WS2812B_PLAYLIST_WIRE_SIZE(pl->count) || pl->count != data[0] || pl->flags != data[1]) abort();
+    for (uint8_t i = 0; i < pl->count; i++)
+    {
+        if (!entry_matches(&pl->entries[i], &data[2 + 6 * i]) || !entry_playable(&pl->entries[i])) abort();
+    }
+
+    play();
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file fuzz_protocol.c
+ * @brief libFuzzer target: the serial protocol parser on arbitrary bytes, split at arbitrary points.
+ *
+ * Input layout: one control byte, then the byte stream.
+ * - Bits 0-6 of the control byte give the chunk size the stream is fed in
+ *   (0 = one WS2812B_Protocol_Feed() call), so packets split across DMA
+ *   drains are explored too.
+ * - Bit 7 rewrites the CRC of every packet in the stream before feeding, so
+ *   the fuzzer reaches the decoders instead of stopping at the CRC check.
+ *
+ * Each input is fed twice, whole and in chunks, from the sync-hunting state
+ * and a cleared framebuffer; the parser statistics and the framebuffer must
+ * come out the same (a split must never change what a packet does). Queued
+ * commands are then executed with WS2812B_Control_Apply(), as the render
+ * loop does. Overruns of the packet buffer, the framebuffer or pwmData are
+ * reported by AddressSanitizer.
+ *
+ * Build and run with libFuzzer (clang, from Color_Convert/):
+ * @code
+ * make -C host CC=clang LIBFUZZER=1 build/fuzz_protocol && host/build/fuzz_protocol -max_len=2048 corpus/
+ * @endcode
+ * Without libFuzzer, link host/fuzz_main.c instead of -fsanitize=fuzzer.
+ */
+
+#include "WS2812B_Protocol.h"
+#include "WS2812B_Frame.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_MAX_INPUT  4096
+
+static ws2812b_effects_t fx;
+
+/**
+ * @brief Outcome of one pass: statistics delta and framebuffer.
+ */
+typedef struct {
+    ws2812b_protocol_stats_t stats;
+    uint8_t frame[3 * LED_NUM];
+} pass_t;
+
+/**
+ * @brief Give every complete packet in @p data a matching CRC.
+ */
+static void fix_crcs(uint8_t *data, uint32_t len)
+{
+    uint32_t i = 0;
+
+    while (i + 4 < len)
+    {
+        if (data[i] != WS2812B_PROTOCOL_SYNC)
+        {
+            i++;
+            continue;
+        }
+        uint32_t plen = (uint32_t)data[i + 2] | ((uint32_t)data[i + 3] << 8);
+        if (plen > WS2812B_PROTOCOL_MAX_PAYLOAD)
+        {
+            i += 4;     // The parser drops the header and hunts for sync after it
+            continue;
+        }
+        if (i + 4 + plen >= len) return;
+
+        // Same bytes through the packet builder; only the CRC is kept
+        static uint8_t packet[WS2812B_PROTOCOL_MAX_PAYLOAD + WS2812B_PROTOCOL_OVERHEAD];
+        WS2812B_Protocol_BuildPacket(data[i + 1], &data[i + 4], (uint16_t)plen, packet);
+        data[i + 4 + plen] = packet[4 + plen];
+        i += 5 + plen;
+    }
+}
+
+static void run_pass(const uint8_t *data, uint32_t len, uint32_t chunk, pass_t *out)
+{
+    ws2812b_protocol_stats_t before, after;
+
+    WS2812B_Frame_SetScale(1);      // Also clears the framebuffer
+    WS2812B_Protocol_Reset();
+    WS2812B_Protocol_GetStats(&before);
+
+    if (chunk == 0) chunk = len;
+    for (uint32_t pos = 0; pos < len; pos += chunk)
+    {
+        WS2812B_Protocol_Feed(&data[pos], (len - pos < chunk) ? len - pos : chunk);
+    }
+
+    WS2812B_Protocol_GetStats(&after);
+    out->stats = (ws2812b_protocol_stats_t){
+        .packets = after.packets - before.packets,
+        .frames = after.frames - before.frames,
+        .commands = after.commands - before.commands,
+        .crc_errors = after.crc_errors - before.crc_errors,
+        .length_errors = after.length_errors - before.length_errors,
+        .decode_errors = after.decode_errors - before.decode_errors,
+        .dropped_bytes = after.dropped_bytes - before.dropped_bytes,
+    };
+    for (uint16_t i = 0; i < LED_NUM; i++)
+    {
+        WS2812B_Frame_GetPixelRGB(i, &out->frame[3 * i], &out->frame[3 * i + 1], &out->frame[3 * i + 2]);
+    }
+
+    WS2812B_Protocol_TakeFrame();
+    WS2812B_Control_Apply(&fx);     // Drains the command queue for the next pass
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static bool started = false;
+    static uint8_t stream[FUZZ_MAX_INPUT];
+    static pass_t whole, split;
+
+    if (!started)
+    {
+        // Registers the command queue; the host UART has no DMA, so reception does not start
+        static DMA_HandleTypeDef hdma;
+        static UART_HandleTypeDef huart = { .hdmarx = &hdma };
+        WS2812B_Protocol_Start(&huart);
+        started = true;
+    }
+    if (size < 1 || size > FUZZ_MAX_INPUT) return 0;
+
+    uint32_t len = (uint32_t)size - 1U;
+    uint32_t chunk = data[0] & 0x7FU;
+    memcpy(stream, &data[1], len);
+    if (data[0] & 0x80U) fix_crcs(stream, len);
+
+    run_pass(stream, len, 0, &whole);
+    run_pass(stream, len, chunk, &split);
+
+    if (memcmp(&whole, &split, sizeof(whole)) != 0) abort();
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file stm32f1xx_hal.h
+ * @brief Host stand-in for the STM32F1 HAL header.
+ *
+ * Declares only the types, macros and functions the WS2812B driver modules
+ * use, so that the same sources (color conversion, shaders, protocol parser,
+ * framebuffer, tween) compile for a PC. Put this directory ahead of the real
+ * HAL on the include path; ws2812b_host_port.c implements the functions.
+ */
+
+#ifndef STM32F1XX_HAL_H
+#define STM32F1XX_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO                        volatile
+#define __STATIC_INLINE             static inline
+#define __disable_irq()             do { } while (0)
+#define __enable_irq()              do { } while (0)
+#define __get_PRIMASK()             0U
+#define __set_PRIMASK(x)            ((void)(x))
+#define __DMB()                     __sync_synchronize()
+#define __NOP()                     do { } while (0)
+
+typedef enum {
+    HAL_OK = 0,
+    HAL_ERROR = 1,
+    HAL_BUSY = 2,
+    HAL_TIMEOUT = 3
+} HAL_StatusTypeDef;
+
+// ---------------------------------------------------------------- Core
+typedef struct { uint32_t CTRL, CYCCNT; } DWT_Type;
+typedef struct { uint32_t DEMCR; } CoreDebug_Type;
+extern DWT_Type *DWT;
+extern CoreDebug_Type *CoreDebug;
+#define DWT_CTRL_CYCCNTENA_Msk      (1U << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1U << 24)
+
+typedef struct { uint32_t CR, CFGR; } RCC_TypeDef;
+extern RCC_TypeDef *RCC;
+#define RCC_CFGR_PPRE1              (7U << 8)
+#define RCC_CFGR_PPRE1_DIV1         0U
+#define RCC_CFGR_PPRE1_DIV2         (4U << 8)
+
+// ---------------------------------------------------------------- DMA
+#define DMA_NORMAL                  0x00U
+#define DMA_CIRCULAR                0x20U
+#define DMA_PDATAALIGN_HALFWORD     0x100U
+#define DMA_MDATAALIGN_BYTE         0x000U
+#define DMA_MDATAALIGN_HALFWORD     0x400U
+#define DMA_MDATAALIGN_WORD         0x800U
+
+typedef struct { uint32_t Direction, PeriphInc, MemInc, PeriphDataAlignment, MemDataAlignment, Mode, Priority; } DMA_InitTypeDef;
+typedef struct { uint32_t CCR, CNDTR, CPAR, CMAR; } DMA_Channel_TypeDef;
+typedef struct __DMA_HandleTypeDef {
+    DMA_Channel_TypeDef *Instance;
+    DMA_InitTypeDef Init;
+    void (*XferCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+} DMA_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(h)    ((h)->Instance->CNDTR)
+
+// ---------------------------------------------------------------- TIM
+typedef struct { uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR, RCR, CCR1, CCR2, CCR3, CCR4; } TIM_TypeDef;
+typedef struct { uint32_t Prescaler, CounterMode, Period, ClockDivision, AutoReloadPreload; } TIM_Base_InitTypeDef;
+typedef struct {
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+    DMA_HandleTypeDef *hdma[7];
+} TIM_HandleTypeDef;
+
+#define TIM_CHANNEL_1               0x00U
+#define HAL_TIM_ACTIVE_CHANNEL_1    0x01U
+#define __HAL_TIM_SET_AUTORELOAD(h, v)      ((h)->Instance->ARR = (v))
+#define __HAL_TIM_SET_COMPARE(h, c, v)      ((void)(c), (h)->Instance->CCR1 = (v))
+
+// ---------------------------------------------------------------- GPIO
+typedef struct { uint32_t IDR; } GPIO_TypeDef;
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+extern GPIO_TypeDef *GPIOB;
+#define GPIO_PIN_0                  0x0001U
+#define GPIO_PIN_6                  0x0040U
+#define GPIO_PIN_7                  0x0080U
+
+// ---------------------------------------------------------------- UART
+typedef struct { DMA_HandleTypeDef *hdmarx; } UART_HandleTypeDef;
+
+// ---------------------------------------------------------------- ADC
+typedef struct { DMA_HandleTypeDef *DMA_Handle; } ADC_HandleTypeDef;
+
+// ---------------------------------------------------------------- FLASH
+// Addresses are uint32_t on the target; uintptr_t here, so the flash pages
+// (RAM arrays in ws2812b_host_port.c) are addressed without truncation
+#define FLASH_TYPEPROGRAM_HALFWORD  0x01U
+#define FLASH_TYPEERASE_PAGES       0x00U
+typedef struct { uint32_t TypeErase, Banks; uintptr_t PageAddress; uint32_t NbPages; } FLASH_EraseInitTypeDef;
+
+// ---------------------------------------------------------------- RTC
+typedef struct { volatile uint32_t CNTH, CNTL; } RTC_TypeDef;
+typedef struct { RTC_TypeDef *Instance; } RTC_HandleTypeDef;
+typedef struct { uint8_t Hours, Minutes, Seconds; } RTC_TimeTypeDef;
+#define RTC_FORMAT_BIN              0x00U
+
+// ---------------------------------------------------------------- Functions
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t delay);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetSysClockFreq(void);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_TIM_PWM_Start_DMA(TIM_HandleTypeDef *htim, uint32_t channel, const uint32_t *data, uint16_t length);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_DMA(TIM_HandleTypeDef *htim, uint32_t channel);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin);
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *data, uint32_t length);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t type, uintptr_t address, uint64_t data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *erase, uint32_t *page_error);
+HAL_StatusTypeDef HAL_RTCEx_SetSecond_IT(RTC_HandleTypeDef *hrtc);
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *time, uint32_t format);
+
+#endif /* STM32F1XX_HAL_H */
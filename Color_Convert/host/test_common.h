@@ -0,0 +1,36 @@
+/**
+ * @file test_common.h
+ * @brief Check macro and failure counter shared by the host/test_*.c programs.
+ *
+ * Each test includes it once, counts failed checks in @c failures and ends
+ * with the same summary line, so that `make -C host check` and a reader see
+ * one format:
+ * @code
+ * CHECK(got == want, "frame %d: got %d, want %d", f, got, want);
+ * ...
+ * return TEST_SUMMARY();
+ * @endcode
+ */
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdio.h>
+
+static int failures = 0;
+
+/**
+ * @brief Count and report a failed check; the message is printf-formatted.
+ */
+#define CHECK(cond, ...)                                                        \
+    do {                                                                        \
+        if (!(cond)) { printf("FAIL: " __VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+/**
+ * @brief Print "passed"/"FAILED" with the failure count; evaluates to the exit status.
+ */
+#define TEST_SUMMARY()                                                          \
+    (printf("%s (%d failures)\n", failures ? "FAILED" : "passed", failures), failures ? 1 : 0)
+
+#endif /* TEST_COMMON_H */
@@ -0,0 +1,241 @@
+/**
+ * @file test_control.c
+ * @brief Host stress test: WS2812B_Control parameter block and SPSC command queues.
+ *
+ * On the target the producer is an ISR that preempts the render loop at any
+ * instruction. Here a 20 us interval timer plays that ISR: its signal
+ * handler publishes parameter blocks and pushes commands while the main
+ * loop, in the role of the render loop, takes snapshots and pops commands
+ * without pause.
+ * - Parameter block: every field of a published block is derived from one
+ *   counter, so a torn snapshot (fields from two publishes) is detected;
+ *   snapshots must also never go back in time. An unguarded copy of a
+ *   block written by the same handler is checked the same way, to show
+ *   that the harness does catch tearing.
+ * - ISR queue: values are a running sequence; the consumer must see every
+ *   pushed value exactly once and in order (pushes refused on a full queue
+ *   are counted, not lost silently).
+ * - Thread queue: the same check with the producer in a second thread, which
+ *   also exercises the barriers when the two sides run on different cores.
+ *
+ * Build and run (from Color_Convert/; host/Makefile builds every host program):
+ * @code
+ * make -C host build/test_control && host/build/test_control
+ * @endcode
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "WS2812B_Control.h"
+#include "test_common.h"
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define ISR_INTERVAL_US     20
+#define RUN_SECONDS         2
+#define THREAD_COMMANDS     2000000U
+
+/**
+ * @brief Parameter block whose fields all derive from @p k.
+ */
+static ws2812b_params_t params_for(uint32_t k)
+{
+    return (ws2812b_params_t){
+        .effect = (ws2812b_effect_t)(k % WS2812B_EFFECT_CYCLE_COUNT),
+        .hue = (uint16_t)(k % 360U),
+        .brightness = (uint8_t)(k % 101U),
+        .speed = (uint8_t)(1U + k % 100U),
+        .auto_cycle = (k & 1U) != 0,
+        .cycle_duration = k,
+    };
+}
+
+static bool params_consistent(const ws2812b_params_t *p)
+{
+    ws2812b_params_t want = params_for(p->cycle_duration);
+    return p->effect == want.effect && p->hue == want.hue && p->brightness == want.brightness &&
+           p->speed == want.speed && p->auto_cycle == want.auto_cycle;
+}
+
+// ===================================================================
+// ============================ ISR MODEL ============================
+// ===================================================================
+
+static ws2812b_cmd_queue_t isr_queue;
+static volatile uint32_t isr_publishes = 0;
+static volatile uint32_t isr_pushed = 0;        ///< Next value to push
+static volatile uint32_t isr_refused = 0;
+static volatile ws2812b_params_t unguarded;     ///< Same writes, no sequence counter
+static volatile bool in_snapshot = false;
+static volatile uint32_t preempted_snapshots = 0;
+
+/**
+ * @brief The "ISR": one publish, a burst of pushes.
+ */
+static void isr_handler(int sig)
+{
+    (void)sig;
+
+    if (in_snapshot) preempted_snapshots++;
+
+    ws2812b_params_t p = params_for(isr_publishes + 1U);
+    WS2812B_Params_Publish(&p);
+    isr_publishes++;
+
+    // Field-by-field, as a compiler may copy a struct
+    unguarded.cycle_duration = p.cycle_duration;
+    unguarded.effect = p.effect;
+    unguarded.hue = p.hue;
+    unguarded.brightness = p.brightness;
+    unguarded.speed = p.speed;
+    unguarded.auto_cycle = p.auto_cycle;
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (WS2812B_CmdQueue_Push(&isr_queue, CMD_SET_HUE, (int32_t)isr_pushed))
+        {
+            isr_pushed++;
+        }
+        else
+        {
+            isr_refused++;
+            break;
+        }
+    }
+}
+
+static void test_isr_model(void)
+{
+    struct sigaction sa = { .sa_handler = isr_handler };
+    struct itimerval timer = { { 0, ISR_INTERVAL_US }, { 0, ISR_INTERVAL_US } };
+    uint64_t snapshots = 0, torn = 0, backwards = 0, unguarded_torn = 0;
+    uint32_t last_k = 0, expected = 0, popped = 0, misordered = 0;
+    ws2812b_cmd_t cmd;
+
+    WS2812B_CmdQueue_Init(&isr_queue);
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGALRM, &sa, NULL);
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    struct timeval start, now;
+    gettimeofday(&start, NULL);
+    do
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            ws2812b_params_t p;
+
+            in_snapshot = true;
+            uint32_t seq = WS2812B_Params_Snapshot(&p);
+            in_snapshot = false;
+            snapshots++;
+
+            if (seq != 0)
+            {
+                if (!params_consistent(&p)) torn++;
+                if (p.cycle_duration < last_k) backwards++;
+                last_k = p.cycle_duration;
+            }
+
+            ws2812b_params_t u = {
+                .effect = unguarded.effect, .hue = unguarded.hue, .brightness = unguarded.brightness,
+                .speed = unguarded.speed, .auto_cycle = unguarded.auto_cycle,
+                .cycle_duration = unguarded.cycle_duration,
+            };
+            if (u.cycle_duration != 0 && !params_consistent(&u)) unguarded_torn++;
+
+            while (WS2812B_CmdQueue_Pop(&isr_queue, &cmd))
+            {
+                if (cmd.type != CMD_SET_HUE || (uint32_t)cmd.value != expected) misordered++;
+                expected = (uint32_t)cmd.value + 1U;
+                popped++;
+            }
+        }
+        gettimeofday(&now, NULL);
+    } while ((now.tv_sec - start.tv_sec) * 1000000L + (now.tv_usec - start.tv_usec) < RUN_SECONDS * 1000000L);
+
+    struct itimerval off = { { 0, 0 }, { 0, 0 } };
+    setitimer(ITIMER_REAL, &off, NULL);
+    while (WS2812B_CmdQueue_Pop(&isr_queue, &cmd))
+    {
+        if ((uint32_t)cmd.value != expected) misordered++;
+        expected = (uint32_t)cmd.value + 1U;
+        popped++;
+    }
+
+    printf("isr model : %u interrupts (%u inside a snapshot), %llu snapshots, %llu torn, %llu backwards; "
+           "unguarded copy torn %llu times\n",
+           isr_publishes, preempted_snapshots, (unsigned long long)snapshots, (unsigned long long)torn,
+           (unsigned long long)backwards, (unsigned long long)unguarded_torn);
+    printf("isr queue : %u pushed, %u popped, %u misordered, %u refused while full\n",
+           isr_pushed, popped, misordered, isr_refused);
+
+    CHECK(isr_publishes > 1000, "only %u interrupts", isr_publishes);
+    CHECK(torn == 0, "%llu torn snapshots", (unsigned long long)torn);
+    CHECK(backwards == 0, "%llu snapshots went back in time", (unsigned long long)backwards);
+    CHECK(popped == isr_pushed && misordered == 0, "queue lost or reordered commands");
+}
+
+// ===================================================================
+// =========================== THREAD QUEUE ==========================
+// ===================================================================
+
+static ws2812b_cmd_queue_t thread_queue;
+static uint32_t thread_refused = 0;
+
+static void *producer(void *arg)
+{
+    (void)arg;
+
+    for (uint32_t i = 0; i < THREAD_COMMANDS; i++)
+    {
+        while (!WS2812B_CmdQueue_Push(&thread_queue, (uint8_t)(1U + i % CMD_STATUS), (int32_t)i))
+        {
+            thread_refused++;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void test_thread_queue(void)
+{
+    pthread_t thread;
+    ws2812b_cmd_t cmd;
+    uint32_t expected = 0, misordered = 0;
+
+    WS2812B_CmdQueue_Init(&thread_queue);
+    pthread_create(&thread, NULL, producer, NULL);
+
+    while (expected < THREAD_COMMANDS)
+    {
+        if (!WS2812B_CmdQueue_Pop(&thread_queue, &cmd))
+        {
+            sched_yield();
+            continue;
+        }
+        if ((uint32_t)cmd.value != expected || cmd.type != (uint8_t)(1U + expected % CMD_STATUS))
+        {
+            if (misordered++ == 0) printf("first bad command at %u: type %u value %d\n", expected, cmd.type, cmd.value);
+            expected = (uint32_t)cmd.value;
+        }
+        expected++;
+    }
+    pthread_join(thread, NULL);
+
+    printf("thread queue: %u commands, %u misordered, producer found it full %u times\n",
+           THREAD_COMMANDS, misordered, thread_refused);
+    CHECK(misordered == 0, "%u misordered commands", misordered);
+    CHECK(!WS2812B_CmdQueue_Pop(&thread_queue, &cmd), "queue not empty at the end");
+}
+
+int main(void)
+{
+    test_isr_model();
+    test_thread_queue();
+
+    return TEST_SUMMARY();
+}
@@ -0,0 +1,208 @@
+/**
+ * @file test_current.c
+ * @brief Host test: the current limiter against a plant model of the strip and the shunt amplifier.
+ *
+ * WS2812B_Current_Update() is driven once per frame with a simulated reading
+ * of the frame before, as WS2812B_Current_Tick() does on the target. The
+ * plant is the one in WS2812B_Current.h: 60 LEDs at 20 mA per channel at
+ * full scale plus 1 mA quiescent each, 3 % supply sag at full load (3.55 A
+ * full white), and per ADC sample +-3 % uniform noise and 12-bit
+ * quantization through the default shunt and amplifier, averaged over
+ * WS2812B_CURRENT_SAMPLES by WS2812B_Current_CountsToMilliamps(). The noise
+ * generator has a fixed seed, so every run gives the same numbers.
+ *
+ * Each scenario of the table in WS2812B_Current.h is run for 120 frames
+ * with a 2 A limit and its figures are checked against the table:
+ * - First: the frame with the new content at the old scale, within 1 % of the limit.
+ * - Settle: frames until the current stays within +-5 % of the setpoint, at most the table value.
+ * - Overshoot: highest current after the first frame, at most 0.5 % of the limit above the table
+ *   (for the ramp, every frame is new content shown at the scale of the frame before).
+ * - Steady: mean over the last 60 frames within 0.2 % of the table, ripple
+ *   (RMS around the mean) at most 0.1 % above it.
+ * - Release (white -> 30 %): frames until the scale is back at 256.
+ *
+ * Build and run (from Color_Convert/); build/test_current_pi is the same test
+ * built with -DWS2812B_CURRENT_ATTACK_PCT=10000, checking the "attack off"
+ * rows (PI only) instead:
+ * @code
+ * make -C host build/test_current && host/build/test_current [-v]
+ * make -C host build/test_current_pi && host/build/test_current_pi [-v]
+ * @endcode
+ */
+
+#include "WS2812B_Current.h"
+#include "test_common.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PLANT_LEDS      60
+#define QUIESCENT_MA    1.0     ///< Per LED
+#define SAG_FULL        0.03    ///< Supply sag at the full-white current of a 20 mA/channel strip
+#define NOISE           0.03    ///< Per ADC sample, uniform
+#define LIMIT_MA        2000
+#define FRAMES          120
+#define STEADY_FRAMES   60      ///< Last frames averaged for the steady state
+#define SETTLE_BAND     0.05    ///< Of the setpoint
+
+static bool verbose = false;
+static uint32_t noise_state;
+
+/**
+ * @brief One scenario of the table: content over time and the expected figures.
+ * @note Negative first/overshoot/release mean "not applicable" ("-" in the table).
+ */
+typedef struct {
+    const char *name;
+    double (*content)(int frame);   ///< Fraction of full white
+    double ma_per_channel;
+    int step;                       ///< Frame the content changes
+    double first_pct;
+    int settle;                     ///< 0: not checked (the demand ramps)
+    double overshoot_pct;
+    double steady_pct;              ///< 0: not limited in the steady state
+    double ripple_pct;
+    int release;                    ///< Frames to scale 256, or -1
+} scenario_t;
+
+static double black_to_white(int f)     { return (f < 20) ? 0.0 : 1.0; }
+static double pattern_to_white(int f)   { return (f < 20) ? 0.7 : 1.0; }
+
+#if WS2812B_CURRENT_ATTACK_PCT < 10000
+static double white_to_pattern(int f)   { return (f < 40) ? 1.0 : 0.3; }
+
+/**
+ * @brief Demand 0.95 A, then a ramp to full white (3.55 A) over 40 frames.
+ */
+static double demand_ramp(int f)
+{
+    if (f < 20) return 0.25;
+    if (f < 60) return 0.25 + 0.75 * (f - 20) / 40.0;
+    return 1.0;
+}
+#endif
+
+static const scenario_t scenarios[] = {
+#if WS2812B_CURRENT_ATTACK_PCT >= 10000
+    { "black -> white",            black_to_white,   20.0, 20, 177.0, 4, 7.9, 97.0, 0.2, -1 },
+    { "limited 2.6 A -> white",    pattern_to_white, 20.0, 20, 136.0, 5, 14.7, 97.0, 0.1, -1 },
+#else
+    { "black -> white",            black_to_white,   20.0, 20, 177.0, 1, 0.0, 97.0, 0.2, -1 },
+    { "limited 2.6 A -> white",    pattern_to_white, 20.0, 20, 136.0, 1, 0.0, 97.0, 0.2, -1 },
+    { "white, 15 mA/channel",      black_to_white,   15.0, 20, 135.0, 1, 0.0, 96.9, 0.0, -1 },
+    { "ramp 0.95 -> 3.55 A",       demand_ramp,      20.0, 20, -1.0,  0, 1.9, 97.1, 0.4, -1 },
+    { "white -> 30% pattern",      white_to_pattern, 20.0, 40, -1.0,  0, -1.0, 0.0, 0.0, 2 },
+#endif
+};
+
+/**
+ * @brief Supply current of @p content shown at output scale @p scale.
+ */
+static double plant_ma(double content, double ma_per_channel, uint16_t scale)
+{
+    double demand = PLANT_LEDS * QUIESCENT_MA + PLANT_LEDS * 3 * ma_per_channel * content * scale / 256.0;
+    double full = PLANT_LEDS * (QUIESCENT_MA + 3 * 20.0);
+
+    return demand * (1.0 - SAG_FULL * demand / full);
+}
+
+static double noise(void)
+{
+    noise_state ^= noise_state << 13;
+    noise_state ^= noise_state >> 17;
+    noise_state ^= noise_state << 5;
+    return (noise_state / 4294967295.0) * 2.0 - 1.0;
+}
+
+/**
+ * @brief Reading of current @p ma: WS2812B_CURRENT_SAMPLES noisy 12-bit
+ *        samples through the shunt and the amplifier, converted by the firmware.
+ */
+static uint16_t measure(double ma)
+{
+    const double counts_per_ma = WS2812B_CURRENT_SHUNT_MOHM * WS2812B_CURRENT_GAIN * 4096.0 /
+                                 (1000.0 * WS2812B_CURRENT_VREF_MV);
+    uint32_t sum = 0;
+
+    for (int k = 0; k < WS2812B_CURRENT_SAMPLES; k++)
+    {
+        double counts = ma * (1.0 + NOISE * noise()) * counts_per_ma + WS2812B_CURRENT_OFFSET;
+        sum += (counts >= 4095.0) ? 4095U : (uint32_t)lround(counts);
+    }
+    return WS2812B_Current_CountsToMilliamps(sum);
+}
+
+static void run(const scenario_t *s)
+{
+    const double setpoint = LIMIT_MA - LIMIT_MA / 32;
+    double shown = plant_ma(s->content(0), s->ma_per_channel, 256);
+    double first = 0, overshoot = 0, sum = 0, sum2 = 0;
+    int last_out = -1, release = -1;
+
+    noise_state = 0x2545F491U;
+    WS2812B_Current_SetLimit(LIMIT_MA);
+    WS2812B_Current_Reset();
+
+    for (int f = 0; f < FRAMES; f++)
+    {
+        uint16_t reading = measure(shown);
+        uint16_t scale = WS2812B_Current_Update(reading);
+        double content = s->content(f);
+
+        shown = plant_ma(content, s->ma_per_channel, scale);
+        if (verbose) printf("  %3d content %.2f reading %5u scale %3u current %6.0f mA\n", f, content, reading, scale, shown);
+
+        if (f == s->step) first = shown;
+        if (f > s->step && shown > LIMIT_MA && (shown - LIMIT_MA) / LIMIT_MA > overshoot) overshoot = (shown - LIMIT_MA) / LIMIT_MA;
+        if (f >= s->step && fabs(shown - setpoint) > SETTLE_BAND * setpoint) last_out = f;
+        if (f > s->step && release < 0 && scale == 256) release = f - s->step;
+        if (f >= FRAMES - STEADY_FRAMES)
+        {
+            sum += shown;
+            sum2 += shown * shown;
+        }
+    }
+
+    double mean = sum / STEADY_FRAMES;
+    double ripple = sqrt(fmax(sum2 / STEADY_FRAMES - mean * mean, 0.0));
+    int settle = last_out - s->step + 1;
+    double first_pct = 100.0 * first / LIMIT_MA, steady_pct = 100.0 * mean / LIMIT_MA;
+    double ripple_pct = 100.0 * ripple / LIMIT_MA;
+
+    printf("%-24s first %5.1f%%  settle %3d  overshoot %4.1f%%  steady %5.1f%% +-%.2f%%",
+           s->name, first_pct, settle, 100.0 * overshoot, steady_pct, ripple_pct);
+    if (s->release >= 0) printf("  release %d", release);
+    printf("\n");
+
+    if (s->first_pct >= 0)
+    {
+        CHECK(fabs(first_pct - s->first_pct) <= 1.0, "%s: first frame %.1f%% of the limit, table %.1f%%",
+              s->name, first_pct, s->first_pct);
+    }
+    if (s->settle > 0) CHECK(settle <= s->settle, "%s: settles in %d frames, table %d", s->name, settle, s->settle);
+    if (s->overshoot_pct >= 0)
+    {
+        CHECK(100.0 * overshoot <= s->overshoot_pct + 0.5, "%s: overshoot %.1f%%, table %.1f%%",
+              s->name, 100.0 * overshoot, s->overshoot_pct);
+    }
+    if (s->steady_pct > 0)
+    {
+        CHECK(fabs(steady_pct - s->steady_pct) <= 0.2, "%s: steady %.1f%%, table %.1f%%", s->name, steady_pct, s->steady_pct);
+        CHECK(ripple_pct <= s->ripple_pct + 0.1, "%s: ripple %.2f%%, table %.1f%%", s->name, ripple_pct, s->ripple_pct);
+        CHECK(mean + 3 * ripple < LIMIT_MA, "%s: steady state not under the limit", s->name);
+    }
+    if (s->release >= 0) CHECK(release >= 0 && release <= s->release, "%s: back to scale 256 after %d frames, table %d",
+                               s->name, release, s->release);
+}
+
+int main(int argc, char **argv)
+{
+    verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+    printf("attack at %d%% over the limit, kp %d, ki %d (Q8)\n", WS2812B_CURRENT_ATTACK_PCT,
+           WS2812B_CURRENT_KP, WS2812B_CURRENT_KI);
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) run(&scenarios[i]);
+
+    return TEST_SUMMARY();
+}
@@ -0,0 +1,238 @@
+/**
+ * @file test_frame.c
+ * @brief Host test: framebuffer encode against golden frames at every render scale.
+ *
+ * A fixed scene of samples is drawn at render scale 1, 2, 4 and 8, scrolled,
+ * and encoded into pwmData with WS2812B_Frame_Encode(). The PWM buffer is
+ * decoded back to RGB (GRB order, MSB first) and compared with:
+ * - Golden frames: the first 16 LEDs of each scale as literal RGB values, and
+ *   an FNV-1a hash of the whole decoded strip. Any change to the encoder
+ *   output, including rounding, fails here and has to be re-approved by
+ *   updating the table (run with -p to print it).
+ * - An independent model of the upscale: LED p lies between samples
+ *   p / scale and p / scale + 1, weighted by its distance, rounded down; the
+ *   last samples repeat instead of extrapolating.
+ * - WS2812B_Shader_Frame(), the streaming path, LED by LED.
+ * The scale 2 frame is also checked at half output scale (current limiter).
+ * Finally, with a mirror mode set, WS2812B_Frame_Show() must send the frame
+ * as encoded: only the effects that render WS2812B_RenderLength() LEDs mirror.
+ *
+ * The golden values are for LED_NUM=60.
+ *
+ * Build and run (from Color_Convert/; host/Makefile builds every host program):
+ * @code
+ * make -C host build/test_frame && host/build/test_frame [-p]
+ * @endcode
+ */
+
+#include "WS2812B_Frame.h"
+#include "test_common.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#if LED_NUM != 60
+#error "The golden frames are for LED_NUM=60"
+#endif
+
+#define SCROLL          3       ///< Samples scrolled before encoding
+#define GOLDEN_LEDS     16
+
+static ws2812b_pwm_t bit1_pulse;    ///< pwmData value of a 1 bit
+
+/**
+ * @brief Golden output of one render scale.
+ */
+typedef struct {
+    uint8_t scale;
+    uint16_t output_scale;
+    uint32_t hash;                      ///< FNV-1a of all LED_NUM decoded RGB triplets
+    uint8_t rgb[GOLDEN_LEDS][3];        ///< First LEDs, decoded
+} golden_t;
+
+static const golden_t golden[] = {
+    { 1, 256, 0xE386DCF5U, {
+        { 201, 254, 0 }, { 218, 245, 100 }, { 235, 236, 200 }, { 0, 255, 0 },
+        { 17, 246, 100 }, { 34, 237, 200 }, { 51, 228, 0 }, { 68, 219, 100 },
+        { 85, 210, 200 }, { 102, 201, 0 }, { 119, 192, 100 }, { 136, 183, 200 },
+        { 153, 174, 0 }, { 170, 165, 100 }, { 187, 156, 200 }, { 204, 147, 0 } } },
+    { 2, 256, 0x7F83FAF0U, {
+        { 220, 3, 100 }, { 228, 126, 150 }, { 237, 250, 200 }, { 245, 245, 100 },
+        { 254, 241, 0 }, { 127, 248, 0 }, { 0, 255, 0 }, { 8, 250, 50 },
+        { 17, 246, 100 }, { 25, 241, 150 }, { 34, 237, 200 }, { 42, 232, 100 },
+        { 51, 228, 0 }, { 59, 223, 50 }, { 68, 219, 100 }, { 76, 214, 150 } } },
+    { 4, 256, 0x6BE9587AU, {
+        { 221, 138, 100 }, { 225, 135, 125 }, { 229, 133, 150 }, { 233, 131, 175 },
+        { 238, 129, 200 }, { 242, 126, 150 }, { 246, 124, 100 }, { 250, 122, 50 },
+        { 255, 120, 0 }, { 191, 153, 0 }, { 127, 187, 0 }, { 63, 221, 0 },
+        { 0, 255, 0 }, { 4, 252, 25 }, { 8, 250, 50 }, { 12, 248, 75 } } },
+    { 8, 256, 0x12FDF6A6U, {
+        { 102, 201, 0 }, { 104, 199, 12 }, { 106, 198, 25 }, { 108, 197, 37 },
+        { 110, 196, 50 }, { 112, 195, 62 }, { 114, 194, 75 }, { 116, 193, 87 },
+        { 119, 192, 100 }, { 121, 190, 112 }, { 123, 189, 125 }, { 125, 188, 137 },
+        { 127, 187, 150 }, { 129, 186, 162 }, { 131, 185, 175 }, { 133, 184, 187 } } },
+    { 2, 128, 0x7DD9BEC4U, {
+        { 110, 1, 50 }, { 114, 63, 75 }, { 118, 125, 100 }, { 122, 122, 50 },
+        { 127, 120, 0 }, { 63, 124, 0 }, { 0, 127, 0 }, { 4, 125, 25 },
+        { 8, 123, 50 }, { 12, 120, 75 }, { 17, 118, 100 }, { 21, 116, 50 },
+        { 25, 114, 0 }, { 29, 111, 25 }, { 34, 109, 50 }, { 38, 107, 75 } } },
+};
+
+/**
+ * @brief Scene sample @p k: a red ramp, a green ramp down and a blue 3-step pattern.
+ */
+static void scene(uint32_t k, uint8_t rgb[3])
+{
+    rgb[0] = (uint8_t)(k * 17U);
+    rgb[1] = (uint8_t)(255U - k * 9U);
+    rgb[2] = (uint8_t)((k % 3U) * 100U);
+}
+
+static uint32_t fnv1a(const uint8_t *data, uint32_t len)
+{
+    uint32_t h = 2166136261U;
+    while (len--) h = (h ^ *data++) * 16777619U;
+    return h;
+}
+
+/**
+ * @brief Decode pwmData back to RGB.
+ */
+static void decode(uint8_t rgb[LED_NUM][3])
+{
+    for (int p = 0; p < LED_NUM; p++)
+    {
+        uint32_t grb = 0;
+        for (int i = 0; i < 24; i++) grb = (grb << 1) | (pwmData[p * 24 + i] == bit1_pulse);
+        rgb[p][0] = (uint8_t)(grb >> 8);
+        rgb[p][1] = (uint8_t)(grb >> 16);
+        rgb[p][2] = (uint8_t)grb;
+    }
+}
+
+/**
+ * @brief Model: LED @p p at render scale @p scale with @p len samples, scrolled by SCROLL.
+ */
+static void model(uint32_t p, uint32_t scale, uint32_t len, uint16_t output_scale, uint8_t rgb[3])
+{
+    uint32_t k = p / scale, j = p % scale;
+    uint8_t a[3], b[3];
+
+    scene((k + len - SCROLL) % len, a);
+    scene((k + 1 < len) ? (k + 1 + len - SCROLL) % len : (k + len - SCROLL) % len, b);
+    for (int c = 0; c < 3; c++)
+    {
+        uint32_t v = (a[c] * (scale - j) + b[c] * j) / scale;
+        rgb[c] = (uint8_t)((output_scale < 256) ? (v * output_scale) >> 8 : v);
+    }
+}
+
+static void check_scale(const golden_t *g, bool print)
+{
+    uint8_t out[LED_NUM][3];
+    uint32_t model_bad = 0, shader_bad = 0;
+
+    WS2812B_Frame_SetScale(g->scale);
+    uint16_t len = WS2812B_Frame_Length();
+    for (uint16_t k = 0; k < len; k++)
+    {
+        uint8_t rgb[3];
+        scene(k, rgb);
+        WS2812B_Frame_SetPixelRGB(k, rgb[0], rgb[1], rgb[2]);
+    }
+    WS2812B_Frame_Scroll(SCROLL);
+    WS2812B_SetOutputScale(g->output_scale);
+    memset(pwmData, 0, sizeof(pwmData));
+    WS2812B_Frame_Encode();
+    decode(out);
+
+    for (uint16_t p = 0; p < LED_NUM; p++)
+    {
+        uint8_t want[3], shader[3];
+
+        model(p, g->scale, len, g->output_scale, want);
+        if (memcmp(out[p], want, 3) != 0 && model_bad++ == 0)
+        {
+            printf("scale %u: LED %u is %u,%u,%u, model %u,%u,%u\n", g->scale, p,
+                   out[p][0], out[p][1], out[p][2], want[0], want[1], want[2]);
+        }
+
+        WS2812B_Shader_Frame(p, 0, NULL, &shader[0], &shader[1], &shader[2]);
+        if (g->output_scale < 256)
+        {
+            for (int c = 0; c < 3; c++) shader[c] = (uint8_t)((shader[c] * g->output_scale) >> 8);
+        }
+        if (memcmp(out[p], shader, 3) != 0) shader_bad++;
+    }
+
+    uint32_t hash = fnv1a(&out[0][0], sizeof(out));
+    bool golden_ok = (hash == g->hash) && memcmp(out, g->rgb, sizeof(g->rgb)) == 0;
+
+    printf("scale %u, output %3u/256: %2u samples, hash %08X, golden %s, model mismatches %u, shader mismatches %u\n",
+           g->scale, g->output_scale, len, (unsigned)hash, golden_ok ? "ok" : "DIFFERS", model_bad, shader_bad);
+    if (print)
+    {
+        printf("    { %u, %u, 0x%08XU, {", g->scale, g->output_scale, (unsigned)hash);
+        for (int p = 0; p < GOLDEN_LEDS; p++)
+        {
+            printf("%s{ %u, %u, %u }", (p == 0) ? "\n        " : (p % 4) ? ", " : ",\n        ",
+                   out[p][0], out[p][1], out[p][2]);
+        }
+        printf(" } },\n");
+    }
+
+    CHECK(golden_ok, "scale %u, output %u: differs from the golden frame", g->scale, g->output_scale);
+    CHECK(model_bad == 0, "scale %u: %u LEDs off the model", g->scale, model_bad);
+    CHECK(shader_bad == 0, "scale %u: %u LEDs differ from WS2812B_Shader_Frame", g->scale, shader_bad);
+    CHECK(len == (LED_NUM - 1 + g->scale - 1) / g->scale + 1, "scale %u: %u samples", g->scale, len);
+}
+
+/**
+ * @brief The framebuffer path sends all LED_NUM LEDs as they are, whatever the mirror mode.
+ */
+static void check_mirror(void)
+{
+    uint8_t encoded[LED_NUM][3], sent[LED_NUM][3], mirrored[LED_NUM][3];
+    uint32_t bad = 0;
+
+    for (uint16_t k = 0; k < LED_NUM; k++)
+    {
+        uint8_t rgb[3];
+        scene(k, rgb);
+        WS2812B_Frame_SetPixelRGB(k, rgb[0], rgb[1], rgb[2]);
+    }
+    WS2812B_SetMirror(WS2812B_MIRROR_2);
+    WS2812B_Frame_Encode();
+    decode(encoded);
+    WS2812B_Frame_Show();
+    decode(sent);
+    WS2812B_ApplyMirror();
+    decode(mirrored);
+    WS2812B_SetMirror(WS2812B_MIRROR_NONE);
+
+    for (int p = 0; p < LED_NUM; p++)
+    {
+        if (memcmp(mirrored[p], mirrored[LED_NUM - 1 - p], 3) != 0) bad++;
+    }
+    printf("mirror 2: frame %s by WS2812B_Frame_Show(), %u LEDs off the mirror by WS2812B_ApplyMirror()\n",
+           memcmp(encoded, sent, sizeof(sent)) ? "CHANGED" : "kept", bad);
+    CHECK(memcmp(encoded, sent, sizeof(sent)) == 0, "mirror 2: WS2812B_Frame_Show() mirrored the frame");
+    CHECK(bad == 0, "mirror 2: %u LEDs not mirrored", bad);
+}
+
+int main(int argc, char **argv)
+{
+    bool print = (argc > 1 && strcmp(argv[1], "-p") == 0);
+
+    ws2812b_pwm_t white[24];
+
+    WS2812B_InitTiming();
+    WS2812B_EncodeRGB(white, 255, 255, 255);
+    bit1_pulse = white[0];
+    for (size_t i = 0; i < sizeof(golden) / sizeof(golden[0]); i++) check_scale(&golden[i], print);
+    WS2812B_SetOutputScale(256);
+    WS2812B_Frame_SetScale(1);
+    check_mirror();
+
+    return TEST_SUMMARY();
+}
@@ -0,0 +1,126 @@
+/**
+ * @file test_hsv16.c
+ * @brief Host test: WS2812B_HSV16ToRGB() against a double-precision HSV, exhaustively.
+ *
+ * Every input is converted: 65536 hues x 101 saturations x 101 values. The
+ * reference is the textbook HSV with H = hue16 x 360 / 65536, S and V in
+ * percent, scaled to 0–255 without rounding. Checked:
+ * - Largest channel error below 1.4 and mean error below 0.29 (the figures
+ *   quoted in WS2812B.c).
+ * - No channel more than 1 away from the rounded reference.
+ * - Adjacent hue codes (including 65535 -> 0) differ by at most 1 per
+ *   channel, so a slow rotation never jumps.
+ * The old whole-degree hsv_to_rgb() is timed next to it for reference.
+ *
+ * Build and run (from Color_Convert/; host/Makefile builds every host program):
+ * @code
+ * make -C host build/test_hsv16 && host/build/test_hsv16
+ * @endcode
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "WS2812B.h"
+#include "test_common.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_ERROR       1.4     ///< Largest allowed |channel - reference|
+#define MEAN_ERROR      0.29    ///< Largest allowed mean |channel - reference|
+#define TIMING_RUNS     2000000
+
+/**
+ * @brief Reference HSV to RGB in double precision, channels 0–255 unrounded.
+ */
+static void reference(uint16_t hue16, uint8_t sat, uint8_t val, double rgb[3])
+{
+    double h = hue16 * 6.0 / 65536.0;   // Sector position, 0–6
+    double v = val * 2.55;
+    double c = v * sat / 100.0;
+    double x = c * (1.0 - fabs(fmod(h, 2.0) - 1.0));
+    double m = v - c;
+    int sector = (int)h;
+    static const uint8_t order[6][3] = {    // Index of c (0), x (1), 0 (2) per channel
+        { 0, 1, 2 }, { 1, 0, 2 }, { 2, 0, 1 }, { 2, 1, 0 }, { 1, 2, 0 }, { 0, 2, 1 },
+    };
+    const double part[3] = { c, x, 0.0 };
+
+    for (int ch = 0; ch < 3; ch++) rgb[ch] = part[order[sector][ch]] + m;
+}
+
+static double seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Nanoseconds per conversion of WS2812B_HSV16ToRGB() (hsv16 != 0) or WS2812B_HSVToRGB().
+ */
+static double time_conversion(int hsv16)
+{
+    volatile uint8_t sink = 0;
+    uint8_t r, g, b;
+    double start = seconds();
+
+    for (uint32_t i = 0; i < TIMING_RUNS; i++)
+    {
+        if (hsv16) WS2812B_HSV16ToRGB((uint16_t)(i * 40503U), (uint8_t)(i % 101U), (uint8_t)(100U - i % 101U), &r, &g, &b);
+        else WS2812B_HSVToRGB((uint16_t)(i % 360U), (uint8_t)(i % 101U), (uint8_t)(100U - i % 101U), &r, &g, &b);
+        sink = (uint8_t)(sink + r + g + b);
+    }
+    return (seconds() - start) * 1e9 / TIMING_RUNS;
+}
+
+int main(void)
+{
+    double max_err = 0.0, sum_err = 0.0;
+    uint64_t count = 0, off_by_2 = 0, jumps = 0;
+
+    for (uint8_t sat = 0; sat <= 100; sat++)
+    {
+        for (uint8_t val = 0; val <= 100; val++)
+        {
+            uint8_t first[3], prev[3];
+
+            for (uint32_t h = 0; h < 65536U; h++)
+            {
+                uint8_t out[3];
+                double ref[3];
+
+                WS2812B_HSV16ToRGB((uint16_t)h, sat, val, &out[0], &out[1], &out[2]);
+                reference((uint16_t)h, sat, val, ref);
+                for (int ch = 0; ch < 3; ch++)
+                {
+                    double err = fabs(out[ch] - ref[ch]);
+                    if (err > max_err) max_err = err;
+                    sum_err += err;
+                    if (abs(out[ch] - (int)lround(ref[ch])) > 1) off_by_2++;
+                    if (h > 0 && abs(out[ch] - prev[ch]) > 1) jumps++;
+                    prev[ch] = out[ch];
+                    if (h == 0) first[ch] = out[ch];
+                }
+                count += 3;
+            }
+            for (int ch = 0; ch < 3; ch++)
+            {
+                if (abs(first[ch] - prev[ch]) > 1) jumps++;
+            }
+        }
+    }
+
+    double mean_err = sum_err / (double)count;
+    printf("hsv16: %llu channels, max error %.3f, mean %.3f, %llu off the rounded reference by 2+, %llu adjacent-hue jumps\n",
+           (unsigned long long)count, max_err, mean_err, (unsigned long long)off_by_2, (unsigned long long)jumps);
+    printf("cost: hsv16 %.1f ns, hsv_to_rgb %.1f ns per conversion on this host\n", time_conversion(1), time_conversion(0));
+
+    CHECK(max_err < MAX_ERROR, "max error %.3f, limit %.2f", max_err, MAX_ERROR);
+    CHECK(mean_err < MEAN_ERROR, "mean error %.3f, limit %.2f", mean_err, MEAN_ERROR);
+    CHECK(off_by_2 == 0, "%llu channels off the rounded reference by 2 or more", (unsigned long long)off_by_2);
+    CHECK(jumps == 0, "%llu channels jump by more than 1 between adjacent hues", (unsigned long long)jumps);
+
+    return TEST_SUMMARY();
+}
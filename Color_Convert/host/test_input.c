@@ -0,0 +1,247 @@
+/**
+ * @file test_input.c
+ * @brief Host simulation: bouncy button and encoder contacts through the WS2812B_Input core.
+ *
+ * Runs the pin-independent core the way the firmware does: every level
+ * change of a simulated contact calls the EXTI entry point
+ * (WS2812B_Input_ButtonEdge() / WS2812B_Input_EncoderEdge()), and
+ * WS2812B_Input_Tick() runs once per simulated millisecond with the raw
+ * button level at that instant. Time advances in 50 us steps, so bounce
+ * pulses shorter than one tick are modeled. After each tick the commands are
+ * applied with WS2812B_Control_Apply() and counted:
+ * - Short presses: bounce on both edges (up to 10 ms of chatter, pulses of
+ *   50 us to 2 ms) must give exactly one CMD_NEXT_EFFECT per press, and the
+ *   event must follow the last release edge by at most the debounce time
+ *   plus one tick.
+ * - Long presses: exactly one CMD_POWER per press, no CMD_NEXT_EFFECT.
+ * - Glitches: sub-millisecond spikes on a released button give no event.
+ * - Encoder: every transition chatters on the changing line before it
+ *   settles; each full detent must give exactly one brightness step in the
+ *   right direction, and half a detent turned back must give none.
+ *
+ * Build and run (from Color_Convert/; host/Makefile builds every host program):
+ * @code
+ * make -C host build/test_input && host/build/test_input [seed]
+ * @endcode
+ */
+
+#include "WS2812B_Input.h"
+#include "WS2812B_Control.h"
+#include "test_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define STEP_US         50
+#define MAX_BOUNCE_US   10000
+#define BRIGHTNESS_MID  50
+
+/**
+ * @brief Simulated board: contact levels, time, and what the render loop saw.
+ */
+typedef struct {
+    uint64_t now_us;
+    bool pressed;               ///< Raw button level
+    uint8_t ab;                 ///< Raw encoder levels
+    uint64_t last_release_us;   ///< Last release edge of the current press
+    // Counted commands
+    uint32_t next_effect;
+    uint32_t power;
+    int32_t detents;
+    uint32_t max_latency_us;    ///< Last release edge -> CMD_NEXT_EFFECT
+} sim_t;
+
+static sim_t sim;
+static ws2812b_effects_t fx;
+static bool output_on = true;
+
+static uint32_t rand_range(uint32_t lo, uint32_t hi)
+{
+    return lo + (uint32_t)rand() % (hi - lo + 1U);
+}
+
+/**
+ * @brief Apply the queued commands and count them (one tick's worth).
+ */
+static void observe(void)
+{
+    ws2812b_effect_t before = fx.current_effect;
+
+    WS2812B_SetBrightness(BRIGHTNESS_MID);
+    bool on = WS2812B_Control_Apply(&fx);
+
+    if (fx.current_effect != before)
+    {
+        uint32_t latency = (uint32_t)(sim.now_us - sim.last_release_us);
+        if (latency > sim.max_latency_us) sim.max_latency_us = latency;
+        sim.next_effect++;
+    }
+    if (on != output_on)
+    {
+        output_on = on;
+        sim.power++;
+    }
+    sim.detents += ((int32_t)WS2812B_GetBrightness() - BRIGHTNESS_MID) / WS2812B_INPUT_BRIGHTNESS_STEP;
+}
+
+/**
+ * @brief Let time pass; SysTick runs on every whole millisecond.
+ */
+static void advance(uint32_t us)
+{
+    for (uint64_t end = sim.now_us + us; sim.now_us < end; sim.now_us += STEP_US)
+    {
+        if (sim.now_us % 1000U == 0)
+        {
+            WS2812B_Input_Tick((uint32_t)(sim.now_us / 1000U), sim.pressed);
+            observe();
+        }
+    }
+}
+
+static void set_button(bool pressed)
+{
+    if (pressed == sim.pressed) return;
+    sim.pressed = pressed;
+    if (!pressed) sim.last_release_us = sim.now_us;
+    WS2812B_Input_ButtonEdge((uint32_t)(sim.now_us / 1000U));
+}
+
+/**
+ * @brief Move the button to @p level through up to MAX_BOUNCE_US of chatter.
+ */
+static void bounce_button(bool level)
+{
+    uint32_t bounce_end = rand_range(0, MAX_BOUNCE_US);
+    uint32_t t = 0;
+
+    while (t < bounce_end)
+    {
+        uint32_t pulse = rand_range(STEP_US, 2000);
+        set_button(level);
+        advance(pulse);
+        set_button(!level);
+        advance(STEP_US * rand_range(1, 10));
+        t += pulse;
+    }
+    set_button(level);
+}
+
+static void set_encoder(uint8_t ab)
+{
+    if (ab == sim.ab) return;
+    sim.ab = ab;
+    WS2812B_Input_EncoderEdge(ab);
+}
+
+/**
+ * @brief One quadrature transition: the changing line chatters, then settles.
+ */
+static void encoder_step(uint8_t to)
+{
+    uint8_t from = sim.ab;
+    for (uint32_t n = rand_range(0, 6); n > 0; n--)
+    {
+        set_encoder(to);
+        advance(STEP_US * rand_range(1, 4));
+        set_encoder(from);
+        advance(STEP_US * rand_range(1, 4));
+    }
+    set_encoder(to);
+    advance(rand_range(500, 3000));
+}
+
+/**
+ * @brief Turn by whole detents (positive = clockwise: 11 -> 10 -> 00 -> 01 -> 11).
+ */
+static void encoder_turn(int32_t detents)
+{
+    static const uint8_t cw[4] = { 2, 0, 1, 3 };
+    static const uint8_t ccw[4] = { 1, 0, 2, 3 };
+    const uint8_t *seq = (detents > 0) ? cw : ccw;
+
+    for (int32_t d = (detents > 0) ? detents : -detents; d > 0; d--)
+    {
+        for (int i = 0; i < 4; i++) encoder_step(seq[i]);
+    }
+}
+
+static void reset(void)
+{
+    sim = (sim_t){ .now_us = sim.now_us, .ab = 3 };
+    advance(100000);    // Let anything pending drain
+    sim = (sim_t){ .now_us = sim.now_us, .ab = 3 };
+}
+
+int main(int argc, char **argv)
+{
+    unsigned seed = (argc > 1) ? (unsigned)strtoul(argv[1], NULL, 10) : 1U;
+    const uint32_t latency_bound = (WS2812B_INPUT_DEBOUNCE_MS + 1U) * 1000U;
+
+    srand(seed);
+    WS2812B_Input_Init();   // Registers the input queue; host pins idle high (released, AB = 11)
+    sim.ab = 3;
+    advance(1000);
+
+    // Short presses
+    reset();
+    for (int i = 0; i < 200; i++)
+    {
+        bounce_button(true);
+        advance(rand_range(80, 400) * 1000U);
+        bounce_button(false);
+        advance(rand_range(60, 300) * 1000U);
+    }
+    printf("short presses: 200 -> next effect %u, power %u, worst latency after the last release edge %.1f ms\n",
+           sim.next_effect, sim.power, sim.max_latency_us / 1000.0);
+    CHECK(sim.next_effect == 200 && sim.power == 0, "short presses");
+    CHECK(sim.max_latency_us <= latency_bound, "latency %u us > %u us", sim.max_latency_us, latency_bound);
+
+    // Long presses
+    reset();
+    for (int i = 0; i < 50; i++)
+    {
+        bounce_button(true);
+        advance(rand_range(WS2812B_INPUT_LONG_PRESS_MS + MAX_BOUNCE_US / 1000U + 30U, 2500) * 1000U);
+        bounce_button(false);
+        advance(rand_range(60, 300) * 1000U);
+    }
+    printf("long presses:  50 -> next effect %u, power %u\n", sim.next_effect, sim.power);
+    CHECK(sim.power == 50 && sim.next_effect == 0, "long presses");
+
+    // Glitches on a released button
+    reset();
+    for (int i = 0; i < 500; i++)
+    {
+        set_button(true);
+        advance(STEP_US * rand_range(1, 19));
+        set_button(false);
+        advance(rand_range(5, 100) * 1000U);
+    }
+    printf("glitches:      500 -> next effect %u, power %u\n", sim.next_effect, sim.power);
+    CHECK(sim.next_effect == 0 && sim.power == 0, "glitches");
+
+    // Encoder
+    reset();
+    uint32_t turned = 0, wrong = 0;
+    for (int i = 0; i < 200; i++)
+    {
+        int32_t d = (int32_t)rand_range(1, 5) * ((rand() & 1) ? 1 : -1);
+        int32_t before = sim.detents;
+
+        encoder_turn(d);
+        // Half a detent and back
+        encoder_step(2);
+        encoder_step(0);
+        encoder_step(2);
+        encoder_step(3);
+        advance(2000);
+
+        turned += (uint32_t)((d > 0) ? d : -d);
+        if (sim.detents - before != d) wrong++;
+    }
+    printf("encoder:       200 turns, %u detents -> %u turns with a wrong step count\n", turned, wrong);
+    CHECK(wrong == 0, "encoder");
+
+    printf("seed %u\n", seed);
+    return TEST_SUMMARY();
+}
@@ -0,0 +1,194 @@
+/**
+ * @file test_schedule.c
+ * @brief Host test: WS2812B_Schedule over accelerated days.
+ *
+ * Calls WS2812B_Schedule_Evaluate() once per simulated second, exactly as the
+ * RTC second interrupt does, for three days back to back (259200 calls, well
+ * under a second). Every command the schedule posts is popped from its queue,
+ * counted, and executed with WS2812B_Control_Execute(), so preset recalls
+ * really change the engine state. The table is the one in src/main.c.
+ *
+ * Checked against an independent model of the table:
+ * - Preset recalls happen once per day, at 07:00:00 and 19:00:00 only.
+ * - The applied brightness follows the ramps (5 -> 80 % over 15 min from
+ *   07:00, 80 -> 40 % over 30 min from 19:00, 40 -> 5 % over 60 min from
+ *   23:00) within 1 %, including right after a recall, and holds between.
+ * - One CMD_SET_BRIGHTNESS per 1 % step, identical days.
+ * - Boot (or reset) at any time resumes the right scene and ramp position
+ *   on the first evaluation; a clock set backwards does the same.
+ *
+ * Build and run (from Color_Convert/; host/Makefile builds every host program):
+ * @code
+ * make -C host build/test_schedule && host/build/test_schedule
+ * @endcode
+ */
+
+#include "WS2812B_Schedule.h"
+#include "WS2812B_Control.h"
+#include "test_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DAYS    3
+
+// Same table as src/main.c
+static const ws2812b_schedule_entry_t led_schedule[] = {
+    { WS2812B_SCHEDULE_TIME(7, 0),  0,                     80, 15 * 60 },
+    { WS2812B_SCHEDULE_TIME(19, 0), 2,                     40, 30 * 60 },
+    { WS2812B_SCHEDULE_TIME(23, 0), WS2812B_SCHEDULE_KEEP, 5,  60 * 60 },
+};
+
+static ws2812b_effects_t fx;
+
+typedef struct {
+    uint32_t recalls;
+    uint32_t brightness_cmds;
+    uint32_t recall_time[4];
+    uint8_t recall_preset[4];
+} day_stats_t;
+
+/**
+ * @brief Brightness the table asks for at @p t, from the ramp definitions.
+ */
+static double model_brightness(uint32_t t)
+{
+    const double h = 3600.0;
+    double s = (double)(t % WS2812B_SCHEDULE_DAY);
+
+    if (s < 7 * h) return 5;
+    if (s < 7 * h + 900) return 5 + 75 * (s - 7 * h) / 900;
+    if (s < 19 * h) return 80;
+    if (s < 19 * h + 1800) return 80 - 40 * (s - 19 * h) / 1800;
+    if (s < 23 * h) return 40;
+    return 40 - 35 * (s - 23 * h) / 3600;
+}
+
+/**
+ * @brief Scene the table asks for at @p t (last preset recalled).
+ * @param ran_evening The schedule was running at some 19:00-23:00 since boot
+ * @return Preset index, or -1 if nothing was recalled: the 23:00 entry keeps
+ *         the scene, so from a boot between 23:00 and 07:00 nothing is recalled.
+ */
+static int model_preset(uint32_t t, bool ran_evening)
+{
+    uint32_t s = t % WS2812B_SCHEDULE_DAY;
+
+    if (s >= WS2812B_SCHEDULE_TIME(7, 0) && s < WS2812B_SCHEDULE_TIME(19, 0)) return 0;
+    if (s >= WS2812B_SCHEDULE_TIME(19, 0) && s < WS2812B_SCHEDULE_TIME(23, 0)) return 2;
+    return ran_evening ? 2 : -1;
+}
+
+/**
+ * @brief One RTC second: evaluate, then drain and execute what was posted.
+ */
+static void rtc_second(uint32_t t, day_stats_t *stats, int *last_preset)
+{
+    ws2812b_cmd_t cmd;
+
+    WS2812B_Schedule_Evaluate(t % WS2812B_SCHEDULE_DAY);
+    while (WS2812B_CmdQueue_Pop(WS2812B_Schedule_Queue(), &cmd))
+    {
+        if (cmd.type == CMD_RECALL_PRESET)
+        {
+            if (stats != NULL && stats->recalls < 4)
+            {
+                stats->recall_time[stats->recalls] = t % WS2812B_SCHEDULE_DAY;
+                stats->recall_preset[stats->recalls] = (uint8_t)cmd.value;
+            }
+            if (stats != NULL) stats->recalls++;
+            *last_preset = cmd.value;
+        }
+        else if (cmd.type == CMD_SET_BRIGHTNESS && stats != NULL)
+        {
+            stats->brightness_cmds++;
+        }
+        WS2812B_Control_Execute(&fx, cmd.type, cmd.value);
+    }
+}
+
+static bool brightness_ok(uint32_t t)
+{
+    double d = WS2812B_GetBrightness() - model_brightness(t);
+    return d > -1.0 && d < 1.0;
+}
+
+/**
+ * @brief Boot at @p t: the first evaluation must restore the scene and ramp position.
+ */
+static void check_boot(uint32_t t)
+{
+    int preset = -1;
+
+    WS2812B_Schedule_SetTable(led_schedule, 3);
+    WS2812B_SetBrightness(100);
+    rtc_second(t, NULL, &preset);
+
+    CHECK(preset == model_preset(t, false) && brightness_ok(t),
+          "boot at %02u:%02u:%02u: preset %d, brightness %u (expected %d, %.1f)",
+          t / 3600, t / 60 % 60, t % 60, preset, WS2812B_GetBrightness(), model_preset(t, false), model_brightness(t));
+}
+
+int main(void)
+{
+    day_stats_t days[DAYS] = { { 0 } };
+    uint32_t bad_seconds = 0, first_bad = 0;
+    int preset = -1;
+
+    // Boot at midnight, run three days
+    WS2812B_Schedule_SetTable(led_schedule, 3);
+    rtc_second(0, NULL, &preset);
+    for (uint32_t t = 1; t < DAYS * WS2812B_SCHEDULE_DAY; t++)
+    {
+        rtc_second(t, &days[t / WS2812B_SCHEDULE_DAY], &preset);
+        if (!brightness_ok(t) || preset != model_preset(t, t >= WS2812B_SCHEDULE_TIME(19, 0)))
+        {
+            if (bad_seconds++ == 0) first_bad = t;
+        }
+    }
+
+    for (int d = 0; d < DAYS; d++)
+    {
+        printf("day %d: %u recalls (", d + 1, days[d].recalls);
+        for (uint32_t i = 0; i < days[d].recalls && i < 4; i++)
+        {
+            printf("%s%02u:%02u:%02u preset %u", i ? ", " : "", days[d].recall_time[i] / 3600,
+                   days[d].recall_time[i] / 60 % 60, days[d].recall_time[i] % 60, days[d].recall_preset[i]);
+        }
+        printf("), %u brightness commands\n", days[d].brightness_cmds);
+    }
+    printf("brightness/scene off the model: %u of %u seconds\n", bad_seconds,
+           (unsigned)(DAYS * WS2812B_SCHEDULE_DAY - 1U));
+
+    for (int d = 0; d < DAYS; d++)
+    {
+        CHECK(days[d].recalls == 2 && days[d].recall_time[0] == WS2812B_SCHEDULE_TIME(7, 0) &&
+              days[d].recall_preset[0] == 0 && days[d].recall_time[1] == WS2812B_SCHEDULE_TIME(19, 0) &&
+              days[d].recall_preset[1] == 2, "day %d recalls", d + 1);
+        // 5 -> 80 -> 40 -> 5: one command per 1 % step, plus the re-apply after each recall
+        CHECK(days[d].brightness_cmds <= 75 + 40 + 35 + 2 && days[d].brightness_cmds >= 75 + 40 + 35,
+              "day %d: %u brightness commands", d + 1, days[d].brightness_cmds);
+    }
+    CHECK(bad_seconds == 0, "off the model from %02u:%02u:%02u (day %u)",
+          (unsigned)(first_bad % WS2812B_SCHEDULE_DAY / 3600), first_bad / 60 % 60, first_bad % 60,
+          (unsigned)(first_bad / WS2812B_SCHEDULE_DAY + 1U));
+
+    // Boot / reset at arbitrary times, including mid-ramp and before the first entry
+    static const uint32_t boots[] = {
+        0, WS2812B_SCHEDULE_TIME(6, 59), WS2812B_SCHEDULE_TIME(7, 0), WS2812B_SCHEDULE_TIME(7, 5),
+        WS2812B_SCHEDULE_TIME(12, 0), WS2812B_SCHEDULE_TIME(19, 10), WS2812B_SCHEDULE_TIME(23, 30),
+        WS2812B_SCHEDULE_DAY - 1U,
+    };
+    for (size_t i = 0; i < sizeof(boots) / sizeof(boots[0]); i++) check_boot(boots[i]);
+
+    // Clock set backwards from 20:00 to 06:00: yesterday's 23:00 entry is active again
+    WS2812B_Schedule_SetTable(led_schedule, 3);
+    preset = -1;
+    rtc_second(WS2812B_SCHEDULE_TIME(20, 0), NULL, &preset);
+    rtc_second(WS2812B_SCHEDULE_TIME(6, 0), NULL, &preset);
+    CHECK(WS2812B_GetBrightness() == 5 && preset == 2, "clock set back: brightness %u, preset %d",
+          WS2812B_GetBrightness(), preset);
+    printf("boots at %u times of day and a clock set backwards resume the scene and ramp\n",
+           (unsigned)(sizeof(boots) / sizeof(boots[0])));
+
+    return TEST_SUMMARY();
+}
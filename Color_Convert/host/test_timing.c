@@ -0,0 +1,118 @@
+/**
+ * @file test_timing.c
+ * @brief Host test: WS2812B bit timings on both clock trees the firmware can boot on.
+ *
+ * SystemClock_Config() runs from HSE (72 MHz) or, when the crystal does not
+ * start, from HSI (64 MHz); APB1 is SYSCLK/2 on both, so TIM3 runs at SYSCLK.
+ * For each path the test sets the host RCC to that clock, runs
+ * WS2812B_InitTiming() as main.c does, and checks the TIM3 period and the
+ * encoded pulse widths against the WS2812B datasheet windows (T0H 400 ns,
+ * T1H 800 ns, T0L 850 ns, T1L 450 ns, each +-150 ns; bit 1.25 us +-600 ns).
+ * It then sweeps WS2812B_ComputeTiming() over every timer clock from 16 to
+ * 72 MHz, and checks that WS2812B_EncodeRGB() writes GRB, MSB first, with
+ * the pulses of the active clock, and that every pulse fits the byte-wide
+ * pwmData slots the TIM3 DMA is switched to.
+ *
+ * Build and run (from Color_Convert/; host/Makefile builds every host program):
+ * @code
+ * make -C host build/test_timing && host/build/test_timing
+ * @endcode
+ */
+
+#include "ws2812b_host.h"
+#include "WS2812B.h"
+#include "test_common.h"
+#include <stdio.h>
+
+#define WINDOW_NS   150     ///< Per-phase tolerance
+#define BIT_NS      1250
+#define BIT_WINDOW  600
+
+static double ticks_ns(uint32_t ticks, uint32_t timer_hz)
+{
+    return ticks * 1e9 / timer_hz;
+}
+
+/**
+ * @brief Check one set of timings against the datasheet windows.
+ * @return Worst deviation from the nominal values, ns.
+ */
+static double check_timing(const char *name, uint32_t timer_hz, const ws2812b_timing_t *t)
+{
+    // Bit period is ARR + 1 ticks; the pulse is high for CCR ticks
+    const double bit = ticks_ns(t->period + 1U, timer_hz);
+    const double t0h = ticks_ns(t->t0h, timer_hz), t1h = ticks_ns(t->t1h, timer_hz);
+    const double t0l = bit - t0h, t1l = bit - t1h;
+    const double dev[] = { t0h - 400, t1h - 800, t0l - 850, t1l - 450 };
+    double worst = 0;
+
+    CHECK(bit > BIT_NS - BIT_WINDOW && bit < BIT_NS + BIT_WINDOW, "%s: bit %.1f ns", name, bit);
+    for (unsigned i = 0; i < sizeof(dev) / sizeof(dev[0]); i++)
+    {
+        double d = dev[i] < 0 ? -dev[i] : dev[i];
+        if (d > worst) worst = d;
+    }
+    CHECK(worst <= WINDOW_NS, "%s: T0H %.1f T1H %.1f T0L %.1f T1L %.1f ns", name, t0h, t1h, t0l, t1l);
+    return worst;
+}
+
+/**
+ * @brief Boot one clock path the way main.c does and check the applied timings.
+ */
+static void check_clock_path(clock_path_t path, uint32_t sysclk, uint16_t expected_period)
+{
+    const char *name = (path == CLOCK_PATH_HSE_72MHZ) ? "HSE 72 MHz" : "HSI 64 MHz";
+    ws2812b_timing_t t;
+    ws2812b_pwm_t pwm[24];
+
+    system_clock_path = path;
+    WS2812B_Host_SetSysClock(sysclk);
+    hdma_tim3_ch1_trig.Init.MemDataAlignment = ~0U;
+    WS2812B_InitTiming();
+    CHECK(hdma_tim3_ch1_trig.Init.MemDataAlignment == DMA_MDATAALIGN_BYTE &&
+          hdma_tim3_ch1_trig.Init.PeriphDataAlignment == DMA_PDATAALIGN_HALFWORD,
+          "%s: TIM3 DMA not reading bytes into CCR1", name);
+
+    CHECK(htim3.Init.Period == expected_period, "%s: period %u, expected %u", name,
+          (unsigned)htim3.Init.Period, expected_period);
+    CHECK(htim3.Instance->ARR == expected_period, "%s: ARR %u not applied", name, (unsigned)htim3.Instance->ARR);
+
+    WS2812B_ComputeTiming(sysclk, &t);
+    double worst = check_timing(name, sysclk, &t);
+
+    // G = 0xA5, R = 0x3C, B = 0x81, sent G7..G0 R7..R0 B7..B0
+    const uint32_t grb = 0xA53C81U;
+    WS2812B_EncodeRGB(pwm, 0x3C, 0xA5, 0x81);
+    for (int i = 0; i < 24; i++)
+    {
+        uint16_t want = (grb & (1U << (23 - i))) ? t.t1h : t.t0h;
+        CHECK(pwm[i] == want, "%s: bit %d pulse %u, expected %u", name, i, pwm[i], want);
+    }
+
+    printf("%-10s: TIM3 period %u, T0H %u / T1H %u ticks = %.1f / %.1f ns, bit %.1f ns, worst deviation %.1f ns\n",
+           name, t.period, t.t0h, t.t1h, ticks_ns(t.t0h, sysclk), ticks_ns(t.t1h, sysclk),
+           ticks_ns(t.period + 1U, sysclk), worst);
+}
+
+int main(void)
+{
+    check_clock_path(CLOCK_PATH_HSE_72MHZ, 72000000U, 90);
+    check_clock_path(CLOCK_PATH_HSI_64MHZ, 64000000U, 80);
+
+    double worst = 0;
+    uint32_t worst_hz = 0;
+    for (uint32_t hz = 16000000U; hz <= 72000000U; hz += 1000000U)
+    {
+        ws2812b_timing_t t;
+        char name[16];
+
+        snprintf(name, sizeof(name), "%u MHz", (unsigned)(hz / 1000000U));
+        WS2812B_ComputeTiming(hz, &t);
+        CHECK(t.t1h == (ws2812b_pwm_t)t.t1h, "%s: T1H %u does not fit a pwmData slot", name, t.t1h);
+        double d = check_timing(name, hz, &t);
+        if (d > worst) { worst = d; worst_hz = hz; }
+    }
+    printf("sweep     : 16-72 MHz, worst deviation %.1f ns at %u MHz\n", worst, (unsigned)(worst_hz / 1000000U));
+
+    return TEST_SUMMARY();
+}
@@ -0,0 +1,313 @@
+/**
+ * @file ws2812b_host.c
+ * @brief Serial device setup, packet transmission and frame pacing for the host client.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "ws2812b_host.h"
+#include "WS2812B_Protocol.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/** @brief Largest packet the firmware accepts. */
+#define HOST_PACKET_MAX     (WS2812B_PROTOCOL_MAX_PAYLOAD + WS2812B_PROTOCOL_OVERHEAD)
+
+/**
+ * @brief Map a baud rate to its termios constant.
+ * @return B0 if the rate is not supported.
+ */
+static speed_t host_speed(uint32_t baud)
+{
+    switch (baud)
+    {
+        case 9600:    return B9600;
+        case 19200:   return B19200;
+        case 38400:   return B38400;
+        case 57600:   return B57600;
+        case 115200:  return B115200;
+        case 230400:  return B230400;
+#ifdef B460800
+        case 460800:  return B460800;
+#endif
+#ifdef B921600
+        case 921600:  return B921600;
+#endif
+#ifdef B1000000
+        case 1000000: return B1000000;
+#endif
+#ifdef B2000000
+        case 2000000: return B2000000;
+#endif
+        default:      return B0;
+    }
+}
+
+/**
+ * @brief Write a whole buffer, retrying on partial writes.
+ */
+static bool host_write(ws2812b_host_t *host, const uint8_t *data, uint32_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = write(host->fd, data, len);
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        len -= (uint32_t)n;
+        host->stats.bytes += (uint64_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Monotonic time in ns.
+ */
+uint64_t WS2812B_Host_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Open and configure a serial device.
+ * @return false on error (errno is set).
+ */
+bool WS2812B_Host_Open(ws2812b_host_t *host, const char *path, uint32_t baud)
+{
+    struct termios tio;
+
+    memset(host, 0, sizeof(*host));
+    host->fd = open(path, O_RDWR | O_NOCTTY);
+    if (host->fd < 0) return false;
+
+    if (tcgetattr(host->fd, &tio) != 0)
+    {
+        WS2812B_Host_Close(host);
+        return false;
+    }
+
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | PARENB);
+#ifdef CRTSCTS
+    tio.c_cflag &= ~CRTSCTS;
+#endif
+    if (baud != 0)
+    {
+        speed_t speed = host_speed(baud);
+        if (speed == B0)
+        {
+            WS2812B_Host_Close(host);
+            errno = EINVAL;
+            return false;
+        }
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+    }
+    if (tcsetattr(host->fd, TCSANOW, &tio) != 0)
+    {
+        WS2812B_Host_Close(host);
+        return false;
+    }
+
+    host->baud = baud;
+    return true;
+}
+
+/**
+ * @brief Wait until everything is transmitted, then close the device.
+ */
+void WS2812B_Host_Close(ws2812b_host_t *host)
+{
+    if (host->fd < 0) return;
+
+    tcdrain(host->fd);
+    close(host->fd);
+    host->fd = -1;
+}
+
+/**
+ * @brief Send one frame, raw or run-length encoded, whichever is smaller.
+ * @return false on a write error or if the frame is too large.
+ */
+bool WS2812B_Host_SendFrame(ws2812b_host_t *host, const uint8_t *rgb, uint16_t count, bool allow_rle)
+{
+    static uint8_t payload[WS2812B_PROTOCOL_MAX_PAYLOAD];
+    static uint8_t packet[HOST_PACKET_MAX];
+    uint32_t raw_len = 2U + 3U * count;
+    uint32_t len = 2;
+    uint8_t type = PACKET_FRAME;
+
+    if (raw_len > WS2812B_PROTOCOL_MAX_PAYLOAD) return false;
+
+    payload[0] = 0;     // First pixel
+    payload[1] = 0;
+
+    if (allow_rle)
+    {
+        // Runs of {count, R, G, B}; give up as soon as it is not smaller
+        for (uint16_t i = 0; i < count && len < raw_len; )
+        {
+            const uint8_t *px = &rgb[i * 3];
+            uint16_t run = 1;
+            while (i + run < count && run < 255 && memcmp(&rgb[(i + run) * 3], px, 3) == 0) run++;
+
+            if (len + 4 > WS2812B_PROTOCOL_MAX_PAYLOAD) { len = raw_len; break; }
+            payload[len++] = (uint8_t)run;
+            payload[len++] = px[0];
+            payload[len++] = px[1];
+            payload[len++] = px[2];
+            i = (uint16_t)(i + run);
+        }
+        if (len < raw_len) type = PACKET_FRAME_RLE;
+    }
+
+    if (type == PACKET_FRAME)
+    {
+        memcpy(&payload[2], rgb, 3U * count);
+        len = raw_len;
+    }
+
+    uint32_t packet_len = WS2812B_Protocol_BuildPacket(type, payload, (uint16_t)len, packet);
+    if (!host_write(host, packet, packet_len)) return false;
+    host->stats.frames++;
+    return true;
+}
+
+/**
+ * @brief Send one control command.
+ * @return false on a write error.
+ */
+bool WS2812B_Host_SendCommand(ws2812b_host_t *host, uint8_t cmd, int32_t value)
+{
+    uint8_t payload[5] = {
+        cmd,
+        (uint8_t)value, (uint8_t)((uint32_t)value >> 8),
+        (uint8_t)((uint32_t)value >> 16), (uint8_t)((uint32_t)value >> 24)
+    };
+    uint8_t packet[sizeof(payload) + WS2812B_PROTOCOL_OVERHEAD];
+
+    uint32_t packet_len = WS2812B_Protocol_BuildPacket(PACKET_COMMAND, payload, sizeof(payload), packet);
+    if (!host_write(host, packet, packet_len)) return false;
+    host->stats.commands++;
+    return true;
+}
+
+/**
+ * @brief Read what the device sent, waiting up to @p timeout_ms for the first byte.
+ * @return Bytes read (0 on timeout), -1 on error.
+ */
+int32_t WS2812B_Host_Read(ws2812b_host_t *host, uint8_t *buf, uint32_t len, uint32_t timeout_ms)
+{
+    struct pollfd pfd = { host->fd, POLLIN, 0 };
+
+    for (;;)
+    {
+        int ready = poll(&pfd, 1, (int)timeout_ms);
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready <= 0) return ready;
+
+        ssize_t n = read(host->fd, buf, len);
+        if (n < 0 && errno == EINTR) continue;
+        return (int32_t)n;
+    }
+}
+
+/**
+ * @brief Ask the device for its status and wait for a PACKET_STATUS reply with a valid CRC.
+ * @return false on a write error, a timeout, or no valid reply.
+ */
+bool WS2812B_Host_RequestStatus(ws2812b_host_t *host, ws2812b_status_t *status, uint32_t timeout_ms)
+{
+    enum { STATUS_PACKET = WS2812B_STATUS_SIZE + WS2812B_PROTOCOL_OVERHEAD };
+    uint8_t buf[4 * STATUS_PACKET];
+    uint8_t packet[STATUS_PACKET];
+    uint32_t len = 0;
+
+    if (!WS2812B_Host_SendCommand(host, CMD_STATUS, 0)) return false;
+
+    const uint64_t deadline = WS2812B_Host_Now() + (uint64_t)timeout_ms * 1000000U;
+    for (;;)
+    {
+        // Drop bytes until a status header could start at buf[0]
+        uint32_t skip = 0;
+        while (skip < len &&
+               !(buf[skip] == WS2812B_PROTOCOL_SYNC &&
+                 (skip + 1 >= len || buf[skip + 1] == PACKET_STATUS) &&
+                 (skip + 2 >= len || buf[skip + 2] == (uint8_t)WS2812B_STATUS_SIZE) &&
+                 (skip + 3 >= len || buf[skip + 3] == (uint8_t)(WS2812B_STATUS_SIZE >> 8))))
+        {
+            skip++;
+        }
+        memmove(buf, &buf[skip], len - skip);
+        len -= skip;
+
+        if (len >= STATUS_PACKET)
+        {
+            WS2812B_Protocol_BuildPacket(PACKET_STATUS, &buf[4], WS2812B_STATUS_SIZE, packet);
+            if (memcmp(packet, buf, STATUS_PACKET) == 0)
+            {
+                return WS2812B_Protocol_UnpackStatus(&buf[4], WS2812B_STATUS_SIZE, status);
+            }
+            memmove(buf, &buf[1], --len);   // CRC mismatch: resync after this sync byte
+            continue;
+        }
+
+        uint64_t now = WS2812B_Host_Now();
+        if (now >= deadline) return false;
+
+        int32_t n = WS2812B_Host_Read(host, &buf[len], sizeof(buf) - len, (uint32_t)((deadline - now) / 1000000U) + 1U);
+        if (n < 0) return false;
+        len += (uint32_t)n;
+    }
+}
+
+/**
+ * @brief Start the frame clock and clear the statistics.
+ */
+void WS2812B_Host_PacerStart(ws2812b_host_t *host, double fps)
+{
+    memset(&host->stats, 0, sizeof(host->stats));
+    host->period_ns = (uint64_t)(1e9 / fps + 0.5);
+    host->start_ns = WS2812B_Host_Now();
+    host->next_ns = host->start_ns + host->period_ns;
+}
+
+/**
+ * @brief Sleep until the next frame deadline (absolute schedule).
+ */
+void WS2812B_Host_PacerWait(ws2812b_host_t *host)
+{
+    uint64_t now = WS2812B_Host_Now();
+
+    if (now > host->next_ns)
+    {
+        uint64_t late_ns = now - host->next_ns;
+        uint32_t late_us = (late_ns / 1000U > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (uint32_t)(late_ns / 1000U);
+
+        host->stats.late++;
+        if (late_us > host->stats.max_late_us) host->stats.max_late_us = late_us;
+        host->next_ns = (late_ns > host->period_ns) ? now + host->period_ns : host->next_ns + host->period_ns;
+    }
+    else
+    {
+        struct timespec ts = {
+            (time_t)(host->next_ns / 1000000000ULL),
+            (long)(host->next_ns % 1000000000ULL)
+        };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) { }
+        host->next_ns += host->period_ns;
+    }
+
+    host->stats.elapsed_us = (WS2812B_Host_Now() - host->start_ns) / 1000U;
+}
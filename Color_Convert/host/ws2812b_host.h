@@ -0,0 +1,168 @@
+/**
+ * @file ws2812b_host.h
+ * @brief Host-side client for the WS2812B serial protocol (POSIX).
+ *
+ * Opens a serial device (or a pseudo-terminal), builds packets with the
+ * firmware's own WS2812B_Protocol_BuildPacket(), and paces frames on an
+ * absolute CLOCK_MONOTONIC schedule so that the average rate stays exact and
+ * a late frame does not delay the ones after it. Throughput statistics count
+ * what was actually written to the device.
+ *
+ * @code
+ * ws2812b_host_t host;
+ * if (!WS2812B_Host_Open(&host, "/dev/ttyUSB0", 921600)) return 1;
+ * WS2812B_Host_PacerStart(&host, 25.0);
+ * for (;;)
+ * {
+ *     render(rgb);
+ *     WS2812B_Host_SendFrame(&host, rgb, 60, true);
+ *     WS2812B_Host_PacerWait(&host);
+ * }
+ * @endcode
+ */
+
+#ifndef WS2812B_HOST_H
+#define WS2812B_HOST_H
+
+#include "WS2812B_Protocol.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Throughput statistics.
+ */
+typedef struct {
+    uint32_t frames;            ///< Frame packets written
+    uint32_t commands;          ///< Command packets written
+    uint64_t bytes;             ///< Bytes written (all packets)
+    uint32_t late;              ///< Frames that missed their deadline
+    uint32_t max_late_us;       ///< Worst deadline miss
+    uint64_t elapsed_us;        ///< Time since WS2812B_Host_PacerStart()
+} ws2812b_host_stats_t;
+
+/**
+ * @brief Connection and pacing state.
+ */
+typedef struct {
+    int fd;                     ///< Device file descriptor (-1 if closed)
+    uint32_t baud;              ///< Configured baud rate (0 for a pseudo-terminal)
+    uint64_t period_ns;         ///< Frame period
+    uint64_t start_ns;          ///< Pacer start, CLOCK_MONOTONIC
+    uint64_t next_ns;           ///< Deadline of the next frame
+    ws2812b_host_stats_t stats;
+} ws2812b_host_t;
+
+/**
+ * @brief Open and configure a serial device (raw 8N1, no flow control).
+ * @param host Connection
+ * @param path Device path
+ * @param baud Baud rate (one of the standard termios rates); 0 keeps the
+ *             current setting, e.g. for a pseudo-terminal
+ * @return false on error (errno is set).
+ */
+bool WS2812B_Host_Open(ws2812b_host_t *host, const char *path, uint32_t baud);
+
+/**
+ * @brief Wait until everything is transmitted, then close the device.
+ */
+void WS2812B_Host_Close(ws2812b_host_t *host);
+
+/**
+ * @brief Send one frame.
+ * @param host Connection
+ * @param rgb Pixels, R, G, B per LED
+ * @param count Number of LEDs (payload must fit WS2812B_PROTOCOL_MAX_PAYLOAD)
+ * @param allow_rle Send PACKET_FRAME_RLE instead when it is smaller
+ * @return false on a write error or if the frame is too large.
+ */
+bool WS2812B_Host_SendFrame(ws2812b_host_t *host, const uint8_t *rgb, uint16_t count, bool allow_rle);
+
+/**
+ * @brief Send one control command.
+ * @param host Connection
+ * @param cmd @ref ws2812b_cmd_type_t
+ * @param value Command argument
+ * @return false on a write error.
+ */
+bool WS2812B_Host_SendCommand(ws2812b_host_t *host, uint8_t cmd, int32_t value);
+
+/**
+ * @brief Ask the device for its status (CMD_STATUS) and wait for the reply.
+ * @param host Connection
+ * @param[out] status Status from the PACKET_STATUS reply
+ * @param timeout_ms Longest wait for the reply
+ * @return false on a write error, a timeout, or no valid reply.
+ * @note Other bytes the device sends meanwhile are discarded.
+ */
+bool WS2812B_Host_RequestStatus(ws2812b_host_t *host, ws2812b_status_t *status, uint32_t timeout_ms);
+
+/**
+ * @brief Start the frame clock and clear the statistics.
+ * @param host Connection
+ * @param fps Target frame rate
+ */
+void WS2812B_Host_PacerStart(ws2812b_host_t *host, double fps);
+
+/**
+ * @brief Sleep until the next frame deadline.
+ * @note A frame that starts after its deadline is counted as late. Small
+ *       misses are absorbed by the following frames (the schedule is not
+ *       shifted); after a miss of more than one period the schedule restarts
+ *       from now instead of sending a burst.
+ */
+void WS2812B_Host_PacerWait(ws2812b_host_t *host);
+
+/**
+ * @brief Read what the device sent.
+ * @param host Connection
+ * @param[out] buf Buffer
+ * @param len Buffer size
+ * @param timeout_ms Longest wait for the first byte
+ * @return Bytes read (0 on timeout), -1 on error.
+ */
+int32_t WS2812B_Host_Read(ws2812b_host_t *host, uint8_t *buf, uint32_t len, uint32_t timeout_ms);
+
+/**
+ * @brief Monotonic time in ns.
+ */
+uint64_t WS2812B_Host_Now(void);
+
+// ===================================================================
+// ====================== HOST PORT (HAL STAND-IN) ===================
+// ===================================================================
+
+/**
+ * @brief Switch HAL_GetTick() to a virtual clock and set it.
+ * @param tick Time in ms; HAL_Delay() advances it without sleeping.
+ * @note Implemented by ws2812b_host_port.c.
+ */
+void WS2812B_Host_SetTick(uint32_t tick);
+
+/**
+ * @brief Route HAL_UART_Transmit() to a file descriptor (-1: transmits fail).
+ * @note Implemented by ws2812b_host_port.c.
+ */
+void WS2812B_Host_SetUart(int fd);
+
+/**
+ * @brief Set the system clock the RCC calls report (default 72 MHz).
+ * @param hz SYSCLK = HCLK; PCLK1 is half of it, the TIM3 clock equal to it
+ * @note Implemented by ws2812b_host_port.c.
+ */
+void WS2812B_Host_SetSysClock(uint32_t hz);
+
+/**
+ * @brief Receives every TIM3 CCR1 value a started PWM DMA transfer writes.
+ */
+typedef void (*ws2812b_host_ccr_fn_t)(uint16_t value);
+
+/**
+ * @brief Play TIM3 PWM DMA transfers into @p fn (NULL: starts do nothing).
+ * @note Each memory element is read with the width the TIM3 DMA channel was
+ *       initialised with (hdma_tim3_ch1_trig MemDataAlignment) and widened to
+ *       the 16-bit CCR1, as the DMA does; a buffer handed over with the wrong
+ *       width shows up as wrong values. Implemented by ws2812b_host_port.c.
+ */
+void WS2812B_Host_SetCcrHook(ws2812b_host_ccr_fn_t fn);
+
+#endif /* WS2812B_HOST_H */
@@ -0,0 +1,28 @@
+/**
+ * @file ws2812b_host_nofx.c
+ * @brief Stand-ins for the effect engine in host builds that do not link WS2812B_Effects.c.
+ *
+ * The streamer only needs the parser, the frame path and the modules commands
+ * reach (presets, playlists); these keep the brightness/speed globals and
+ * SetEffect so that presets and playlists received by the parser can be
+ * applied, and report no animation phase to the recorder. The replay tool
+ * links the real WS2812B_Effects.c instead.
+ */
+
+#include "WS2812B_Effects.h"
+
+static uint8_t host_brightness = 100;
+static uint8_t host_speed = 50;
+
+void WS2812B_SetBrightness(uint8_t brightness) { host_brightness = (brightness > 100) ? 100 : brightness; }
+uint8_t WS2812B_GetBrightness(void) { return host_brightness; }
+void WS2812B_SetSpeed(uint8_t speed) { host_speed = (speed > 100) ? 100 : speed; }
+uint8_t WS2812B_GetSpeed(void) { return host_speed; }
+
+void WS2812B_Effects_SetEffect(ws2812b_effects_t *effects, ws2812b_effect_t new_effect)
+{
+    effects->current_effect = new_effect;
+}
+
+void WS2812B_Effects_GetPhase(ws2812b_effects_phase_t *phase) { *phase = (ws2812b_effects_phase_t){ 0, 0, 0, 1, 0, 0 }; }
+void WS2812B_Effects_SetPhase(const ws2812b_effects_phase_t *phase) { (void)phase; }
@@ -0,0 +1,230 @@
+/**
+ * @file ws2812b_host_port.c
+ * @brief Host implementation of the HAL calls and board symbols the driver modules use.
+ *
+ * Time comes from CLOCK_MONOTONIC, or from a virtual clock once
+ * WS2812B_Host_SetTick() was called (HAL_Delay() then advances it instead of
+ * sleeping). The clock tree is the target's: SYSCLK 72 MHz (or the value set
+ * with WS2812B_Host_SetSysClock()), APB1 = SYSCLK/2, so the TIM3 clock is
+ * SYSCLK. TIM3/DMA starts are accepted and do nothing unless
+ * WS2812B_Host_SetCcrHook() asks for the CCR1 values a PWM transfer writes.
+ * UART transmits go to the file descriptor set with WS2812B_Host_SetUart(),
+ * and the two flash pages (_spresets, _splaylist) are RAM arrays of the
+ * record types the modules declare, erased at startup. Flash programs and erases outside
+ * those pages fail, as a write to an unmapped address would fault.
+ *
+ * Builds without the effect engine link ws2812b_host_nofx.c for the few
+ * WS2812B_Effects.c functions the other modules call.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "ws2812b_host.h"
+#include "WS2812B.h"
+#include "WS2812B_Preset.h"
+#include "WS2812B_Playlist.h"
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------- Board symbols
+static DWT_Type host_dwt;
+static CoreDebug_Type host_core_debug;
+static RCC_TypeDef host_rcc = { .CFGR = RCC_CFGR_PPRE1_DIV2 };    // As SystemClock_Config()
+static GPIO_TypeDef host_gpiob = { 0xFFFFU };   // Buttons released (active low)
+static TIM_TypeDef host_tim3;
+
+DWT_Type *DWT = &host_dwt;
+CoreDebug_Type *CoreDebug = &host_core_debug;
+RCC_TypeDef *RCC = &host_rcc;
+GPIO_TypeDef *GPIOB = &host_gpiob;
+
+TIM_HandleTypeDef htim3 = { .Instance = &host_tim3 };
+DMA_HandleTypeDef hdma_tim3_ch1_trig;
+RTC_HandleTypeDef hrtc;     // No LSE (Instance NULL): drive WS2812B_Schedule_Evaluate() directly
+volatile clock_path_t system_clock_path = CLOCK_PATH_HSE_72MHZ;
+
+#define HOST_FLASH_PAGE     1024U
+#define HOST_PAGE_RECORDS(type)     ((HOST_FLASH_PAGE + sizeof(type) - 1U) / sizeof(type))
+
+/**
+ * @brief Flash pages reserved by the linker script on the target.
+ * @note The modules see them as const, like flash; only the flash functions
+ *       below write them.
+ */
+ws2812b_preset_t _spresets[HOST_PAGE_RECORDS(ws2812b_preset_t)] __attribute__((aligned(4)));
+ws2812b_playlist_t _splaylist[HOST_PAGE_RECORDS(ws2812b_playlist_t)] __attribute__((aligned(4)));
+
+__attribute__((constructor)) static void host_flash_erase_all(void)
+{
+    memset(_spresets, 0xFF, sizeof(_spresets));
+    memset(_splaylist, 0xFF, sizeof(_splaylist));
+}
+
+/**
+ * @brief Host pointer to @p len bytes of flash at @p address.
+ * @return NULL unless the range lies inside one page.
+ */
+static uint8_t *host_flash_ptr(uintptr_t address, uint32_t len)
+{
+    uint8_t *const pages[] = { (uint8_t *)_spresets, (uint8_t *)_splaylist };
+
+    for (size_t i = 0; i < sizeof(pages) / sizeof(pages[0]); i++)
+    {
+        uintptr_t base = (uintptr_t)pages[i];
+        if (address >= base && address - base + len <= HOST_FLASH_PAGE) return (uint8_t *)address;
+    }
+    return NULL;
+}
+
+// ---------------------------------------------------------------- Time
+static bool host_virtual = false;
+static uint32_t host_tick = 0;
+static int host_uart_fd = -1;
+static uint32_t host_sysclk = 72000000U;
+static ws2812b_host_ccr_fn_t host_ccr_hook = NULL;
+
+void WS2812B_Host_SetTick(uint32_t tick)
+{
+    host_virtual = true;
+    host_tick = tick;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    static struct timespec start;
+    struct timespec now;
+
+    if (host_virtual) return host_tick;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (start.tv_sec == 0 && start.tv_nsec == 0) start = now;
+    return (uint32_t)((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000);
+}
+
+void HAL_Delay(uint32_t delay)
+{
+    if (host_virtual)
+    {
+        host_tick += delay;
+        return;
+    }
+
+    struct timespec ts = { (time_t)(delay / 1000U), (long)(delay % 1000U) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+void WS2812B_Host_SetSysClock(uint32_t hz)
+{
+    host_sysclk = hz;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void) { return host_sysclk / 2U; }
+uint32_t HAL_RCC_GetSysClockFreq(void) { return host_sysclk; }
+uint32_t HAL_RCC_GetHCLKFreq(void) { return host_sysclk; }
+
+// ---------------------------------------------------------------- Peripherals (no-ops)
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma) { (void)hdma; return HAL_OK; }
+
+void WS2812B_Host_SetCcrHook(ws2812b_host_ccr_fn_t fn)
+{
+    host_ccr_hook = fn;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start_DMA(TIM_HandleTypeDef *htim, uint32_t channel, const uint32_t *data, uint16_t length)
+{
+    (void)channel;
+    if (htim != &htim3 || host_ccr_hook == NULL) return HAL_OK;
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        switch (hdma_tim3_ch1_trig.Init.MemDataAlignment)
+        {
+            case DMA_MDATAALIGN_BYTE:       host_ccr_hook(((const uint8_t *)data)[i]); break;
+            case DMA_MDATAALIGN_HALFWORD:   host_ccr_hook(((const uint16_t *)data)[i]); break;
+            default:                        host_ccr_hook((uint16_t)data[i]); break;
+        }
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_DMA(TIM_HandleTypeDef *htim, uint32_t channel)
+{
+    (void)htim; (void)channel;
+    return HAL_OK;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin)
+{
+    return (port->IDR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size)
+{
+    (void)huart; (void)data; (void)size;
+    return HAL_ERROR;   // No UART on the host: feed the parser directly
+}
+
+void WS2812B_Host_SetUart(int fd)
+{
+    host_uart_fd = fd;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size, uint32_t timeout)
+{
+    (void)huart; (void)timeout;
+
+    while (host_uart_fd >= 0 && size > 0)
+    {
+        ssize_t n = write(host_uart_fd, data, size);
+        if (n <= 0) return HAL_ERROR;
+        data += n;
+        size = (uint16_t)(size - n);
+    }
+    return (host_uart_fd >= 0) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef *hadc) { (void)hadc; return HAL_OK; }
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *data, uint32_t length)
+{
+    (void)hadc; (void)data; (void)length;
+    return HAL_ERROR;   // No current sense on the host: drive WS2812B_Current_Update() directly
+}
+
+HAL_StatusTypeDef HAL_RTCEx_SetSecond_IT(RTC_HandleTypeDef *hrtc) { (void)hrtc; return HAL_OK; }
+
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *time, uint32_t format)
+{
+    (void)hrtc; (void)time; (void)format;
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------- Flash (RAM pages)
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) { return HAL_OK; }
+HAL_StatusTypeDef HAL_FLASH_Lock(void) { return HAL_OK; }
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t type, uintptr_t address, uint64_t data)
+{
+    uint16_t halfword = (uint16_t)data;
+    uint8_t *dst = host_flash_ptr(address, sizeof(halfword));
+
+    if (type != FLASH_TYPEPROGRAM_HALFWORD || dst == NULL) return HAL_ERROR;
+    memcpy(dst, &halfword, sizeof(halfword));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *erase, uint32_t *page_error)
+{
+    uint8_t *dst = host_flash_ptr(erase->PageAddress, HOST_FLASH_PAGE * erase->NbPages);
+
+    *page_error = (dst == NULL) ? (uint32_t)erase->PageAddress : 0xFFFFFFFFU;
+    if (dst == NULL) return HAL_ERROR;
+    memset(dst, 0xFF, HOST_FLASH_PAGE * erase->NbPages);
+    return HAL_OK;
+}
+
+void Error_Handler(void)
+{
+    for (;;) { }
+}
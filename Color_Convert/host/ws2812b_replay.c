@@ -0,0 +1,644 @@
+/**
+ * @file ws2812b_replay.c
+ * @brief Deterministic replay of a WS2812B_Record log against the host build of the effect engine.
+ *
+ * Reads a log dumped by the firmware (CMD_RECORD / RECORD_DUMP), either
+ * straight from the serial device or from a file the dump was saved to,
+ * restores the effect state from the keyframe the log starts with (the
+ * start of the session, or the oldest keyframe the ring kept) and runs the
+ * render loop frame by frame on a virtual clock: every frame's inputs are applied
+ * at the recorded tick, the frame is rendered by the same code the firmware
+ * runs, and its PWM checksum is compared with the recorded one. The first
+ * mismatch is the first frame whose rendering depends on something the log
+ * does not capture (or on a bug). Replayed frames can be written as raw RGB
+ * for ws2812b_stream -i, and the slowest frames on the host are listed.
+ *
+ * --self-test needs no hardware: a child process runs the render loop on the
+ * real clock with random commands and parameter blocks, records it and dumps
+ * the log through a pipe; the parent (with fresh module state) replays it and
+ * fails unless every frame matches. The default 8 s overrun the default
+ * 256-entry ring, so the replay starts at a later keyframe.
+ *
+ * Build (from Color_Convert/; LED_NUM must match the firmware):
+ * @code
+ * make -C host LED_NUM=60 build/ws2812b_replay
+ * @endcode
+ *
+ * Usage:
+ * @code
+ * ./ws2812b_replay -d /dev/ttyUSB0 -s session.bin
+ * ./ws2812b_replay session.bin -o frames.rgb -v
+ * ./ws2812b_replay --self-test -t 5
+ * @endcode
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "ws2812b_host.h"
+#include "WS2812B_Effects.h"
+#include "WS2812B_Playlist.h"
+#include "WS2812B_Preset.h"
+#include "WS2812B_Protocol.h"
+#include "WS2812B_Record.h"
+#include "WS2812B_Current.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define SLOWEST_FRAMES  3       ///< Frames listed by render time
+#define MISMATCH_LINES  10      ///< Mismatching frames printed without -v
+
+/**
+ * @brief Command-line options.
+ */
+typedef struct {
+    const char *device;
+    const char *input;          ///< Dump file
+    const char *save;           ///< Save the raw dump received from the device
+    const char *output;         ///< Replayed frames as raw RGB
+    uint32_t baud;
+    double seconds;             ///< Self-test recording time
+    bool self_test;
+    bool verbose;
+} options_t;
+
+/**
+ * @brief Replay result.
+ */
+typedef struct {
+    uint32_t frames;            ///< Frames rendered
+    uint32_t verified;          ///< Frames compared (not streamed)
+    uint32_t mismatches;
+    uint32_t commands;
+    uint32_t params;
+    uint32_t keyframes;         ///< Keyframes in the log, the first one included
+    bool wrapped;               ///< Log starts at a later keyframe, not at the session start
+    uint32_t first_bad;         ///< Index of the first mismatching frame
+    uint32_t first_bad_tick;
+    uint32_t slow_frame[SLOWEST_FRAMES];
+    uint32_t slow_tick[SLOWEST_FRAMES];
+    uint64_t slow_ns[SLOWEST_FRAMES];
+    uint64_t total_ns;
+} replay_result_t;
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s (FILE | -d DEVICE | --self-test) [options]\n"
+            "  FILE         dump saved earlier (raw bytes as sent by the device)\n"
+            "  -d DEVICE    request the dump from the device (CMD_RECORD, RECORD_DUMP)\n"
+            "  -b BAUD      baud rate (default %d)\n"
+            "  -s FILE      save the dump received from the device\n"
+            "  -o FILE      write the replayed frames as raw RGB (%d LEDs)\n"
+            "  -v           print every frame\n"
+            "  --self-test  record a random session in a child process and replay it\n"
+            "  -t SECONDS   self-test recording time (default 8)\n",
+            prog, WS2812B_PROTOCOL_BAUD, LED_NUM);
+}
+
+static bool parse_options(int argc, char **argv, options_t *opt)
+{
+    *opt = (options_t){ .baud = WS2812B_PROTOCOL_BAUD, .seconds = 8.0 };
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(a, "--self-test") == 0) { opt->self_test = true; continue; }
+        if (strcmp(a, "-v") == 0) { opt->verbose = true; continue; }
+        if (a[0] != '-') { opt->input = a; continue; }
+        if (v == NULL) return false;
+
+        if (strcmp(a, "-d") == 0) opt->device = v;
+        else if (strcmp(a, "-s") == 0) opt->save = v;
+        else if (strcmp(a, "-o") == 0) opt->output = v;
+        else if (strcmp(a, "-b") == 0) opt->baud = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "-t") == 0) opt->seconds = strtod(v, NULL);
+        else return false;
+        i++;
+    }
+
+    return (opt->input != NULL) + (opt->device != NULL) + opt->self_test == 1;
+}
+
+// ===================================================================
+// =============================== DUMP ==============================
+// ===================================================================
+
+/**
+ * @brief Log reassembled from PACKET_RECORD packets.
+ */
+typedef struct {
+    ws2812b_record_entry_t *entries;
+    uint32_t total;             ///< Entries in the log (from the packets)
+    uint32_t received;          ///< Entries received so far
+    bool seen;                  ///< At least one packet found
+} dump_t;
+
+/**
+ * @brief Find the PACKET_RECORD packets in a byte stream and collect their entries.
+ * @return true once the whole log is there.
+ * @note Other bytes (packets of other types, line noise) are skipped; a
+ *       packet counts only if its CRC matches, which is checked by rebuilding
+ *       it with the firmware's own WS2812B_Protocol_BuildPacket().
+ */
+static bool dump_parse(dump_t *dump, const uint8_t *data, size_t len)
+{
+    static uint8_t packet[0x10000 + WS2812B_PROTOCOL_OVERHEAD];
+
+    dump->received = 0;
+    for (size_t pos = 0; pos + WS2812B_PROTOCOL_OVERHEAD <= len; pos++)
+    {
+        const uint8_t *p = &data[pos];
+        uint16_t plen = (uint16_t)(p[2] | (p[3] << 8));
+
+        if (p[0] != WS2812B_PROTOCOL_SYNC || p[1] != PACKET_RECORD || plen < 4 ||
+            (plen - 4U) % WS2812B_RECORD_ENTRY_SIZE != 0 || pos + WS2812B_PROTOCOL_OVERHEAD + plen > len)
+        {
+            continue;
+        }
+        WS2812B_Protocol_BuildPacket(PACKET_RECORD, &p[4], plen, packet);
+        if (packet[4 + plen] != p[4 + plen]) continue;
+
+        uint32_t first = p[4] | (p[5] << 8);
+        uint32_t total = p[6] | (p[7] << 8);
+        uint32_t n = (plen - 4U) / WS2812B_RECORD_ENTRY_SIZE;
+
+        if (!dump->seen || total != dump->total)
+        {
+            free(dump->entries);
+            dump->entries = calloc(total ? total : 1, sizeof(ws2812b_record_entry_t));
+            dump->total = total;
+            dump->received = 0;
+            dump->seen = true;
+        }
+        if (first + n > total) continue;
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            WS2812B_Record_Unpack(&p[8 + i * WS2812B_RECORD_ENTRY_SIZE], &dump->entries[first + i]);
+        }
+        if (first == dump->received) dump->received += n;
+        pos += WS2812B_PROTOCOL_OVERHEAD + plen - 1U;
+    }
+
+    return dump->seen && dump->received == dump->total;
+}
+
+/**
+ * @brief Read a whole file (or a pipe) into memory.
+ */
+static uint8_t *read_all(FILE *f, size_t *len)
+{
+    size_t cap = 4096;
+    uint8_t *buf = malloc(cap);
+
+    *len = 0;
+    for (size_t n; (n = fread(buf + *len, 1, cap - *len, f)) > 0; )
+    {
+        *len += n;
+        if (*len == cap) buf = realloc(buf, cap *= 2);
+    }
+    return buf;
+}
+
+/**
+ * @brief Ask the device for its log and collect the reply.
+ * @return Raw bytes received (to parse and optionally save), NULL on error.
+ */
+static uint8_t *dump_request(const options_t *opt, size_t *len)
+{
+    ws2812b_host_t host;
+    size_t cap = 4096;
+    uint8_t *buf = malloc(cap);
+    dump_t dump = { 0 };
+
+    *len = 0;
+    if (!WS2812B_Host_Open(&host, opt->device, opt->baud))
+    {
+        perror(opt->device);
+        free(buf);
+        return NULL;
+    }
+
+    tcflush(host.fd, TCIFLUSH);
+    if (!WS2812B_Host_SendCommand(&host, CMD_RECORD, RECORD_DUMP))
+    {
+        perror("write");
+        free(buf);
+        WS2812B_Host_Close(&host);
+        return NULL;
+    }
+
+    // The device answers within a frame; the dump ends when the last entry arrived or the line goes quiet
+    for (;;)
+    {
+        int32_t n = WS2812B_Host_Read(&host, buf + *len, (uint32_t)(cap - *len), 1000);
+        if (n <= 0) break;
+        *len += (size_t)n;
+        if (*len == cap) buf = realloc(buf, cap *= 2);
+        if (dump_parse(&dump, buf, *len)) break;
+    }
+
+    free(dump.entries);
+    WS2812B_Host_Close(&host);
+    return buf;
+}
+
+// ===================================================================
+// ============================== REPLAY =============================
+// ===================================================================
+
+/**
+ * @brief Decode the PWM buffer back into R, G, B per LED.
+ */
+static void frame_to_rgb(uint16_t period, uint8_t *rgb)
+{
+    ws2812b_timing_t timing;
+    WS2812B_ComputeTiming((uint32_t)period * 800000U, &timing);
+    const uint16_t threshold = (uint16_t)((timing.t0h + timing.t1h) / 2U);
+
+    for (uint16_t led = 0; led < LED_NUM; led++)
+    {
+        uint32_t grb = 0;
+        for (int bit = 0; bit < 24; bit++)
+        {
+            grb = (grb << 1) | (pwmData[led * 24 + bit] > threshold);
+        }
+        rgb[led * 3] = (uint8_t)(grb >> 8);
+        rgb[led * 3 + 1] = (uint8_t)(grb >> 16);
+        rgb[led * 3 + 2] = (uint8_t)grb;
+    }
+}
+
+/**
+ * @brief Restore the effect state from the snapshot fields.
+ * @param[out] phase Collects the effect phases, restored once the snapshot is complete
+ * @return false if the log was recorded with a different LED_NUM.
+ */
+static bool restore_field(ws2812b_effects_t *fx, uint8_t field, int32_t value, uint16_t *period,
+                          ws2812b_effects_phase_t *phase)
+{
+    switch (field)
+    {
+        case FIELD_LED_NUM:
+            if (value != LED_NUM)
+            {
+                fprintf(stderr, "log recorded with LED_NUM %d, this build has %d\n", (int)value, LED_NUM);
+                return false;
+            }
+            break;
+        case FIELD_TIMER_PERIOD:
+            *period = (uint16_t)value;
+            WS2812B_SetTiming((uint32_t)value * 800000U);
+            break;
+        case FIELD_OUTPUT:          WS2812B_Control_Execute(fx, CMD_POWER, value); break;
+        case FIELD_EFFECT:          fx->current_effect = (ws2812b_effect_t)value; break;
+        case FIELD_HUE:             fx->hue = (uint16_t)value; break;
+        case FIELD_HUE16:           fx->hue16 = (uint16_t)value; break;
+        case FIELD_HUE_STEP:        fx->hue_step = (uint16_t)value; break;
+        case FIELD_BRIGHTNESS:      fx->brightness = (uint8_t)value; break;
+        case FIELD_BREATHE_DIRECTION: fx->breathe_direction = (int8_t)value; break;
+        case FIELD_THEATER_FRAME:   fx->theater_frame = (uint8_t)value; break;
+        case FIELD_EFFECT_SPEED:    fx->effect_speed = (uint32_t)value; break;
+        case FIELD_AUTO_CYCLE:      fx->auto_cycle = (value != 0); break;
+        case FIELD_CYCLE_DURATION:  fx->cycle_duration = (uint32_t)value; break;
+        case FIELD_GLOBAL_BRIGHTNESS: WS2812B_SetBrightness((uint8_t)value); break;
+        case FIELD_GLOBAL_SPEED:    WS2812B_SetSpeed((uint8_t)value); break;
+        case FIELD_MIRROR:          WS2812B_SetMirror((ws2812b_mirror_t)value); break;
+        case FIELD_RAINBOW_HUE:     phase->rainbow_hue = (uint16_t)value; break;
+        case FIELD_CHASE_OFFSET:    phase->chase_offset = (uint16_t)value; break;
+        case FIELD_BREATHE_LEVEL:   phase->breathe_val = (uint8_t)value; break;
+        case FIELD_BREATHE_STEP:    phase->breathe_dir = (int8_t)value; break;
+        case FIELD_CYCLE_ELAPSED:   phase->cycle_elapsed = (uint32_t)value; break;
+        case FIELD_FIRE_SEED:       phase->fire_seed = (uint32_t)value; break;
+        default: break;
+    }
+    return true;
+}
+
+/**
+ * @brief Keep the SLOWEST_FRAMES longest render times.
+ */
+static void note_render_time(replay_result_t *res, uint32_t frame, uint32_t tick, uint64_t ns)
+{
+    res->total_ns += ns;
+    for (int i = 0; i < SLOWEST_FRAMES; i++)
+    {
+        if (ns > res->slow_ns[i])
+        {
+            memmove(&res->slow_ns[i + 1], &res->slow_ns[i], (SLOWEST_FRAMES - 1 - i) * sizeof(res->slow_ns[0]));
+            memmove(&res->slow_frame[i + 1], &res->slow_frame[i], (SLOWEST_FRAMES - 1 - i) * sizeof(res->slow_frame[0]));
+            memmove(&res->slow_tick[i + 1], &res->slow_tick[i], (SLOWEST_FRAMES - 1 - i) * sizeof(res->slow_tick[0]));
+            res->slow_ns[i] = ns;
+            res->slow_frame[i] = frame;
+            res->slow_tick[i] = tick;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Run the log through the render loop on the virtual clock.
+ * @return false if the log is malformed.
+ */
+static bool replay(const ws2812b_record_entry_t *log, uint32_t count, const options_t *opt,
+                   FILE *out, replay_result_t *res)
+{
+    static const char *const source_name[] = { "effects", "off", "stream" };
+    ws2812b_effects_t fx;
+    ws2812b_effects_phase_t phase;
+    ws2812b_params_t params = { 0 };
+    uint16_t period = 0;
+    uint8_t rgb[3 * LED_NUM];
+
+    memset(res, 0, sizeof(*res));
+    if (count == 0 || (log[0].kind != RECORD_START_MARK && log[0].kind != RECORD_KEYFRAME) ||
+        log[0].type != WS2812B_RECORD_VERSION)
+    {
+        fprintf(stderr, "not a version %d log\n", WS2812B_RECORD_VERSION);
+        return false;
+    }
+
+    // The first keyframe sets the state; later ones only mark where the ring may cut
+    uint32_t tick = (uint32_t)log[0].value;
+    uint32_t i = 1;
+    WS2812B_Host_SetTick(tick);
+    WS2812B_SetOutputScale(256);
+    WS2812B_Effects_Init(&fx);
+    WS2812B_Effects_GetPhase(&phase);
+    for (; i < count && log[i].kind == RECORD_STATE; i++)
+    {
+        if (!restore_field(&fx, log[i].type, log[i].value, &period, &phase)) return false;
+    }
+    WS2812B_Effects_SetPhase(&phase);
+    res->keyframes = 1;
+    res->wrapped = (log[0].kind == RECORD_KEYFRAME);
+
+    for (; i < count; i++)
+    {
+        const ws2812b_record_entry_t *e = &log[i];
+
+        tick += e->dt_ms;
+        if (e->kind == RECORD_TIME) tick += (uint32_t)e->value;
+        WS2812B_Host_SetTick(tick);
+
+        switch (e->kind)
+        {
+            case RECORD_START_MARK:
+            case RECORD_KEYFRAME:
+                res->keyframes++;
+                break;
+
+            case RECORD_PARAMS:
+                params.effect = (ws2812b_effect_t)e->type;
+                params.hue = (uint16_t)e->value;
+                params.brightness = (uint8_t)((uint32_t)e->value >> 16);
+                params.speed = (uint8_t)((uint32_t)e->value >> 24);
+                break;
+
+            case RECORD_PARAMS_CYCLE:
+                params.auto_cycle = (e->type != 0);
+                params.cycle_duration = (uint32_t)e->value;
+                WS2812B_Params_Publish(&params);
+                WS2812B_Control_Apply(&fx);
+                res->params++;
+                break;
+
+            case RECORD_COMMAND:
+                WS2812B_Control_Execute(&fx, e->type, e->value);
+                res->commands++;
+                break;
+
+            case RECORD_SCALE:
+                WS2812B_SetOutputScale((uint16_t)e->value);
+                break;
+
+            case RECORD_FRAME:
+            {
+                uint64_t start = WS2812B_Host_Now();
+                if (e->type == FRAME_EFFECTS)
+                {
+                    WS2812B_Preset_Tick(&fx);
+                    WS2812B_Playlist_Tick(&fx);
+                    WS2812B_Effects_Handle(&fx);
+                }
+                else if (e->type == FRAME_OFF)
+                {
+                    WS2812B_Off();
+                }
+                note_render_time(res, res->frames, tick, WS2812B_Host_Now() - start);
+
+                bool verify = (e->type != FRAME_STREAM);
+                bool match = !verify || WS2812B_Record_FrameHash() == (uint32_t)e->value;
+                if (verify) res->verified++;
+                if (!match && res->mismatches++ == 0)
+                {
+                    res->first_bad = res->frames;
+                    res->first_bad_tick = tick;
+                }
+
+                if (opt->verbose || (!match && res->mismatches <= MISMATCH_LINES))
+                {
+                    printf("frame %5u  tick %8u  %-7s  effect %d  hash %08x  %s\n", res->frames, tick,
+                           source_name[e->type <= FRAME_STREAM ? e->type : FRAME_STREAM], fx.current_effect,
+                           WS2812B_Record_FrameHash(), !verify ? "not verified" : match ? "ok" : "MISMATCH");
+                }
+                if (out != NULL && verify)
+                {
+                    frame_to_rgb(period, rgb);
+                    fwrite(rgb, 1, sizeof(rgb), out);
+                }
+                res->frames++;
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+// ===================================================================
+// ============================ SELF-TEST ============================
+// ===================================================================
+
+/**
+ * @brief Firmware side of the self-test: the render loop on the real clock with random input.
+ * @param fd Pipe the log is dumped to
+ * @note Runs in a child process, so the parent replays with untouched module state.
+ */
+static void self_test_record(int fd, double seconds)
+{
+    static const uint8_t commands[] = {
+        CMD_SET_EFFECT, CMD_NEXT_EFFECT, CMD_SET_HUE, CMD_SET_HUE_STEP, CMD_ADJUST_BRIGHTNESS,
+        CMD_SET_SPEED, CMD_SET_AUTO_CYCLE, CMD_POWER, CMD_SET_MIRROR,
+    };
+    static DMA_HandleTypeDef dma;
+    static UART_HandleTypeDef uart = { &dma };
+    ws2812b_effects_t fx;
+
+    srand((unsigned)WS2812B_Host_Now());
+    WS2812B_Host_SetUart(fd);
+    WS2812B_InitTiming();
+    WS2812B_SetBrightness(80);
+    WS2812B_SetSpeed(90);
+    WS2812B_Effects_Init(&fx);
+    fx.cycle_duration = 400;
+    WS2812B_Protocol_Start(&uart);
+    WS2812B_Record_Start(&fx, true);
+
+    uint32_t end = HAL_GetTick() + (uint32_t)(seconds * 1000.0);
+    while (WS2812B_Record_Active() && (int32_t)(HAL_GetTick() - end) < 0)
+    {
+        if (rand() % 8 == 0)
+        {
+            uint8_t cmd = commands[rand() % sizeof(commands)];
+            int32_t value = (cmd == CMD_SET_EFFECT) ? rand() % WS2812B_EFFECT_CYCLE_COUNT
+                          : (cmd == CMD_SET_SPEED) ? 60 + rand() % 41
+                          : (cmd == CMD_ADJUST_BRIGHTNESS) ? rand() % 41 - 20
+                          : (cmd == CMD_POWER) ? ((rand() % 4 == 0) ? -1 : 1)
+                          : (cmd == CMD_SET_MIRROR) ? rand() % 4
+                          : rand() % 720;
+            WS2812B_Control_Post(cmd, value);
+        }
+        if (rand() % 40 == 0)
+        {
+            ws2812b_params_t p = {
+                (ws2812b_effect_t)(rand() % WS2812B_EFFECT_CYCLE_COUNT), (uint16_t)(rand() % 360),
+                (uint8_t)(rand() % 101), (uint8_t)(60 + rand() % 41), rand() % 2 != 0, 200U + (uint32_t)(rand() % 800),
+            };
+            WS2812B_Params_Publish(&p);
+        }
+
+        // Same order as the firmware render loop (src/main.c), the current limiter fed random readings
+        WS2812B_Record_BeginFrame();
+        WS2812B_Current_Update((uint16_t)(rand() % (2 * WS2812B_CURRENT_LIMIT_MA)));
+        if (WS2812B_Control_Apply(&fx))
+        {
+            WS2812B_Preset_Tick(&fx);
+            WS2812B_Playlist_Tick(&fx);
+            WS2812B_Effects_Handle(&fx);
+            WS2812B_Record_EndFrame(FRAME_EFFECTS);
+        }
+        else
+        {
+            WS2812B_Off();
+            WS2812B_Record_EndFrame(FRAME_OFF);
+        }
+        HAL_Delay((uint32_t)(5 + rand() % 20));
+    }
+
+    WS2812B_Record_Dump();
+}
+
+// ===================================================================
+// =============================== MAIN ==============================
+// ===================================================================
+
+int main(int argc, char **argv)
+{
+    options_t opt;
+    uint8_t *raw = NULL;
+    size_t raw_len = 0;
+    dump_t dump = { 0 };
+    replay_result_t res;
+    FILE *out = NULL;
+    int status = 0;
+
+    if (!parse_options(argc, argv, &opt))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (opt.self_test)
+    {
+        int fds[2];
+        if (pipe(fds) != 0) { perror("pipe"); return 1; }
+
+        pid_t child = fork();
+        if (child < 0) { perror("fork"); return 1; }
+        if (child == 0)
+        {
+            close(fds[0]);
+            self_test_record(fds[1], opt.seconds);
+            close(fds[1]);
+            _exit(0);
+        }
+        close(fds[1]);
+        FILE *pipe_in = fdopen(fds[0], "rb");
+        raw = read_all(pipe_in, &raw_len);
+        fclose(pipe_in);
+        waitpid(child, NULL, 0);
+    }
+    else if (opt.device != NULL)
+    {
+        raw = dump_request(&opt, &raw_len);
+        if (raw == NULL) return 1;
+    }
+    else
+    {
+        FILE *in = fopen(opt.input, "rb");
+        if (in == NULL) { perror(opt.input); return 1; }
+        raw = read_all(in, &raw_len);
+        fclose(in);
+    }
+
+    if (opt.save != NULL)
+    {
+        FILE *f = fopen(opt.save, "wb");
+        if (f == NULL || fwrite(raw, 1, raw_len, f) != raw_len) { perror(opt.save); status = 1; }
+        if (f != NULL) fclose(f);
+    }
+
+    if (!dump_parse(&dump, raw, raw_len))
+    {
+        fprintf(stderr, "incomplete log: %u of %u entries in %zu bytes\n", dump.received, dump.total, raw_len);
+        free(raw);
+        free(dump.entries);
+        return 1;
+    }
+    printf("log: %u entries, %zu bytes\n", dump.total, raw_len);
+
+    if (opt.output != NULL)
+    {
+        out = fopen(opt.output, "wb");
+        if (out == NULL) { perror(opt.output); return 1; }
+    }
+
+    if (!replay(dump.entries, dump.total, &opt, out, &res))
+    {
+        status = 1;
+    }
+    else
+    {
+        printf("replay: %u frames, %u verified, %u mismatched, %u commands, %u parameter blocks, %u keyframes%s\n",
+               res.frames, res.verified, res.mismatches, res.commands, res.params, res.keyframes,
+               res.wrapped ? " (ring wrapped: from the oldest kept keyframe)" : "");
+        if (res.mismatches != 0)
+        {
+            printf("replay: first mismatch at frame %u (tick %u)\n", res.first_bad, res.first_bad_tick);
+            status = 1;
+        }
+        if (res.frames != 0)
+        {
+            printf("render: %.1f us/frame average on this host; slowest:", res.total_ns / 1e3 / res.frames);
+            for (int i = 0; i < SLOWEST_FRAMES && res.slow_ns[i] != 0; i++)
+            {
+                printf(" frame %u (tick %u) %.1f us%s", res.slow_frame[i], res.slow_tick[i],
+                       res.slow_ns[i] / 1e3, (i + 1 < SLOWEST_FRAMES && res.slow_ns[i + 1] != 0) ? "," : "\n");
+            }
+        }
+    }
+
+    if (out != NULL) fclose(out);
+    free(raw);
+    free(dump.entries);
+    return status;
+}
@@ -0,0 +1,397 @@
+/**
+ * @file ws2812b_stream.c
+ * @brief Command-line frame streamer for the WS2812B serial protocol.
+ *
+ * Renders one of the firmware's own shaders (WS2812B_Stream.c, built for the
+ * host) or plays a raw frame file, and streams the frames to a serial device
+ * at a fixed rate, printing the achieved frame rate and throughput once per
+ * second.
+ *
+ * With --loopback no hardware is needed: the frames go through a
+ * pseudo-terminal into the firmware parser (WS2812B_Protocol.c) running in a
+ * second thread, and the run fails unless every frame was accepted, the last
+ * one arrived intact, and the status reply (CMD_STATUS) came back with the
+ * parser's own counts. -S prints the status of a real device instead of
+ * streaming.
+ *
+ * Build (from Color_Convert/; LED_NUM must match the firmware):
+ * @code
+ * make -C host LED_NUM=60 build/ws2812b_stream
+ * @endcode
+ *
+ * Usage:
+ * @code
+ * ./ws2812b_stream -d /dev/ttyUSB0 -b 230400 -f 25 -e rainbow -t 30
+ * ./ws2812b_stream -d /dev/ttyUSB0 -i frames.rgb -f 20 -r
+ * ./ws2812b_stream --loopback -f 50 -t 5
+ * ./ws2812b_stream -d /dev/ttyUSB0 -S
+ * @endcode
+ */
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include "ws2812b_host.h"
+#include "WS2812B_Control.h"
+#include "WS2812B_Frame.h"
+#include "WS2812B_Protocol.h"
+#include "WS2812B_Stream.h"
+#include "WS2812B_Tween.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Command-line options.
+ */
+typedef struct {
+    const char *device;
+    const char *input;          ///< Raw frame file (R, G, B per LED, frames back to back)
+    const char *effect;
+    uint32_t baud;
+    uint16_t leds;
+    double fps;
+    double seconds;             ///< 0 = until interrupted (or end of a non-looped file)
+    bool rle;
+    bool loopback;
+    bool quiet;
+    bool status;                ///< Print the device status and exit
+} options_t;
+
+/**
+ * @brief Built-in effects (the firmware's stream shaders).
+ */
+typedef struct {
+    const char *name;
+    ws2812b_shader_t shader;
+    ws2812b_shader_params_t params;
+} effect_t;
+
+static const effect_t effects[] = {
+    { "rainbow", WS2812B_Shader_Rainbow, { 0, 100, 80, 12, 3000 } },
+    { "breathe", WS2812B_Shader_Breathe, { 200, 100, 80, 0, 3000 } },
+    { "chase",   WS2812B_Shader_Chase,   { 30, 100, 80, 3, 600 } },
+};
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s (-d DEVICE | --loopback) [options]\n"
+            "  -d DEVICE    serial device\n"
+            "  -b BAUD      baud rate (default %d)\n"
+            "  -n LEDS      LEDs per frame (default %d)\n"
+            "  -f FPS       target frame rate (default 25)\n"
+            "  -t SECONDS   run time (default 10, 0 = forever)\n"
+            "  -e EFFECT    rainbow | breathe | chase (default rainbow)\n"
+            "  -i FILE      stream raw RGB frames from FILE (looped)\n"
+            "  -r           send run-length encoded frames when smaller\n"
+            "  -q           final report only\n"
+            "  -S           print the device status (CMD_STATUS) and exit\n"
+            "  --loopback   stream through a pseudo-terminal into the firmware parser\n",
+            prog, WS2812B_PROTOCOL_BAUD, LED_NUM);
+}
+
+static bool parse_options(int argc, char **argv, options_t *opt)
+{
+    *opt = (options_t){ .effect = "rainbow", .baud = WS2812B_PROTOCOL_BAUD, .leds = LED_NUM, .fps = 25.0, .seconds = 10.0 };
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(a, "--loopback") == 0) { opt->loopback = true; continue; }
+        if (strcmp(a, "-r") == 0) { opt->rle = true; continue; }
+        if (strcmp(a, "-q") == 0) { opt->quiet = true; continue; }
+        if (strcmp(a, "-S") == 0) { opt->status = true; continue; }
+        if (v == NULL) return false;
+
+        if (strcmp(a, "-d") == 0) opt->device = v;
+        else if (strcmp(a, "-i") == 0) opt->input = v;
+        else if (strcmp(a, "-e") == 0) opt->effect = v;
+        else if (strcmp(a, "-b") == 0) opt->baud = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "-n") == 0) opt->leds = (uint16_t)strtoul(v, NULL, 10);
+        else if (strcmp(a, "-f") == 0) opt->fps = strtod(v, NULL);
+        else if (strcmp(a, "-t") == 0) opt->seconds = strtod(v, NULL);
+        else return false;
+        i++;
+    }
+
+    return (opt->device != NULL) != opt->loopback && opt->fps > 0.0 && opt->leds > 0;
+}
+
+// ===================================================================
+// ============================= LOOPBACK ============================
+// ===================================================================
+
+static int loop_master = -1;
+static ws2812b_effects_t loop_effects;
+
+/**
+ * @brief Feed everything arriving on the pty master to the firmware parser
+ *        and run the queued commands, as the firmware render loop does.
+ * @note Ends when the slave side is closed (read fails with EIO).
+ */
+static void *loopback_reader(void *arg)
+{
+    uint8_t buf[4096];
+    (void)arg;
+
+    for (;;)
+    {
+        ssize_t n = read(loop_master, buf, sizeof(buf));
+        if (n > 0)
+        {
+            WS2812B_Protocol_FeedAt(buf, (uint32_t)n, HAL_GetTick());
+            WS2812B_Control_Apply(&loop_effects);
+        }
+        else if (n == 0 || errno != EINTR)
+        {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Create the pty pair; the slave path is what the streamer opens.
+ * @return Slave path, or NULL on error.
+ */
+static const char *loopback_open(void)
+{
+    loop_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (loop_master < 0 || grantpt(loop_master) != 0 || unlockpt(loop_master) != 0) return NULL;
+    return ptsname(loop_master);
+}
+
+/**
+ * @brief Start the firmware side: timing, command queue, replies on the pty master.
+ */
+static void loopback_start(void)
+{
+    static DMA_Channel_TypeDef channel = { .CNDTR = WS2812B_PROTOCOL_RX_SIZE };
+    static DMA_HandleTypeDef dma = { .Instance = &channel };
+    static UART_HandleTypeDef uart = { &dma };
+
+    WS2812B_InitTiming();
+    WS2812B_Host_SetUart(loop_master);
+    WS2812B_Protocol_Start(&uart);     // Fails to start DMA reception; the reader thread feeds the parser
+    WS2812B_Tween_Reset();
+}
+
+/**
+ * @brief Compare what the parser received with what was sent.
+ * @return true if every frame arrived and the last one is intact.
+ */
+static bool loopback_check(const ws2812b_host_t *host, const ws2812b_status_t *status, bool replied,
+                           const uint8_t *last, uint16_t leds)
+{
+    ws2812b_protocol_stats_t rx;
+    ws2812b_tween_stats_t tween;
+    uint16_t mismatched = 0;
+
+    WS2812B_Protocol_GetStats(&rx);
+    WS2812B_Tween_GetStats(&tween);
+    for (uint16_t i = 0; i < leds; i++)
+    {
+        uint8_t r, g, b;
+        WS2812B_Frame_GetPixelRGB(i, &r, &g, &b);
+        if (r != last[i * 3] || g != last[i * 3 + 1] || b != last[i * 3 + 2]) mismatched++;
+    }
+
+    printf("loopback: parser frames %u/%u, crc errors %u, length errors %u, decode errors %u, "
+           "dropped bytes %u, last frame %s\n",
+           rx.frames, host->stats.frames, rx.crc_errors, rx.length_errors, rx.decode_errors,
+           rx.dropped_bytes, mismatched ? "MISMATCH" : "intact");
+    printf("loopback: tween saw interval %u ms, jitter %u ms\n", tween.interval_ms, tween.jitter_ms);
+
+    bool status_ok = replied && status->clock_path == system_clock_path &&
+                     status->timer_period == htim3.Init.Period && status->protocol.frames == host->stats.frames &&
+                     status->protocol.commands == host->stats.commands;
+    printf("loopback: status reply %s\n", !replied ? "MISSING" : status_ok ? "matches" : "MISMATCH");
+
+    return rx.frames == host->stats.frames && rx.crc_errors == 0 && rx.length_errors == 0 &&
+           rx.decode_errors == 0 && rx.dropped_bytes == 0 && mismatched == 0 && status_ok;
+}
+
+// ===================================================================
+// =============================== MAIN ==============================
+// ===================================================================
+
+static void print_status(const ws2812b_status_t *st)
+{
+    static const char *const clock_names[] = { "HSE 72 MHz", "HSI 64 MHz (HSE failed)" };
+    const char *clock = (st->clock_path < 2) ? clock_names[st->clock_path] : "unknown";
+
+    printf("clock:   %s, TIM3 period %u ticks per bit (timer clock %.1f MHz)\n", clock, st->timer_period,
+           st->timer_period * 0.8);
+    printf("uptime:  %.1f s, output scale %u/256\n", st->uptime_ms / 1000.0, st->output_scale);
+    printf("parser:  %u packets, %u frames, %u commands; errors: crc %u, length %u, decode %u, uart %u; "
+           "dropped %u bytes\n",
+           st->protocol.packets, st->protocol.frames, st->protocol.commands, st->protocol.crc_errors,
+           st->protocol.length_errors, st->protocol.decode_errors, st->protocol.uart_errors,
+           st->protocol.dropped_bytes);
+    printf("tween:   %u frames, interval %u ms, jitter %u ms, latency %u ms (avg %u, max %u); "
+           "overflows %u, underruns %u, resyncs %u\n",
+           st->tween.frames, st->tween.interval_ms, st->tween.jitter_ms, st->tween.latency_ms,
+           st->tween.latency_avg_ms, st->tween.latency_max_ms, st->tween.overflows, st->tween.underruns,
+           st->tween.resyncs);
+    printf("current: %u mA (peak %u), limit %u mA, scale %u/256, %u frames limited, %u attacks\n",
+           st->current.current_ma, st->current.peak_ma, st->current.limit_ma, st->current.scale,
+           st->current.limited_frames, st->current.attacks);
+}
+
+static void report(const ws2812b_host_t *host, const options_t *opt, const char *prefix)
+{
+    double secs = host->stats.elapsed_us / 1e6;
+    if (secs <= 0.0) return;
+
+    double fps = host->stats.frames / secs;
+    double bps = host->stats.bytes / secs;
+    printf("%s%u frames in %.2f s: %.2f fps (target %.2f), %.1f kB/s", prefix, host->stats.frames, secs,
+           fps, opt->fps, bps / 1000.0);
+    if (host->baud != 0) printf(", line load %.0f%%", 100.0 * bps * 10.0 / host->baud);
+    printf(", late %u (max %.1f ms)\n", host->stats.late, host->stats.max_late_us / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    options_t opt;
+    const effect_t *effect = NULL;
+    FILE *input = NULL;
+    ws2812b_host_t host;
+    pthread_t reader;
+    int status = 0;
+
+    if (!parse_options(argc, argv, &opt))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    if (2U + 3U * opt.leds > WS2812B_PROTOCOL_MAX_PAYLOAD)
+    {
+        fprintf(stderr, "%u LEDs exceed the firmware frame size (LED_NUM %d)\n", opt.leds, LED_NUM);
+        return 2;
+    }
+
+    if (opt.input != NULL)
+    {
+        input = fopen(opt.input, "rb");
+        if (input == NULL) { perror(opt.input); return 1; }
+    }
+    else
+    {
+        for (size_t i = 0; i < sizeof(effects) / sizeof(effects[0]); i++)
+        {
+            if (strcmp(effects[i].name, opt.effect) == 0) effect = &effects[i];
+        }
+        if (effect == NULL) { usage(argv[0]); return 2; }
+    }
+
+    if (opt.loopback)
+    {
+        opt.device = loopback_open();
+        if (opt.device == NULL) { perror("pty"); return 1; }
+    }
+
+    if (!WS2812B_Host_Open(&host, opt.device, opt.loopback ? 0 : opt.baud))
+    {
+        perror(opt.device);
+        return 1;
+    }
+
+    if (opt.status)
+    {
+        ws2812b_status_t st;
+        if (!WS2812B_Host_RequestStatus(&host, &st, 1000))
+        {
+            fprintf(stderr, "%s: no status reply\n", opt.device);
+            status = 1;
+        }
+        else
+        {
+            print_status(&st);
+        }
+        WS2812B_Host_Close(&host);
+        return status;
+    }
+
+    if (opt.loopback)
+    {
+        // Start reading only once the slave is open: until then the master reads EIO
+        loopback_start();
+        pthread_create(&reader, NULL, loopback_reader, NULL);
+    }
+
+    uint32_t frame_bytes = 3U * opt.leds;
+    if (!opt.loopback && (frame_bytes + 2U + WS2812B_PROTOCOL_OVERHEAD) * 10.0 * opt.fps > opt.baud)
+    {
+        fprintf(stderr, "warning: %u fps of raw %u-LED frames exceed %u baud\n",
+                (unsigned)opt.fps, opt.leds, opt.baud);
+    }
+
+    uint8_t *rgb = calloc(frame_bytes, 1);
+    uint64_t frame_limit = (opt.seconds > 0.0) ? (uint64_t)(opt.seconds * opt.fps + 0.5) : 0;
+    uint64_t next_report = 1000000;
+
+    WS2812B_Host_PacerStart(&host, opt.fps);
+    for (uint64_t n = 0; frame_limit == 0 || n < frame_limit; n++)
+    {
+        if (input != NULL)
+        {
+            if (fread(rgb, 1, frame_bytes, input) != frame_bytes)
+            {
+                rewind(input);
+                if (fread(rgb, 1, frame_bytes, input) != frame_bytes)
+                {
+                    fprintf(stderr, "%s: shorter than one frame (%u bytes)\n", opt.input, frame_bytes);
+                    status = 1;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            uint32_t time = (uint32_t)(n * 1000.0 / opt.fps);
+            for (uint16_t i = 0; i < opt.leds; i++)
+            {
+                effect->shader(i, time, &effect->params, &rgb[i * 3], &rgb[i * 3 + 1], &rgb[i * 3 + 2]);
+            }
+        }
+
+        if (!WS2812B_Host_SendFrame(&host, rgb, opt.leds, opt.rle))
+        {
+            perror("write");
+            status = 1;
+            break;
+        }
+        WS2812B_Host_PacerWait(&host);
+
+        if (!opt.quiet && host.stats.elapsed_us >= next_report)
+        {
+            report(&host, &opt, "");
+            next_report += 1000000;
+        }
+    }
+
+    ws2812b_status_t device;
+    bool replied = opt.loopback && WS2812B_Host_RequestStatus(&host, &device, 1000);
+
+    WS2812B_Host_Close(&host);
+    report(&host, &opt, "total: ");
+
+    if (opt.loopback)
+    {
+        pthread_join(reader, NULL);
+        if (!loopback_check(&host, &device, replied, rgb, opt.leds)) status = 1;
+        close(loop_master);
+    }
+
+    if (input != NULL) fclose(input);
+    free(rgb);
+    return status;
+}
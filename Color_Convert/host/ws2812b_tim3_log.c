@@ -0,0 +1,74 @@
+/**
+ * @file ws2812b_tim3_log.c
+ * @brief Writes the TIM3 register writes of a few frames as a Renode peripheral-access log.
+ *
+ * Boots the timing the way main.c does (WS2812B_InitTiming() on the 72 MHz
+ * clock tree), logs the ARR write, then sends @c frames frames of a fixed
+ * test pattern with WS2812B_Send() and logs every CCR1 value the TIM3 DMA
+ * writes (WS2812B_Host_SetCcrHook(): the pwmData bytes read with the DMA
+ * width the firmware configured). Lines use the format of Renode's
+ * `sysbus LogPeripheralAccess`, so emulation/decode_ws2812b.py reads this
+ * output and a capture from emulation/bluepill_ws2812b.resc alike.
+ *
+ * The log emulation/testdata/tim3_sample.log is this output for LED_NUM=8;
+ * the decoder test (emulation/test_decode_ws2812b.py) checks it, and
+ * `make -C host check-emulation` fails when it no longer matches the encoder.
+ *
+ * Build and run (from Color_Convert/):
+ * @code
+ * make -C host LED_NUM=8 BUILD=build/led8 build/led8/ws2812b_tim3_log
+ * host/build/led8/ws2812b_tim3_log [frames] > tim3.log
+ * @endcode
+ */
+
+#include "ws2812b_host.h"
+#include "WS2812B.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TIM3_ARR_OFFSET     0x2CU
+#define TIM3_CCR1_OFFSET    0x34U
+
+/**
+ * @brief Test pattern color of @p led in frame @p frame.
+ * @note Covers 0x00, 0xFF and mixed bytes in every channel.
+ */
+static void pattern(int frame, int led, uint8_t *r, uint8_t *g, uint8_t *b)
+{
+    *r = (uint8_t)(led * 32 + frame * 8);
+    *g = (uint8_t)(0xFF - led * 32);
+    *b = (uint8_t)((frame * 0x55) ^ (led * 3));
+}
+
+static void log_write(uint32_t offset, const char *name, uint16_t value)
+{
+    printf("[INFO] timer3: WriteUInt32 to 0x%02X (%s), value 0x%X.\n", (unsigned)offset, name, (unsigned)value);
+}
+
+static void log_ccr1(uint16_t value)
+{
+    log_write(TIM3_CCR1_OFFSET, "CaptureCompare1", value);
+}
+
+int main(int argc, char **argv)
+{
+    int frames = (argc > 1) ? atoi(argv[1]) : 3;
+
+    system_clock_path = CLOCK_PATH_HSE_72MHZ;
+    WS2812B_Host_SetSysClock(72000000U);
+    WS2812B_InitTiming();
+    log_write(TIM3_ARR_OFFSET, "AutoReload", (uint16_t)htim3.Instance->ARR);
+
+    WS2812B_Host_SetCcrHook(log_ccr1);
+    for (int f = 0; f < frames; f++)
+    {
+        for (int i = 0; i < LED_NUM; i++)
+        {
+            uint8_t r, g, b;
+            pattern(f, i, &r, &g, &b);
+            WS2812B_SetPixelRGB((uint16_t)i, r, g, b);
+        }
+        WS2812B_Send();
+    }
+    return 0;
+}
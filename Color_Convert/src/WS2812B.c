@@ -11,23 +11,49 @@
  */
 
 #include "WS2812B.h"
+#include "WS2812B_Stream.h"
+#include "WS2812B_Warm.h"
 #include <stdlib.h>
+#include <string.h>
 
 // === Global Variables (must match main.c) ===
 extern TIM_HandleTypeDef htim3;
 extern DMA_HandleTypeDef hdma_tim3_ch1_trig;
-/** @brief PWM buffer for WS2812B data (24 bits per LED + 50 reset bits) */
-uint16_t pwmData[WS2812B_DATA_SIZE + 50];
+/**
+ * @brief PWM buffer for WS2812B data (24 bits per LED + 50 reset bits)
+ * @note Kept in .noinit so the last frame survives a warm reset (see WS2812B_Warm).
+ *       Must be cleared with WS2812B_Clear() on a cold boot.
+ */
+WS2812B_NOINIT ws2812b_pwm_t pwmData[WS2812B_DATA_SIZE + 50] __attribute__((aligned(4)));
+
+/** @brief PWM compare value for a "1" bit (~800 ns HIGH), see WS2812B_SetTiming() */
+static ws2812b_pwm_t bit1_pulse = 58;
+/** @brief PWM compare value for a "0" bit (~400 ns HIGH), see WS2812B_SetTiming() */
+static ws2812b_pwm_t bit0_pulse = 29;
+
+/** @brief Color scale applied by the encoder, Q8 (256 = none), see WS2812B_SetOutputScale() */
+static uint16_t output_scale = 256;
+
+/** @brief Mirror depth (log2 of the number of parts), see WS2812B_SetMirror() */
+static uint8_t mirror_levels = 0;
+/** @brief mirror_len[k] = LEDs rendered at depth k (mirror_len[0] = LED_NUM) */
+static uint16_t mirror_len[WS2812B_MIRROR_8 + 1] = { LED_NUM };
 
 /**
  * @brief DMA transmission complete callback.
  * @param htim Timer handle that triggered the callback.
- * @note Stops PWM to prevent re-triggering.
+ * @note Stops PWM to prevent re-triggering (single-shot mode) or refills
+ *       the second half of the circular buffer (streaming mode).
  */
-void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
+WS2812B_RAMFUNC void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
 {
     if (htim == &htim3)
     {
+        if (WS2812B_Stream_IsActive())
+        {
+            WS2812B_Stream_TransferComplete();
+            return;
+        }
         HAL_TIM_PWM_Stop_DMA(&htim3, TIM_CHANNEL_1);
     }
 }
@@ -35,51 +61,226 @@ void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
 /**
  * @brief Start DMA transmission of LED data to WS2812B strip.
  * @note Automatically sends WS2812B_DATA_SIZE + 50 bits (includes reset pulse).
+ *       Ignored while WS2812B_Stream is running.
  */
 void WS2812B_Send(void)
 {
+    if (WS2812B_Stream_IsActive()) return;  // DMA owned by the stream renderer
+
+    WS2812B_Warm_FrameSent();
     HAL_TIM_PWM_Start_DMA(&htim3, TIM_CHANNEL_1, (uint32_t*)pwmData, WS2812B_DATA_SIZE + 50);
 }
 
+// ===================================================================
+// ============================= MIRROR ==============================
+// ===================================================================
+
 /**
- * @brief Set a single LED pixel using RGB color.
- * @param pixel Pixel index (0 to LED_NUM - 1)
+ * @brief Select a mirror/kaleidoscope mode.
+ * @param mode @ref ws2812b_mirror_t (log2 of the number of parts)
+ * @note Each level halves the rendered length (rounded up), so an odd strip
+ *       keeps a single center LED.
+ */
+void WS2812B_SetMirror(ws2812b_mirror_t mode)
+{
+    if (mode > WS2812B_MIRROR_8) mode = WS2812B_MIRROR_8;
+
+    for (int level = 1; level <= (int)mode; level++)
+    {
+        mirror_len[level] = (uint16_t)((mirror_len[level - 1] + 1) / 2);
+    }
+    mirror_levels = (uint8_t)mode;
+}
+
+/**
+ * @brief Current mirror mode.
+ * @return @ref ws2812b_mirror_t
+ */
+ws2812b_mirror_t WS2812B_GetMirror(void)
+{
+    return (ws2812b_mirror_t)mirror_levels;
+}
+
+/**
+ * @brief Number of LEDs an effect has to render in the current mirror mode.
+ * @return LED_NUM without mirroring, ceil(LED_NUM / N) for N parts.
+ */
+uint16_t WS2812B_RenderLength(void)
+{
+    return mirror_len[mirror_levels];
+}
+
+/**
+ * @brief Replicate the rendered LEDs over the rest of the strip, mirrored.
+ * @note Works on encoded 24-slot blocks (one 24-byte copy per LED), expanding
+ *       one level at a time: the second part of each level is the reverse of
+ *       its first part. Called by the effects that render WS2812B_RenderLength()
+ *       LEDs; frames from the framebuffers, the tween and the warm resend are
+ *       sent as they are.
+ */
+WS2812B_RAMFUNC void WS2812B_ApplyMirror(void)
+{
+    for (int level = mirror_levels; level > 0; level--)
+    {
+        uint32_t src_len = mirror_len[level];
+        uint32_t dst_len = mirror_len[level - 1];
+
+        for (uint32_t p = src_len; p < dst_len; p++)
+        {
+            memcpy(&pwmData[p * 24], &pwmData[(dst_len - 1 - p) * 24], 24 * sizeof(ws2812b_pwm_t));
+        }
+    }
+}
+
+/**
+ * @brief Compute TIM3 period and bit pulse widths for a timer clock.
+ * @param timer_hz TIM3 input clock in Hz (prescaler 0)
+ * @param[out] timing Resulting auto-reload and compare values.
+ * @note Bit period = timer_hz / 800 kHz + 1 ticks; T1H = 800 ns and T0H = 400 ns,
+ *       rounded to the nearest tick. Gives the original 90/58/29 at 72 MHz.
+ */
+void WS2812B_ComputeTiming(uint32_t timer_hz, ws2812b_timing_t *timing)
+{
+    timing->period = (uint16_t)(timer_hz / 800000U);
+    uint32_t timer_khz = timer_hz / 1000U;
+    timing->t1h = (uint16_t)((timer_khz * 800U + 500000U) / 1000000U);
+    timing->t0h = (uint16_t)((timer_khz * 400U + 500000U) / 1000000U);
+}
+
+/**
+ * @brief Apply bit timings for the given TIM3 clock.
+ * @param timer_hz TIM3 input clock in Hz
+ * @note Call after MX_TIM3_Init() and whenever the clock tree changes.
+ *       Re-encode the frame afterwards (pulse widths are baked into pwmData).
+ */
+void WS2812B_SetTiming(uint32_t timer_hz)
+{
+    ws2812b_timing_t timing;
+    WS2812B_ComputeTiming(timer_hz, &timing);
+
+    htim3.Init.Period = timing.period;
+    __HAL_TIM_SET_AUTORELOAD(&htim3, timing.period);
+    bit1_pulse = (ws2812b_pwm_t)timing.t1h;
+    bit0_pulse = (ws2812b_pwm_t)timing.t0h;
+}
+
+/**
+ * @brief Detect the TIM3 clock from the RCC configuration and apply matching timings.
+ * @note APB1 timers run at 2 × PCLK1 whenever the APB1 prescaler is not 1.
+ *       Also switches the TIM3 DMA channel to byte reads from memory: it
+ *       zero-extends each pwmData byte into the 16-bit CCR1 write.
+ */
+void WS2812B_InitTiming(void)
+{
+    hdma_tim3_ch1_trig.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_tim3_ch1_trig.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    HAL_DMA_Init(&hdma_tim3_ch1_trig);
+
+    uint32_t timer_hz = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+    {
+        timer_hz *= 2U;
+    }
+    WS2812B_SetTiming(timer_hz);
+}
+
+/**
+ * @brief Set the color scale applied by the encoder.
+ * @param scale Q8 factor, 256 = full (clamped)
+ */
+void WS2812B_SetOutputScale(uint16_t scale)
+{
+    output_scale = (scale > 256) ? 256 : scale;
+}
+
+/**
+ * @brief Current color scale (Q8).
+ */
+uint16_t WS2812B_GetOutputScale(void)
+{
+    return output_scale;
+}
+
+/**
+ * @brief Encode one RGB color into 24 PWM compare values.
+ * @param dst Destination (24 entries)
  * @param red Red component (0–255)
  * @param green Green component (0–255)
  * @param blue Blue component (0–255)
- * @note Does nothing if pixel index is out of bounds.
  */
-void WS2812B_SetPixelRGB(uint16_t pixel, uint8_t red, uint8_t green, uint8_t blue)
+WS2812B_RAMFUNC void WS2812B_EncodeRGB(ws2812b_pwm_t *dst, uint8_t red, uint8_t green, uint8_t blue)
 {
-    if (pixel >= LED_NUM) return;
+    if (output_scale < 256)
+    {
+        red = (uint8_t)((red * output_scale) >> 8);
+        green = (uint8_t)((green * output_scale) >> 8);
+        blue = (uint8_t)((blue * output_scale) >> 8);
+    }
 
     // WS2812B uses GRB order
     uint32_t color = ((uint32_t)green << 16) | ((uint32_t)red << 8) | blue;
-    uint16_t pos = pixel * 24;
 
     for (int i = 0; i < 24; i++)
     {
         if (color & (1U << (23 - i)))
         {
-            pwmData[pos + i] = 58;  // High bit (~900ns HIGH)
+            dst[i] = bit1_pulse;  // High bit (~800ns HIGH)
         }
         else
         {
-            pwmData[pos + i] = 29;  // Low bit (~350ns HIGH)
+            dst[i] = bit0_pulse;  // Low bit (~400ns HIGH)
         }
     }
 }
 
+/**
+ * @brief Set a single LED pixel using RGB color.
+ * @param pixel Pixel index (0 to LED_NUM - 1)
+ * @param red Red component (0–255)
+ * @param green Green component (0–255)
+ * @param blue Blue component (0–255)
+ * @note Does nothing if pixel index is out of bounds.
+ */
+WS2812B_RAMFUNC void WS2812B_SetPixelRGB(uint16_t pixel, uint8_t red, uint8_t green, uint8_t blue)
+{
+    if (pixel >= LED_NUM) return;
+
+    WS2812B_EncodeRGB(&pwmData[pixel * 24], red, green, blue);
+}
+
+/**
+ * @brief Fill every LED with one color: encode once, then replicate.
+ * @param red Red (0–255)
+ * @param green Green (0–255)
+ * @param blue Blue (0–255)
+ * @note The first LED is encoded, then the filled region is doubled with
+ *       memcpy (word copies) until the strip is full: one encode plus
+ *       log2(LED_NUM) copies instead of LED_NUM encodes. Also zeroes the
+ *       reset tail.
+ */
+WS2812B_RAMFUNC static void fill_rgb(uint8_t red, uint8_t green, uint8_t blue)
+{
+    WS2812B_EncodeRGB(pwmData, red, green, blue);
+
+    uint32_t filled = 24;
+    while (filled < WS2812B_DATA_SIZE)
+    {
+        uint32_t chunk = (filled <= WS2812B_DATA_SIZE - filled) ? filled : (WS2812B_DATA_SIZE - filled);
+        memcpy(&pwmData[filled], pwmData, chunk * sizeof(ws2812b_pwm_t));
+        filled += chunk;
+    }
+
+    // Ensure reset tail is zero
+    memset(&pwmData[WS2812B_DATA_SIZE], 0, 50 * sizeof(ws2812b_pwm_t));
+}
+
 /**
  * @brief Turn off all LEDs by setting them to black.
  * @note Also ensures the 50+ reset bits at the end are zero.
  */
 void WS2812B_Clear(void)
 {
-    for (int i = 0; i < WS2812B_DATA_SIZE + 50; i++)
-    {
-        pwmData[i] = (i < WS2812B_DATA_SIZE) ? 29 : 0;
-    }
+    fill_rgb(0, 0, 0);
 }
 
 /**
@@ -90,15 +291,7 @@ void WS2812B_Clear(void)
  */
 void WS2812B_SetColorRGB(uint8_t red, uint8_t green, uint8_t blue)
 {
-    for (int led = 0; led < LED_NUM; led++)
-    {
-        WS2812B_SetPixelRGB(led, red, green, blue);
-    }
-    // Ensure reset tail is zero
-    for (int i = WS2812B_DATA_SIZE; i < WS2812B_DATA_SIZE + 50; i++)
-    {
-        pwmData[i] = 0;
-    }
+    fill_rgb(red, green, blue);
 }
 
 // ===================================================================
@@ -115,7 +308,7 @@ void WS2812B_SetColorRGB(uint8_t red, uint8_t green, uint8_t blue)
  * @param[out] b Pointer to blue output (0–255)
  * @note Based on common HSV-to-RGB algorithm. Uses integer arithmetic.
  */
-static void hsv_to_rgb(uint16_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b)
+WS2812B_RAMFUNC static void hsv_to_rgb(uint16_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b)
 {
     if (s == 0)
     {
@@ -146,6 +339,52 @@ static void hsv_to_rgb(uint16_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g,
     }
 }
 
+/**
+ * @brief Divide 0..65535 by 255 with a shift (exact for that range).
+ */
+static inline uint32_t div255(uint32_t x)
+{
+    return (x + 1U + (x >> 8)) >> 8;
+}
+
+/**
+ * @brief Convert HSV with a 16-bit hue to RGB.
+ * @param h Hue as a binary angle (0–65535 = 0–360°)
+ * @param s Saturation in percent (0–100)
+ * @param v Value (brightness) in percent (0–100)
+ * @param[out] r Pointer to red output (0–255)
+ * @param[out] g Pointer to green output (0–255)
+ * @param[out] b Pointer to blue output (0–255)
+ * @note Sector and the 16-bit position inside it come from one multiply
+ *       (h * 6), so the ramps are interpolated at ~0.0055° resolution.
+ *       Only multiplies and shifts besides the two percent scalings; every
+ *       product is rounded, which keeps each channel within 1.4 of the
+ *       float conversion. Unlike hsv_to_rgb(), q and t include saturation.
+ */
+WS2812B_RAMFUNC static void hsv16_to_rgb(uint16_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b)
+{
+    uint32_t v255 = (v * 255U + 50U) / 100U;
+    uint32_t s255 = (s * 255U + 50U) / 100U;
+    uint32_t vs = v255 * s255;              // 0–65025
+    uint32_t pos = (uint32_t)h * 6U;
+    uint32_t f = pos & 0xFFFFU;             // Position inside the sector
+
+    uint8_t p = (uint8_t)(v255 - div255(vs + 127U));
+    uint8_t q = (uint8_t)(v255 - div255(((vs * f + 0x8000U) >> 16) + 127U));
+    uint8_t t = (uint8_t)(v255 - div255(((vs * (0x10000U - f) + 0x8000U) >> 16) + 127U));
+    uint8_t vv = (uint8_t)v255;
+
+    switch (pos >> 16)
+    {
+        case 0: *r = vv; *g = t;  *b = p;  break;
+        case 1: *r = q;  *g = vv; *b = p;  break;
+        case 2: *r = p;  *g = vv; *b = t;  break;
+        case 3: *r = p;  *g = q;  *b = vv; break;
+        case 4: *r = t;  *g = p;  *b = vv; break;
+        default: *r = vv; *g = p; *b = q;  break;
+    }
+}
+
 /**
  * @brief Helper function for HSL-to-RGB conversion.
  * @param p First intermediate value
@@ -153,7 +392,7 @@ static void hsv_to_rgb(uint16_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g,
  * @param t Hue segment (0–255)
  * @return RGB component (0–255)
  */
-static uint8_t hue2rgb(uint8_t p, uint8_t q, uint8_t t)
+WS2812B_RAMFUNC static uint8_t hue2rgb(uint8_t p, uint8_t q, uint8_t t)
 {
     if (t < 43)      return p + (((q - p) * t) / 43);
     else if (t < 128) return q;
@@ -171,7 +410,7 @@ static uint8_t hue2rgb(uint8_t p, uint8_t q, uint8_t t)
  * @param[out] b Pointer to blue output (0–255)
  * @note Uses standard HSL-to-RGB algorithm with integer math.
  */
-static void hsl_to_rgb(uint16_t h, uint8_t s, uint8_t l, uint8_t *r, uint8_t *g, uint8_t *b)
+WS2812B_RAMFUNC static void hsl_to_rgb(uint16_t h, uint8_t s, uint8_t l, uint8_t *r, uint8_t *g, uint8_t *b)
 {
     if (s == 0)
     {
@@ -203,6 +442,48 @@ static void hsl_to_rgb(uint16_t h, uint8_t s, uint8_t l, uint8_t *r, uint8_t *g,
     *b = hue2rgb(p, q, (h255 + 171U) % 256U); // +240° → +171 in 0–255
 }
 
+/**
+ * @brief Convert HSV to RGB without touching the strip.
+ * @param hue Hue (0–359)
+ * @param sat Saturation (0–100%)
+ * @param val Value (0–100%)
+ * @param[out] red Red output (0–255)
+ * @param[out] green Green output (0–255)
+ * @param[out] blue Blue output (0–255)
+ */
+WS2812B_RAMFUNC void WS2812B_HSVToRGB(uint16_t hue, uint8_t sat, uint8_t val, uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    hsv_to_rgb(hue, sat, val, red, green, blue);
+}
+
+/**
+ * @brief Convert HSV with a 16-bit hue to RGB without touching the strip.
+ * @param hue16 Hue (0–65535 = 0–360°, see WS2812B_HUE16())
+ * @param sat Saturation (0–100%)
+ * @param val Value (0–100%)
+ * @param[out] red Red output (0–255)
+ * @param[out] green Green output (0–255)
+ * @param[out] blue Blue output (0–255)
+ */
+WS2812B_RAMFUNC void WS2812B_HSV16ToRGB(uint16_t hue16, uint8_t sat, uint8_t val, uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    hsv16_to_rgb(hue16, sat, val, red, green, blue);
+}
+
+/**
+ * @brief Convert HSL to RGB without touching the strip.
+ * @param hue Hue (0–359)
+ * @param sat Saturation (0–100%)
+ * @param light Lightness (0–100%)
+ * @param[out] red Red output (0–255)
+ * @param[out] green Green output (0–255)
+ * @param[out] blue Blue output (0–255)
+ */
+WS2812B_RAMFUNC void WS2812B_HSLToRGB(uint16_t hue, uint8_t sat, uint8_t light, uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    hsl_to_rgb(hue, sat, light, red, green, blue);
+}
+
 // ===================================================================
 // ==================== PUBLIC HSV FUNCTIONS =========================
 // ===================================================================
@@ -234,6 +515,33 @@ void WS2812B_SetPixelHSV(uint16_t pixel, uint16_t hue, uint8_t sat, uint8_t val)
     WS2812B_SetPixelRGB(pixel, r, g, b);
 }
 
+/**
+ * @brief Set all LEDs to an HSV color with a 16-bit hue.
+ * @param hue16 Hue (0–65535 = 0–360°)
+ * @param sat Saturation (0–100%)
+ * @param val Value/brightness (0–100%)
+ */
+void WS2812B_SetColorHSV16(uint16_t hue16, uint8_t sat, uint8_t val)
+{
+    uint8_t r, g, b;
+    hsv16_to_rgb(hue16, sat, val, &r, &g, &b);
+    WS2812B_SetColorRGB(r, g, b);
+}
+
+/**
+ * @brief Set a single LED to an HSV color with a 16-bit hue.
+ * @param pixel Pixel index (0 to LED_NUM - 1)
+ * @param hue16 Hue (0–65535 = 0–360°)
+ * @param sat Saturation (0–100%)
+ * @param val Value (0–100%)
+ */
+void WS2812B_SetPixelHSV16(uint16_t pixel, uint16_t hue16, uint8_t sat, uint8_t val)
+{
+    uint8_t r, g, b;
+    hsv16_to_rgb(hue16, sat, val, &r, &g, &b);
+    WS2812B_SetPixelRGB(pixel, r, g, b);
+}
+
 // ===================================================================
 // ==================== PUBLIC HSL FUNCTIONS =========================
 // ===================================================================
@@ -294,4 +602,102 @@ void WS2812B_RainbowClassic(void)
         }
     }
     WS2812B_Send();
-}
\ No newline at end of file
+}
+
+/**
+ * @brief One step of the xorshift32 generator used by the fire effect.
+ * @note Fixed seed: the flicker sequence after reset is always the same, so a
+ *       recorded session replays identically (see WS2812B_Record.h).
+ */
+static uint32_t fire_state = 0x2545F491U;
+
+static uint32_t fire_random(void)
+{
+    fire_state ^= fire_state << 13;
+    fire_state ^= fire_state >> 17;
+    fire_state ^= fire_state << 5;
+    return fire_state;
+}
+
+/**
+ * @brief Generator state of the fire effect (WS2812B_Warm and WS2812B_Record snapshots).
+ */
+uint32_t WS2812B_GetFireSeed(void)
+{
+    return fire_state;
+}
+
+/**
+ * @brief Restore the generator state of the fire effect.
+ * @param seed Value from WS2812B_GetFireSeed(); 0 would stop the generator and is ignored.
+ */
+void WS2812B_SetFireSeed(uint32_t seed)
+{
+    if (seed != 0) fire_state = seed;
+}
+
+/**
+ * @brief Flickering fire: every LED gets a random red-orange hue and brightness.
+ * @note Only renders; the caller sends the frame.
+ */
+void WS2812B_FireEffect(void)
+{
+    for (int i = 0; i < LED_NUM; i++)
+    {
+        uint32_t rnd = fire_random();
+        WS2812B_SetPixelHSV(i, (uint16_t)(rnd % 41U), 100, (uint8_t)(40U + (rnd >> 8) % 61U));
+    }
+}
+
+/**
+ * @brief Pastel color loop: the whole strip in one soft HSL color.
+ * @param hue Current hue (0–359), advanced by one degree per call
+ * @note Only renders; the caller sends the frame.
+ */
+void WS2812B_PastelLoop(uint16_t *hue)
+{
+    WS2812B_SetColorHSL(*hue, 60, 80);
+    *hue = (*hue + 1U) % 360U;
+}
+
+/**
+ * @brief Simple theater chase with a 16-bit hue.
+ * @param hue16 Color hue (0–65535 = 0–360°)
+ * @param frame Chase phase (0–2)
+ * @note Only renders; the caller sends the frame.
+ */
+void WS2812B_TheaterChaseHSV16(uint16_t hue16, uint8_t frame)
+{
+    for (int i = 0; i < LED_NUM; i++)
+    {
+        if ((i % 3) == frame % 3)
+        {
+            WS2812B_SetPixelHSV16(i, hue16, 100, 100);
+        }
+        else
+        {
+            WS2812B_SetPixelRGB(i, 0, 0, 0);
+        }
+    }
+}
+
+/**
+ * @brief Simple theater chase: every third LED lit, the others off.
+ * @param hue Color hue (0–359)
+ * @param frame Chase phase (0–2)
+ * @note Only renders; the caller sends the frame.
+ */
+void WS2812B_TheaterChaseSimple(uint16_t hue, uint8_t frame)
+{
+    for (int i = 0; i < LED_NUM; i++)
+    {
+        if ((i % 3) == frame % 3)
+        {
+            WS2812B_SetPixelHSV(i, hue, 100, 100);
+        }
+        else
+        {
+            WS2812B_SetPixelRGB(i, 0, 0, 0);
+        }
+    }
+}
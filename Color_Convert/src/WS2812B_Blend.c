@@ -0,0 +1,172 @@
+/**
+ * @file WS2812B_Blend.c
+ * @brief Hue-arc interpolation and the HSV framebuffer.
+ *
+ * Hues are 16-bit binary angles, so the difference of two hues modulo 65536
+ * is the clockwise distance and the arc choice is a single comparison.
+ */
+
+#include "WS2812B_Blend.h"
+
+/** @brief HSV framebuffer, converted to RGB at encode time. */
+static ws2812b_hsv_t hsv_frame[LED_NUM];
+
+/**
+ * @brief Lerp two 0–255 (or 0–100) components, 255 = @p b exactly.
+ */
+static inline uint8_t lerp8(uint8_t a, uint8_t b, uint8_t amount)
+{
+    return (uint8_t)(a + ((int32_t)(b - a) * amount) / 255);
+}
+
+/**
+ * @brief Interpolate between two hues along the given arc.
+ * @return Blended hue (16-bit).
+ */
+WS2812B_RAMFUNC uint16_t WS2812B_Blend_Hue(uint16_t from, uint16_t to, uint8_t amount, ws2812b_hue_path_t path)
+{
+    int32_t delta = (uint16_t)(to - from);  // Clockwise distance, 0–65535
+
+    switch (path)
+    {
+        case WS2812B_HUE_SHORTEST:
+            if (delta > 0x8000) delta -= 0x10000;
+            break;
+        case WS2812B_HUE_CCW:
+            if (delta != 0) delta -= 0x10000;
+            break;
+        case WS2812B_HUE_CW:
+        default:
+            break;
+    }
+
+    return (uint16_t)(from + (delta * amount) / 255);
+}
+
+/**
+ * @brief Interpolate between two HSV colors.
+ * @return Blended color.
+ */
+WS2812B_RAMFUNC ws2812b_hsv_t WS2812B_Blend_HSV(ws2812b_hsv_t from, ws2812b_hsv_t to, uint8_t amount, ws2812b_hue_path_t path)
+{
+    ws2812b_hsv_t out;
+
+    // A grey has no hue: travel from/to the other end's hue instead
+    if (from.sat == 0 || from.val == 0) from.hue = to.hue;
+    if (to.sat == 0 || to.val == 0) to.hue = from.hue;
+
+    out.hue = WS2812B_Blend_Hue(from.hue, to.hue, amount, path);
+    out.sat = lerp8(from.sat, to.sat, amount);
+    out.val = lerp8(from.val, to.val, amount);
+    return out;
+}
+
+/**
+ * @brief Interpolate between two RGB colors component-wise.
+ */
+WS2812B_RAMFUNC void WS2812B_Blend_RGB(const uint8_t from[3], const uint8_t to[3], uint8_t amount, uint8_t out[3])
+{
+    out[0] = lerp8(from[0], to[0], amount);
+    out[1] = lerp8(from[1], to[1], amount);
+    out[2] = lerp8(from[2], to[2], amount);
+}
+
+// ===================================================================
+// ========================== HSV FRAMEBUFFER ========================
+// ===================================================================
+
+/**
+ * @brief Set one LED of the HSV framebuffer.
+ * @note Does nothing if pixel index is out of bounds.
+ */
+void WS2812B_HSVFrame_SetPixel(uint16_t pixel, ws2812b_hsv_t color)
+{
+    if (pixel >= LED_NUM) return;
+    hsv_frame[pixel] = color;
+}
+
+/**
+ * @brief Read one LED of the HSV framebuffer.
+ */
+ws2812b_hsv_t WS2812B_HSVFrame_GetPixel(uint16_t pixel)
+{
+    if (pixel >= LED_NUM)
+    {
+        ws2812b_hsv_t black = { 0, 0, 0 };
+        return black;
+    }
+    return hsv_frame[pixel];
+}
+
+/**
+ * @brief Set every LED to the same HSV color.
+ */
+void WS2812B_HSVFrame_Fill(ws2812b_hsv_t color)
+{
+    for (uint16_t i = 0; i < LED_NUM; i++)
+    {
+        hsv_frame[i] = color;
+    }
+}
+
+/**
+ * @brief Direct access to the framebuffer.
+ */
+ws2812b_hsv_t* WS2812B_HSVFrame_Buffer(void)
+{
+    return hsv_frame;
+}
+
+/**
+ * @brief Crossfade two HSV frames into the framebuffer.
+ */
+WS2812B_RAMFUNC void WS2812B_HSVFrame_Crossfade(const ws2812b_hsv_t *from, const ws2812b_hsv_t *to,
+                                                uint8_t amount, ws2812b_hue_path_t path)
+{
+    for (uint16_t i = 0; i < LED_NUM; i++)
+    {
+        hsv_frame[i] = WS2812B_Blend_HSV(from[i], to[i], amount, path);
+    }
+}
+
+/**
+ * @brief Convert and encode the HSV framebuffer into the PWM buffer.
+ */
+WS2812B_RAMFUNC void WS2812B_HSVFrame_Encode(void)
+{
+    ws2812b_pwm_t *dst = pwmData;
+
+    for (uint16_t i = 0; i < LED_NUM; i++, dst += 24)
+    {
+        uint8_t r, g, b;
+        WS2812B_HSV16ToRGB(hsv_frame[i].hue, hsv_frame[i].sat, hsv_frame[i].val, &r, &g, &b);
+        WS2812B_EncodeRGB(dst, r, g, b);
+    }
+}
+
+/**
+ * @brief Encode and transmit the HSV framebuffer.
+ */
+void WS2812B_HSVFrame_Show(void)
+{
+    WS2812B_HSVFrame_Encode();
+    WS2812B_Send();
+}
+
+/**
+ * @brief Pixel shader converting the HSV framebuffer.
+ * @note LEDs beyond LED_NUM are black. ctx is unused.
+ */
+WS2812B_RAMFUNC void WS2812B_Shader_HSVFrame(uint16_t index, uint32_t time, const void *ctx,
+                                             uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    (void)time;
+    (void)ctx;
+
+    if (index >= LED_NUM)
+    {
+        *red = *green = *blue = 0;
+        return;
+    }
+    WS2812B_HSV16ToRGB(hsv_frame[index].hue, hsv_frame[index].sat, hsv_frame[index].val, red, green, blue);
+}
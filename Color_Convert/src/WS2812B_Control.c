@@ -0,0 +1,331 @@
+/**
+ * @file WS2812B_Control.c
+ * @brief Sequence-counter parameter block and SPSC command queues.
+ *
+ * Parameter block: the producer writes the buffer the reader is NOT pointed
+ * at, then bumps the sequence; the reader copies buffer[seq & 1] and retries
+ * only if the producer published twice meanwhile (which could overwrite the
+ * buffer being read). The producer never waits; on a single-core M3 with the
+ * producer in an ISR the reader retries at most once per interrupt.
+ */
+
+#include "WS2812B_Control.h"
+#include "WS2812B_Preset.h"
+#include "WS2812B_Playlist.h"
+#include "WS2812B_Record.h"
+#include "WS2812B_Current.h"
+#include "WS2812B_Protocol.h"
+
+_Static_assert((WS2812B_CMD_QUEUE_SIZE & (WS2812B_CMD_QUEUE_SIZE - 1)) == 0,
+               "WS2812B_CMD_QUEUE_SIZE must be a power of two");
+
+#define CMD_QUEUE_MASK          (WS2812B_CMD_QUEUE_SIZE - 1)
+#define CONTROL_MAX_QUEUES      4
+
+static ws2812b_params_t params_buf[2];
+static volatile uint32_t params_seq = 0;
+
+static ws2812b_cmd_queue_t default_queue;
+static ws2812b_cmd_queue_t *queues[CONTROL_MAX_QUEUES] = { &default_queue };
+
+static uint32_t applied_seq = 0;
+static bool output_enabled = true;
+
+// ===================================================================
+// ========================= PARAMETER BLOCK =========================
+// ===================================================================
+
+/**
+ * @brief Publish a complete parameter set.
+ * @param params New parameters.
+ * @note Single producer only. Wait-free, safe from any interrupt priority.
+ */
+void WS2812B_Params_Publish(const ws2812b_params_t *params)
+{
+    uint32_t next = params_seq + 1;
+    params_buf[next & 1] = *params;
+    __DMB();
+    params_seq = next;
+}
+
+/**
+ * @brief Take a consistent snapshot of the latest parameters.
+ * @param[out] params Snapshot.
+ * @return Sequence number of the snapshot (0 = nothing published yet).
+ */
+uint32_t WS2812B_Params_Snapshot(ws2812b_params_t *params)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = params_seq;
+        __DMB();
+        *params = params_buf[seq & 1];
+        __DMB();
+    } while (params_seq - seq >= 2);
+
+    return seq;
+}
+
+// ===================================================================
+// ========================== COMMAND QUEUE ==========================
+// ===================================================================
+
+/**
+ * @brief Reset a command queue to empty.
+ * @param queue Queue to reset (call before the producer starts).
+ */
+void WS2812B_CmdQueue_Init(ws2812b_cmd_queue_t *queue)
+{
+    queue->head = 0;
+    queue->tail = 0;
+}
+
+/**
+ * @brief Push a command (producer side).
+ * @param queue Queue
+ * @param type @ref ws2812b_cmd_type_t
+ * @param value Command argument
+ * @return false if the queue is full (command dropped).
+ */
+bool WS2812B_CmdQueue_Push(ws2812b_cmd_queue_t *queue, uint8_t type, int32_t value)
+{
+    uint16_t head = queue->head;
+    if ((uint16_t)(head - queue->tail) >= WS2812B_CMD_QUEUE_SIZE) return false;
+
+    ws2812b_cmd_t *slot = &queue->buf[head & CMD_QUEUE_MASK];
+    slot->type = type;
+    slot->value = value;
+    __DMB();
+    queue->head = head + 1;
+    return true;
+}
+
+/**
+ * @brief Pop a command (consumer side).
+ * @param queue Queue
+ * @param[out] cmd Dequeued command
+ * @return false if the queue is empty.
+ */
+bool WS2812B_CmdQueue_Pop(ws2812b_cmd_queue_t *queue, ws2812b_cmd_t *cmd)
+{
+    uint16_t tail = queue->tail;
+    if (tail == queue->head) return false;
+
+    __DMB();
+    *cmd = queue->buf[tail & CMD_QUEUE_MASK];
+    __DMB();
+    queue->tail = tail + 1;
+    return true;
+}
+
+/**
+ * @brief Post a command to the default queue.
+ * @param type @ref ws2812b_cmd_type_t
+ * @param value Command argument
+ * @return false if the queue is full.
+ * @note One producer context only; other sources use WS2812B_Control_AddQueue().
+ */
+bool WS2812B_Control_Post(uint8_t type, int32_t value)
+{
+    return WS2812B_CmdQueue_Push(&default_queue, type, value);
+}
+
+/**
+ * @brief Register an extra queue drained by WS2812B_Control_Apply().
+ * @param queue Queue owned by another producer.
+ * @return false if no registration slot is left.
+ * @note Call during initialization, before the producer is enabled.
+ */
+bool WS2812B_Control_AddQueue(ws2812b_cmd_queue_t *queue)
+{
+    for (int i = 0; i < CONTROL_MAX_QUEUES; i++)
+    {
+        if (queues[i] == queue) return true;
+        if (queues[i] == NULL)
+        {
+            WS2812B_CmdQueue_Init(queue);
+            queues[i] = queue;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ===================================================================
+// ============================ RENDERER =============================
+// ===================================================================
+
+/**
+ * @brief Clamp a value to a range.
+ */
+static int32_t clamp(int32_t value, int32_t lo, int32_t hi)
+{
+    return (value < lo) ? lo : (value > hi) ? hi : value;
+}
+
+/**
+ * @brief Store the current engine state in a user preset slot, named "User <n>".
+ * @note Erases and reprograms the presets page when the slot is in use,
+ *       which stalls the render loop for one page erase (20–40 ms).
+ */
+static void control_save_preset(const ws2812b_effects_t *effects, uint8_t slot)
+{
+    char name[WS2812B_PRESET_NAME_LEN] = "User ";
+    uint8_t n = (uint8_t)(slot + 1U);
+    ws2812b_preset_t preset;
+
+    if (n >= 10) name[5] = (char)('0' + n / 10U);
+    name[(n >= 10) ? 6 : 5] = (char)('0' + n % 10U);
+
+    WS2812B_Preset_Capture(effects, name, &preset);
+    WS2812B_Preset_Save(slot, &preset);
+}
+
+/**
+ * @brief Apply a single command immediately.
+ * @param effects Effect state owned by the render loop.
+ * @param type @ref ws2812b_cmd_type_t
+ * @param value Command argument
+ * @note Render-loop context only. Unknown commands are ignored.
+ */
+void WS2812B_Control_Execute(ws2812b_effects_t *effects, uint8_t type, int32_t value)
+{
+    WS2812B_Record_Command(type, value);
+
+    switch (type)
+    {
+        case CMD_SET_EFFECT:
+            if (value >= 0 && value < WS2812B_EFFECT_COUNT)
+            {
+                WS2812B_Effects_SetEffect(effects, (ws2812b_effect_t)value);
+            }
+            break;
+
+        case CMD_NEXT_EFFECT:
+            WS2812B_Effects_SetEffect(effects, (ws2812b_effect_t)((effects->current_effect + 1) % WS2812B_EFFECT_CYCLE_COUNT));
+            break;
+
+        case CMD_SET_HUE:
+            value %= 360;
+            effects->hue = (uint16_t)((value < 0) ? value + 360 : value);
+            break;
+
+        case CMD_SET_HUE_STEP:
+            effects->hue_step = (uint16_t)clamp(value, 0, 0xFFFF);
+            break;
+
+        case CMD_SET_BRIGHTNESS:
+            effects->brightness = (uint8_t)clamp(value, 0, 100);
+            WS2812B_SetBrightness(effects->brightness);
+            break;
+
+        case CMD_ADJUST_BRIGHTNESS:
+            effects->brightness = (uint8_t)clamp((int32_t)WS2812B_GetBrightness() + value, 0, 100);
+            WS2812B_SetBrightness(effects->brightness);
+            break;
+
+        case CMD_SET_SPEED:
+            effects->effect_speed = (uint32_t)clamp(value, 1, 100);
+            WS2812B_SetSpeed((uint8_t)effects->effect_speed);
+            break;
+
+        case CMD_SET_AUTO_CYCLE:
+            effects->auto_cycle = (value != 0);
+            break;
+
+        case CMD_POWER:
+            output_enabled = (value < 0) ? !output_enabled : (value != 0);
+            break;
+
+        case CMD_RECALL_PRESET:
+            WS2812B_Preset_Recall(effects, (uint8_t)(value & 0xFF), (uint16_t)((uint32_t)value >> 8));
+            break;
+
+        case CMD_SAVE_PRESET:
+            if (value >= 0 && value < WS2812B_PRESET_USER_SLOTS)
+            {
+                control_save_preset(effects, (uint8_t)value);
+            }
+            break;
+
+        case CMD_SET_MIRROR:
+            WS2812B_SetMirror((ws2812b_mirror_t)clamp(value, WS2812B_MIRROR_NONE, WS2812B_MIRROR_8));
+            break;
+
+        case CMD_PLAYLIST:
+            switch (value)
+            {
+                case PLAYLIST_STOP:  WS2812B_Playlist_Stop(); break;
+                case PLAYLIST_START: WS2812B_Playlist_Start(); break;
+                case PLAYLIST_NEXT:  WS2812B_Playlist_Next(); break;
+                case PLAYLIST_SAVE:  WS2812B_Playlist_Save(); break;
+                default: break;
+            }
+            break;
+
+        case CMD_RECORD:
+            switch (value)
+            {
+                case RECORD_STOP:  WS2812B_Record_Stop(); break;
+                case RECORD_START: WS2812B_Record_Start(effects, output_enabled); break;
+                case RECORD_DUMP:  WS2812B_Record_Dump(); break;
+                default: break;
+            }
+            break;
+
+        case CMD_SET_CURRENT_LIMIT:
+            WS2812B_Current_SetLimit((uint16_t)((value < 0) ? 0 : (value > 0xFFFF) ? 0xFFFF : value));
+            break;
+
+        case CMD_STATUS:
+            WS2812B_Protocol_SendStatus();
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Apply new parameters and queued commands to the effect state.
+ * @param effects Effect state owned by the render loop.
+ * @return true if output is enabled, false if the strip is switched off.
+ * @note Call once per frame from the render loop. Each queue is drained by at
+ *       most WS2812B_CMD_QUEUE_SIZE commands so a flooding producer cannot stall
+ *       the frame.
+ */
+bool WS2812B_Control_Apply(ws2812b_effects_t *effects)
+{
+    ws2812b_params_t params;
+    uint32_t seq = WS2812B_Params_Snapshot(&params);
+
+    if (seq != applied_seq)
+    {
+        applied_seq = seq;
+        WS2812B_Record_Params(&params);
+        if (params.effect < WS2812B_EFFECT_COUNT)
+        {
+            effects->current_effect = params.effect;
+        }
+        effects->hue = params.hue % 360;
+        effects->brightness = (uint8_t)clamp(params.brightness, 0, 100);
+        effects->effect_speed = (uint32_t)clamp(params.speed, 1, 100);
+        effects->auto_cycle = params.auto_cycle;
+        effects->cycle_duration = params.cycle_duration;
+        WS2812B_SetBrightness(effects->brightness);
+        WS2812B_SetSpeed((uint8_t)effects->effect_speed);
+    }
+
+    for (int i = 0; i < CONTROL_MAX_QUEUES && queues[i] != NULL; i++)
+    {
+        ws2812b_cmd_t cmd;
+        for (int n = 0; n < WS2812B_CMD_QUEUE_SIZE && WS2812B_CmdQueue_Pop(queues[i], &cmd); n++)
+        {
+            WS2812B_Control_Execute(effects, cmd.type, cmd.value);
+        }
+    }
+
+    return output_enabled;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file WS2812B_Current.c
+ * @brief Supply current limiter: PI controller with fast attack, ADC/DMA averaging.
+ *
+ * The integrator holds the scale in Q16 (scale << 8) so that small
+ * corrections near the limit are not lost to truncation; the output is the
+ * integrator plus the proportional term, clamped to [SCALE_MIN, 256].
+ */
+
+#include "WS2812B_Current.h"
+
+#define SCALE_FULL  256
+#define ERR_MAX     256     ///< Error clamp, Q8 of the setpoint (+-100%)
+
+_Static_assert(WS2812B_CURRENT_SCALE_MIN > 0 && WS2812B_CURRENT_SCALE_MIN < SCALE_FULL,
+               "WS2812B_CURRENT_SCALE_MIN must be in 1..255");
+
+static ADC_HandleTypeDef *current_adc = NULL;
+static volatile uint16_t current_buf[WS2812B_CURRENT_SAMPLES];
+
+static uint16_t current_limit = WS2812B_CURRENT_LIMIT_MA;
+static int32_t current_integ = SCALE_FULL << 8;     ///< Integrator, Q16
+static ws2812b_current_stats_t current_stats = {
+    .limit_ma = WS2812B_CURRENT_LIMIT_MA,
+    .scale = SCALE_FULL,
+};
+
+static int32_t clamp_i32(int32_t value, int32_t lo, int32_t hi)
+{
+    return (value < lo) ? lo : (value > hi) ? hi : value;
+}
+
+/**
+ * @brief Reset the controller (full scale) and the statistics.
+ */
+void WS2812B_Current_Reset(void)
+{
+    current_integ = SCALE_FULL << 8;
+    current_stats = (ws2812b_current_stats_t){ .limit_ma = current_limit, .scale = SCALE_FULL };
+    WS2812B_SetOutputScale(SCALE_FULL);
+}
+
+/**
+ * @brief Set the current limit; 0 turns limiting off.
+ */
+void WS2812B_Current_SetLimit(uint16_t limit_ma)
+{
+    current_limit = limit_ma;
+    current_stats.limit_ma = limit_ma;
+
+    if (limit_ma == 0)
+    {
+        current_integ = SCALE_FULL << 8;
+        current_stats.scale = SCALE_FULL;
+        WS2812B_SetOutputScale(SCALE_FULL);
+    }
+}
+
+/**
+ * @brief Run the controller on one reading and apply the new output scale.
+ */
+uint16_t WS2812B_Current_Update(uint16_t measured_ma)
+{
+    int32_t scale = current_stats.scale;
+
+    current_stats.current_ma = measured_ma;
+    if (measured_ma > current_stats.peak_ma) current_stats.peak_ma = measured_ma;
+
+    if (current_limit == 0)
+    {
+        scale = SCALE_FULL;
+        current_integ = SCALE_FULL << 8;
+    }
+    else if ((uint32_t)measured_ma * 100U > (uint32_t)current_limit * (100U + WS2812B_CURRENT_ATTACK_PCT))
+    {
+        // Fast attack: the current is proportional to the scale, so this puts
+        // the same content 1/16 under the limit in one step
+        uint32_t target = current_limit - current_limit / 16U;
+        scale = clamp_i32((int32_t)((uint32_t)scale * target / measured_ma), WS2812B_CURRENT_SCALE_MIN, SCALE_FULL);
+        current_integ = scale << 8;
+        current_stats.attacks++;
+    }
+    else
+    {
+        // Regulate 1/32 under the limit so that noise on the reading stays under it.
+        // Error relative to the setpoint, times the scale: equal loop gain at any content level
+        int32_t setpoint = current_limit - current_limit / 32U;
+        int32_t err = clamp_i32((setpoint - (int32_t)measured_ma) * 256 / setpoint, -ERR_MAX, ERR_MAX);
+        int32_t delta = err * scale;    // Q16
+
+        current_integ = clamp_i32(current_integ + delta * WS2812B_CURRENT_KI / 256,
+                                  WS2812B_CURRENT_SCALE_MIN << 8, SCALE_FULL << 8);
+        scale = clamp_i32((current_integ + delta * WS2812B_CURRENT_KP / 256) >> 8,
+                          WS2812B_CURRENT_SCALE_MIN, SCALE_FULL);
+    }
+
+    if (scale < SCALE_FULL) current_stats.limited_frames++;
+    current_stats.scale = (uint16_t)scale;
+    WS2812B_SetOutputScale((uint16_t)scale);
+    return (uint16_t)scale;
+}
+
+/**
+ * @brief Convert a sum of WS2812B_CURRENT_SAMPLES ADC readings to mA.
+ */
+uint16_t WS2812B_Current_CountsToMilliamps(uint32_t sum)
+{
+    const uint32_t offset = (uint32_t)WS2812B_CURRENT_OFFSET * WS2812B_CURRENT_SAMPLES;
+
+    if (sum <= offset) return 0;
+
+    // mA = mV * 1000 / (gain * mOhm), mV = counts * VREF / 4096
+    uint64_t ma = (uint64_t)(sum - offset) * WS2812B_CURRENT_VREF_MV * 1000U /
+                  (4096ULL * WS2812B_CURRENT_SAMPLES * WS2812B_CURRENT_GAIN * WS2812B_CURRENT_SHUNT_MOHM);
+    return (ma > 0xFFFFU) ? 0xFFFFU : (uint16_t)ma;
+}
+
+/**
+ * @brief Copy the statistics.
+ */
+void WS2812B_Current_GetStats(ws2812b_current_stats_t *stats)
+{
+    *stats = current_stats;
+}
+
+// ===================================================================
+// ============================ ADC GLUE =============================
+// ===================================================================
+
+/**
+ * @brief Calibrate the ADC and start continuous conversion into the circular DMA buffer.
+ */
+bool WS2812B_Current_Start(ADC_HandleTypeDef *hadc)
+{
+    current_adc = NULL;
+    WS2812B_Current_Reset();
+
+    hadc->DMA_Handle->Init.Mode = DMA_CIRCULAR;
+    HAL_DMA_Init(hadc->DMA_Handle);
+
+    if (HAL_ADCEx_Calibration_Start(hadc) != HAL_OK ||
+        HAL_ADC_Start_DMA(hadc, (uint32_t *)current_buf, WS2812B_CURRENT_SAMPLES) != HAL_OK)
+    {
+        return false;
+    }
+
+    current_adc = hadc;
+    return true;
+}
+
+/**
+ * @brief Average the DMA buffer and update the output scale.
+ */
+WS2812B_RAMFUNC void WS2812B_Current_Tick(void)
+{
+    if (current_adc == NULL) return;
+
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < WS2812B_CURRENT_SAMPLES; i++)
+    {
+        sum += current_buf[i];
+    }
+    WS2812B_Current_Update(WS2812B_Current_CountsToMilliamps(sum));
+}
@@ -0,0 +1,88 @@
+/**
+ * @file WS2812B_Cycle.c
+ * @brief Precomputed RGB frames of one effect period, played back by index.
+ *
+ * The cache is one flat byte array; a frame is led_count * 3 bytes starting
+ * at frame * led_count * 3. It is filled once per key, from the render loop.
+ */
+
+#include "WS2812B_Cycle.h"
+
+#if WS2812B_CYCLE_CACHE_BYTES > 0
+/** @brief Cached frames in R, G, B byte order. */
+static uint8_t cycle_cache[WS2812B_CYCLE_CACHE_BYTES];
+#endif
+
+static bool cycle_valid = false;
+static uint32_t cycle_key;
+static uint16_t cycle_period;
+static uint16_t cycle_leds;
+
+/**
+ * @brief Make sure the cache holds the period identified by @p key.
+ * @return true if the frames are cached, false if the period does not fit.
+ */
+bool WS2812B_Cycle_Prepare(uint32_t key, uint16_t period, uint16_t led_count,
+                           ws2812b_shader_t shader, const void *ctx)
+{
+    if (cycle_valid && cycle_key == key && cycle_period == period && cycle_leds == led_count)
+    {
+        return true;
+    }
+
+    if (period == 0 || led_count == 0 || led_count > LED_NUM ||
+        (uint32_t)period * led_count * 3U > WS2812B_CYCLE_CACHE_BYTES)
+    {
+        return false;
+    }
+
+#if WS2812B_CYCLE_CACHE_BYTES > 0
+    uint8_t *px = cycle_cache;
+    for (uint16_t frame = 0; frame < period; frame++)
+    {
+        for (uint16_t i = 0; i < led_count; i++, px += 3)
+        {
+            shader(i, frame, ctx, &px[0], &px[1], &px[2]);
+        }
+    }
+
+    cycle_key = key;
+    cycle_period = period;
+    cycle_leds = led_count;
+    cycle_valid = true;
+    return true;
+#else
+    (void)key;
+    (void)shader;
+    (void)ctx;
+    return false;
+#endif
+}
+
+/**
+ * @brief Encode one cached frame into the PWM buffer.
+ * @param frame Frame index (taken modulo the period)
+ */
+WS2812B_RAMFUNC void WS2812B_Cycle_Encode(uint16_t frame)
+{
+#if WS2812B_CYCLE_CACHE_BYTES > 0
+    if (!cycle_valid) return;
+
+    const uint8_t *px = &cycle_cache[(uint32_t)(frame % cycle_period) * cycle_leds * 3U];
+    ws2812b_pwm_t *dst = pwmData;
+    for (uint16_t i = 0; i < cycle_leds; i++, px += 3, dst += 24)
+    {
+        WS2812B_EncodeRGB(dst, px[0], px[1], px[2]);
+    }
+#else
+    (void)frame;
+#endif
+}
+
+/**
+ * @brief Drop the cached period.
+ */
+void WS2812B_Cycle_Invalidate(void)
+{
+    cycle_valid = false;
+}
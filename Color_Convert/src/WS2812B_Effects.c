@@ -9,14 +9,20 @@
  */
 
 #include "WS2812B_Effects.h"
+#include "WS2812B_Script.h"
+#include "WS2812B_Frame.h"
+#include "WS2812B_Cycle.h"
+#include "WS2812B_Pattern.h"
 
 // Global state variables (internal to this module)
 static uint16_t rainbow_hue = 0;
+static uint16_t chase_offset = 0;
 static uint8_t breathe_val = 50;
 static int8_t breathe_dir = 1;
 static uint8_t theater_frame = 0;
 static uint8_t global_brightness = 100;  ///< 0–100%
 static uint8_t global_speed = 50;        ///< 1–100 (higher = faster)
+static uint32_t last_cycle = 0;          ///< Tick of the last auto-cycle step
 
 /**
  * @brief Initialize the effects state machine with default values.
@@ -26,6 +32,8 @@ static uint8_t global_speed = 50;        ///< 1–100 (higher = faster)
 void WS2812B_Effects_Init(ws2812b_effects_t* effects) {
     effects->current_effect = EFFECT_RAINBOW_CHASE;
     effects->hue = 0;
+    effects->hue16 = 0;
+    effects->hue_step = 0x0100;  // 1° per frame
     effects->brightness = 50;
     effects->breathe_direction = 1;
     effects->theater_frame = 0;
@@ -34,27 +42,44 @@ void WS2812B_Effects_Init(ws2812b_effects_t* effects) {
     effects->cycle_duration = 5000; // 5 seconds
 }
 
+/**
+ * @brief Advance the hue phase accumulator by a fractional step.
+ * @param effects Effects state.
+ * @param step_8_8 Step in 8.8 fixed-point degrees (may exceed 0xFFFF, i.e. 256°).
+ * @return Hue (16-bit) to render this frame.
+ * @note A hue written in whole degrees elsewhere (presets, commands) is picked
+ *       up here; the fraction is kept otherwise, so 0x0040 (0.25°/frame)
+ *       rotates four times slower than 1°/frame without stepping.
+ */
+static uint16_t hue_phase_advance(ws2812b_effects_t* effects, uint32_t step_8_8) {
+    if (WS2812B_HUE16_TO_DEG(effects->hue16) != effects->hue) {
+        effects->hue16 = WS2812B_HUE16(effects->hue);
+    }
+
+    uint16_t current = effects->hue16;
+    effects->hue16 += WS2812B_HUE16_STEP(step_8_8);  // Wraps at 360° by itself
+    effects->hue = WS2812B_HUE16_TO_DEG(effects->hue16);
+    return current;
+}
+
 /**
  * @brief Main effect handler — call this in your main loop.
  * @param effects Pointer to the current effects state.
  * @note Automatically cycles effects if auto_cycle is enabled.
- *       Always calls WS2812_Send() at the end.
+ *       Always calls WS2812B_Send() at the end.
  */
 void WS2812B_Effects_Handle(ws2812b_effects_t* effects) {
-    static uint32_t last_cycle = 0;
-
     // Auto cycle effects
     if (effects->auto_cycle && (HAL_GetTick() - last_cycle > effects->cycle_duration)) {
-        effects->current_effect = (effects->current_effect + 1) % 6;
+        effects->current_effect = (effects->current_effect + 1) % WS2812B_EFFECT_CYCLE_COUNT;
         last_cycle = HAL_GetTick();
-        WS2812_Clear();
+        WS2812B_Clear();
     }
 
     // Execute current effect
     switch (effects->current_effect) {
         case EFFECT_STATIC_COLOR:
-            WS2812B_SolidColor(COLOR_HSV, effects->hue, 100, global_brightness);
-            effects->hue = (effects->hue + 1) % 360;
+            WS2812B_SetColorHSV16(hue_phase_advance(effects, effects->hue_step), 100, global_brightness);
             break;
 
         case EFFECT_RAINBOW_CHASE:
@@ -66,22 +91,24 @@ void WS2812B_Effects_Handle(ws2812b_effects_t* effects) {
             break;
 
         case EFFECT_BREATHE:
-            WS2812B_Breathe(COLOR_HSV, effects->hue, 100, global_brightness);
-            effects->hue = (effects->hue + 1) % 360;
+            WS2812B_BreatheHSV16(hue_phase_advance(effects, effects->hue_step), 100);
             break;
 
         case EFFECT_THEATER_CHASE:
-            ws2812b_theater_chase(effects->hue, effects->theater_frame);
+            WS2812B_TheaterChaseHSV16(hue_phase_advance(effects, 5UL * effects->hue_step), effects->theater_frame);
             effects->theater_frame = (effects->theater_frame + 1) % 3;
-            effects->hue = (effects->hue + 5) % 360;
             break;
 
         case EFFECT_TWINKLE:
-            WS2812b_Set_Color_HSL(300, 100, 50); // Magenta pastel
+            WS2812B_SetColorHSL(300, 100, 50); // Magenta pastel
+            break;
+
+        case EFFECT_SCRIPT:
+            WS2812B_Script_Tick();
             break;
     }
 
-    WS2812_Send();
+    WS2812B_Send();
 }
 
 /**
@@ -93,51 +120,155 @@ void WS2812B_Effects_Handle(ws2812b_effects_t* effects) {
 void WS2812B_Effects_SetEffect(ws2812b_effects_t* effects, ws2812b_effect_t new_effect) {
     effects->current_effect = new_effect;
     effects->auto_cycle = false; // Manual mode
-    WS2812_Clear();
+    WS2812B_Clear();
+}
+
+/**
+ * @brief Read the animation state kept inside the effect code.
+ * @param phase Filled with the current phases.
+ */
+void WS2812B_Effects_GetPhase(ws2812b_effects_phase_t* phase) {
+    phase->rainbow_hue = rainbow_hue;
+    phase->chase_offset = chase_offset;
+    phase->breathe_val = breathe_val;
+    phase->breathe_dir = breathe_dir;
+    phase->cycle_elapsed = HAL_GetTick() - last_cycle;
+    phase->fire_seed = WS2812B_GetFireSeed();
+}
+
+/**
+ * @brief Restore the animation state read by WS2812B_Effects_GetPhase().
+ * @param phase Phases to continue from; the auto-cycle timer is relative to HAL_GetTick().
+ */
+void WS2812B_Effects_SetPhase(const ws2812b_effects_phase_t* phase) {
+    rainbow_hue = phase->rainbow_hue % 360;
+    chase_offset = phase->chase_offset % 360;
+    breathe_val = phase->breathe_val;
+    breathe_dir = (phase->breathe_dir < 0) ? -1 : 1;
+    last_cycle = HAL_GetTick() - phase->cycle_elapsed;
+    WS2812B_SetFireSeed(phase->fire_seed);
 }
 
 // ==================== RAINBOW EFFECTS ====================
 
+#define RAINBOW_PERIOD          180     ///< Frames until rainbow_hue (+2/frame) repeats
+#define RAINBOW_CHASE_PERIOD    120     ///< Frames until chase_offset (+3/frame) repeats
+#define CYCLE_ID_RAINBOW        1       ///< WS2812B_Cycle key for WS2812B_Rainbow()
+#define CYCLE_ID_RAINBOW_CHASE  2       ///< WS2812B_Cycle key for WS2812B_RainbowChase()
+
 /**
- * @brief Display a full rainbow across all LEDs.
- * @param colorspace Color model to use: @ref COLOR_HSV (vibrant), @ref COLOR_HSL (pastel), or @ref COLOR_RGB (classic).
- * @note Uses internal `rainbow_hue` that auto-rotates.
- *       Includes built-in delay based on `global_speed`.
+ * @brief Frame parameters shared by the live and the cached rainbow renderers.
  */
-void WS2812B_Rainbow(color_space_t colorspace) {
-    switch(colorspace) {
+typedef struct {
+    color_space_t colorspace;
+    uint8_t brightness;
+    uint16_t n;                         ///< LEDs rendered (see WS2812B_RenderLength())
+} rainbow_ctx_t;
+
+/**
+ * @brief One LED of WS2812B_Rainbow() frame @p frame (rainbow_hue = 2 * frame).
+ */
+static void rainbow_shader(uint16_t i, uint32_t frame, const void *ctx,
+                           uint8_t *r, uint8_t *g, uint8_t *b) {
+    const rainbow_ctx_t *c = ctx;
+    uint16_t base = (uint16_t)(frame * 2);
+
+    switch (c->colorspace) {
         case COLOR_HSV:
-            for (int i = 0; i < LED_NUM; i++) {
-                uint16_t hue = (rainbow_hue + (i * 360 / LED_NUM)) % 360;
-                ws2812b_set_pixel_hsv(i, hue, 100, global_brightness);
-            }
+            // 16-bit hue: the frame step stays 2° (one period = 65536), the LEDs are spread sub-degree
+            WS2812B_HSV16ToRGB((uint16_t)(frame * 65536UL / RAINBOW_PERIOD + i * 65536UL / c->n),
+                               100, c->brightness, r, g, b);
             break;
 
         case COLOR_HSL:
-            for (int i = 0; i < LED_NUM; i++) {
-                uint16_t hue = (rainbow_hue + (i * 360 / LED_NUM)) % 360;
-                WS2812b_SetPixelHSL(i, hue, 100, 50); // Pastel = L=50%
+            WS2812B_HSLToRGB((base + (i * 360 / c->n)) % 360, 100, 50, r, g, b); // Pastel = L=50%
+            break;
+
+        case COLOR_RGB: {
+            uint8_t wheel_pos = (base + (i * 255 / c->n)) % 255;
+            if (wheel_pos < 85) {
+                *r = 255 - wheel_pos * 3; *g = 0; *b = wheel_pos * 3;
+            } else if (wheel_pos < 170) {
+                wheel_pos -= 85;
+                *r = 0; *g = wheel_pos * 3; *b = 255 - wheel_pos * 3;
+            } else {
+                wheel_pos -= 170;
+                *r = wheel_pos * 3; *g = 255 - wheel_pos * 3; *b = 0;
             }
             break;
+        }
+    }
+}
+
+/**
+ * @brief One LED of WS2812B_RainbowChase() frame @p frame (chase_offset = 3 * frame).
+ */
+static void rainbow_chase_shader(uint16_t i, uint32_t frame, const void *ctx,
+                                 uint8_t *r, uint8_t *g, uint8_t *b) {
+    const rainbow_ctx_t *c = ctx;
+    uint16_t led_hue = (frame * 3 + i * 30) % 360;
 
+    switch (c->colorspace) {
+        case COLOR_HSV:
+            WS2812B_HSV16ToRGB((uint16_t)(frame * 65536UL / RAINBOW_CHASE_PERIOD + i * 65536UL / 12),
+                               100, c->brightness, r, g, b);
+            break;
+        case COLOR_HSL:
+            WS2812B_HSLToRGB(led_hue, 100, 50, r, g, b);
+            break;
         case COLOR_RGB:
-            for (int i = 0; i < LED_NUM; i++) {
-                uint8_t wheel_pos = (rainbow_hue + (i * 255 / LED_NUM)) % 255;
-                if (wheel_pos < 85) {
-                    ws2812b_set_pixel_rgb(i, 255 - wheel_pos * 3, 0, wheel_pos * 3);
-                } else if (wheel_pos < 170) {
-                    wheel_pos -= 85;
-                    ws2812b_set_pixel_rgb(i, 0, wheel_pos * 3, 255 - wheel_pos * 3);
-                } else {
-                    wheel_pos -= 170;
-                    ws2812b_set_pixel_rgb(i, wheel_pos * 3, 255 - wheel_pos * 3, 0);
-                }
+            if (led_hue < 60) {
+                *r = 255; *g = (led_hue * 255) / 60; *b = 0;
+            } else if (led_hue < 120) {
+                *r = 255 - ((led_hue-60) * 255) / 60; *g = 255; *b = 0;
+            } else if (led_hue < 180) {
+                *r = 0; *g = 255; *b = ((led_hue-120) * 255) / 60;
+            } else if (led_hue < 240) {
+                *r = 0; *g = 255 - ((led_hue-180) * 255) / 60; *b = 255;
+            } else if (led_hue < 300) {
+                *r = ((led_hue-240) * 255) / 60; *g = 0; *b = 255;
+            } else {
+                *r = 255; *g = 0; *b = 255 - ((led_hue-300) * 255) / 60;
             }
             break;
     }
+}
+
+/**
+ * @brief Render one frame of a periodic rainbow, from the cycle cache if it fits.
+ * @note The first frame after a parameter change renders the whole period;
+ *       when it does not fit WS2812B_CYCLE_CACHE_BYTES every frame is live.
+ */
+static void rainbow_render(uint8_t id, uint16_t period, ws2812b_shader_t shader,
+                           const rainbow_ctx_t *ctx, uint16_t frame) {
+    if (WS2812B_Cycle_Prepare(WS2812B_CYCLE_KEY(id, ctx->colorspace, ctx->brightness),
+                              period, ctx->n, shader, ctx)) {
+        WS2812B_Cycle_Encode(frame);
+        return;
+    }
+
+    for (uint16_t i = 0; i < ctx->n; i++) {
+        uint8_t r, g, b;
+        shader(i, frame, ctx, &r, &g, &b);
+        WS2812B_SetPixelRGB(i, r, g, b);
+    }
+}
+
+/**
+ * @brief Display a full rainbow across all LEDs.
+ * @param colorspace Color model to use: @ref COLOR_HSV (vibrant), @ref COLOR_HSL (pastel), or @ref COLOR_RGB (classic).
+ * @note Uses internal `rainbow_hue` that auto-rotates.
+ *       Includes built-in delay based on `global_speed`.
+ *       On short strips the 180-frame period is served from WS2812B_Cycle.
+ */
+void WS2812B_Rainbow(color_space_t colorspace) {
+    const rainbow_ctx_t ctx = { colorspace, global_brightness, WS2812B_RenderLength() };
+
+    rainbow_render(CYCLE_ID_RAINBOW, RAINBOW_PERIOD, rainbow_shader, &ctx, rainbow_hue / 2);
+    WS2812B_ApplyMirror();  // Rest of the strip
 
     rainbow_hue = (rainbow_hue + 2) % 360;
-    WS2812_Send();
+    WS2812B_Send();
     HAL_Delay(100 - global_speed);
 }
 
@@ -145,45 +276,74 @@ void WS2812B_Rainbow(color_space_t colorspace) {
  * @brief Rainbow with a chasing motion.
  * @param colorspace See @ref WS2812B_Rainbow.
  * @note Faster motion than standard rainbow; uses different hue spacing.
+ *       On short strips the 120-frame period is served from WS2812B_Cycle.
  */
 void WS2812B_RainbowChase(color_space_t colorspace) {
-    static uint16_t chase_offset = 0;
-
-    for (int i = 0; i < LED_NUM; i++) {
-        uint16_t led_hue = (chase_offset + i * 30) % 360;
-
-        switch(colorspace) {
-            case COLOR_HSV:
-                ws2812b_set_pixel_hsv(i, led_hue, 100, global_brightness);
-                break;
-            case COLOR_HSL:
-                WS2812b_SetPixelHSL(i, led_hue, 100, 50);
-                break;
-            case COLOR_RGB:
-                if (led_hue < 60) {
-                    ws2812b_set_pixel_rgb(i, 255, (led_hue * 255) / 60, 0);
-                } else if (led_hue < 120) {
-                    ws2812b_set_pixel_rgb(i, 255 - ((led_hue-60) * 255) / 60, 255, 0);
-                } else if (led_hue < 180) {
-                    ws2812b_set_pixel_rgb(i, 0, 255, ((led_hue-120) * 255) / 60);
-                } else if (led_hue < 240) {
-                    ws2812b_set_pixel_rgb(i, 0, 255 - ((led_hue-180) * 255) / 60, 255);
-                } else if (led_hue < 300) {
-                    ws2812b_set_pixel_rgb(i, ((led_hue-240) * 255) / 60, 0, 255);
-                } else {
-                    ws2812b_set_pixel_rgb(i, 255, 0, 255 - ((led_hue-300) * 255) / 60);
-                }
-                break;
+    const rainbow_ctx_t ctx = { colorspace, global_brightness, WS2812B_RenderLength() };
+
+    rainbow_render(CYCLE_ID_RAINBOW_CHASE, RAINBOW_CHASE_PERIOD, rainbow_chase_shader, &ctx, chase_offset / 3);
+    WS2812B_ApplyMirror();
+
+    chase_offset = (chase_offset + 3) % 360;
+    WS2812B_Send();
+    HAL_Delay(100 - global_speed);
+}
+
+/**
+ * @brief Rainbow scrolled one LED per frame using the framebuffer ring offset.
+ * @param colorspace See @ref WS2812B_Rainbow.
+ * @note A full rainbow repeats every LED_NUM pixels, so each frame is a pure
+ *       rotation: no color conversion after the first frame, only the encode.
+ *       The frame is re-rendered when the color space, brightness or render
+ *       scale changes (at scale N it moves N LEDs per frame).
+ */
+void WS2812B_RainbowScroll(color_space_t colorspace) {
+    static bool primed = false;
+    static color_space_t primed_space;
+    static uint8_t primed_brightness;
+    static uint16_t primed_len;
+    const int n = WS2812B_Frame_Length();
+
+    if (!primed || primed_space != colorspace || primed_brightness != global_brightness || primed_len != n) {
+        WS2812B_Frame_Clear();
+        for (int i = 0; i < n; i++) {
+            uint16_t hue = (i * 360) / n;
+            switch (colorspace) {
+                case COLOR_HSV:
+                    WS2812B_Frame_SetPixelHSV(i, hue, 100, global_brightness);
+                    break;
+                case COLOR_HSL:
+                    WS2812B_Frame_SetPixelHSL(i, hue, 100, 50);
+                    break;
+                case COLOR_RGB:
+                    WS2812B_Frame_SetPixelHSV(i, hue, 100, 100);
+                    break;
+            }
         }
+        primed = true;
+        primed_space = colorspace;
+        primed_brightness = global_brightness;
+        primed_len = n;
+    } else {
+        WS2812B_Frame_Scroll(1);
     }
 
-    chase_offset = (chase_offset + 3) % 360;
-    WS2812_Send();
+    WS2812B_Frame_Show();
     HAL_Delay(100 - global_speed);
 }
 
 // ==================== BREATHE EFFECTS ====================
 
+/**
+ * @brief Step the breathing level, reversing at 10% and 90%.
+ */
+static void breathe_advance(void) {
+    breathe_val += breathe_dir;
+    if (breathe_val >= 90 || breathe_val <= 10) {
+        breathe_dir = -breathe_dir;
+    }
+}
+
 /**
  * @brief Smooth breathing/pulsing effect using a single base color.
  * @param colorspace Color model to interpret the next three parameters.
@@ -195,26 +355,35 @@ void WS2812B_RainbowChase(color_space_t colorspace) {
 void WS2812B_Breathe(color_space_t colorspace, uint16_t hue_or_red, uint8_t sat_or_green, uint8_t val_or_blue) {
     switch(colorspace) {
         case COLOR_HSV:
-            ws2812b_set_color_hsv(hue_or_red, sat_or_green, breathe_val);
+            WS2812B_SetColorHSV(hue_or_red, sat_or_green, breathe_val);
             break;
         case COLOR_HSL:
-            WS2812b_Set_Color_HSL(hue_or_red, sat_or_green, breathe_val);
+            WS2812B_SetColorHSL(hue_or_red, sat_or_green, breathe_val);
             break;
         case COLOR_RGB: {
             uint8_t r = (hue_or_red * breathe_val) / 100;
             uint8_t g = (sat_or_green * breathe_val) / 100;
             uint8_t b = (val_or_blue * breathe_val) / 100;
-            ws2812b_set_color_rgb(r, g, b);
+            WS2812B_SetColorRGB(r, g, b);
             break;
         }
     }
 
-    breathe_val += breathe_dir;
-    if (breathe_val >= 90 || breathe_val <= 10) {
-        breathe_dir = -breathe_dir;
-    }
+    breathe_advance();
+    WS2812B_Send();
+    HAL_Delay(150 - global_speed);
+}
 
-    WS2812_Send();
+/**
+ * @brief Breathing effect in HSV with a 16-bit hue (sub-degree color rotation).
+ * @param hue16 Hue (0–65535 = 0–360°).
+ * @param sat Saturation (0–100%).
+ * @note Shares the breathing level with WS2812B_Breathe().
+ */
+void WS2812B_BreatheHSV16(uint16_t hue16, uint8_t sat) {
+    WS2812B_SetColorHSV16(hue16, sat, breathe_val);
+    breathe_advance();
+    WS2812B_Send();
     HAL_Delay(150 - global_speed);
 }
 
@@ -230,16 +399,16 @@ void WS2812B_Breathe(color_space_t colorspace, uint16_t hue_or_red, uint8_t sat_
 void WS2812B_SolidColor(color_space_t colorspace, uint16_t hue_or_red, uint8_t sat_or_green, uint8_t val_or_blue) {
     switch(colorspace) {
         case COLOR_HSV:
-            ws2812b_set_color_hsv(hue_or_red, sat_or_green, val_or_blue);
+            WS2812B_SetColorHSV(hue_or_red, sat_or_green, val_or_blue);
             break;
         case COLOR_HSL:
-            WS2812b_Set_Color_HSL(hue_or_red, sat_or_green, val_or_blue);
+            WS2812B_SetColorHSL(hue_or_red, sat_or_green, val_or_blue);
             break;
         case COLOR_RGB:
-            ws2812b_set_color_rgb(hue_or_red, sat_or_green, val_or_blue);
+            WS2812B_SetColorRGB(hue_or_red, sat_or_green, val_or_blue);
             break;
     }
-    WS2812_Send();
+    WS2812B_Send();
 }
 
 // ==================== ANIMATED EFFECTS ====================
@@ -252,26 +421,34 @@ void WS2812B_SolidColor(color_space_t colorspace, uint16_t hue_or_red, uint8_t s
  * @param val_or_blue Value/lightness or blue.
  */
 void WS2812B_TheaterChase(color_space_t colorspace, uint16_t hue_or_red, uint8_t sat_or_green, uint8_t val_or_blue) {
-    for (int i = 0; i < LED_NUM; i++) {
-        if (i % 3 == theater_frame) {
-            switch(colorspace) {
-                case COLOR_HSV:
-                    ws2812b_set_pixel_hsv(i, hue_or_red, sat_or_green, val_or_blue);
-                    break;
-                case COLOR_HSL:
-                    WS2812b_SetPixelHSL(i, hue_or_red, sat_or_green, val_or_blue);
-                    break;
-                case COLOR_RGB:
-                    ws2812b_set_pixel_rgb(i, hue_or_red, sat_or_green, val_or_blue);
-                    break;
-            }
-        } else {
-            ws2812b_set_pixel_rgb(i, 0, 0, 0);
-        }
+    static ws2812b_pattern_t chase;
+    uint8_t r, g, b;
+
+    switch(colorspace) {
+        case COLOR_HSV:
+            WS2812B_HSVToRGB(hue_or_red, sat_or_green, val_or_blue, &r, &g, &b);
+            break;
+        case COLOR_HSL:
+            WS2812B_HSLToRGB(hue_or_red, sat_or_green, val_or_blue, &r, &g, &b);
+            break;
+        case COLOR_RGB:
+        default:
+            r = hue_or_red;
+            g = sat_or_green;
+            b = val_or_blue;
+            break;
     }
 
+    // Every 3rd LED lit: LED i is on when i % 3 == theater_frame
+    if (chase.period != 3) {
+        WS2812B_Pattern_FromMask(&chase, 0x1, 3);
+    }
+    WS2812B_Pattern_SetColor(&chase, 1, r, g, b);
+    WS2812B_Pattern_SetPhase(&chase, theater_frame);
+    WS2812B_Pattern_Encode(&chase);
+
     theater_frame = (theater_frame + 1) % 3;
-    WS2812_Send();
+    WS2812B_Send();
     HAL_Delay(200 - global_speed * 2);
 }
 
@@ -280,8 +457,8 @@ void WS2812B_TheaterChase(color_space_t colorspace, uint16_t hue_or_red, uint8_t
  * @note No parameters — uses internal logic.
  */
 void WS2812B_Fire(void) {
-    ws2812b_fire_effect();
-    WS2812_Send();
+    WS2812B_FireEffect();
+    WS2812B_Send();
     HAL_Delay(100 - global_speed);
 }
 
@@ -290,8 +467,8 @@ void WS2812B_Fire(void) {
  * @note Rotating hue creates smooth color transition.
  */
 void WS2812B_PastelWave(void) {
-    ws2812b_pastel_loop(&rainbow_hue);
-    WS2812_Send();
+    WS2812B_PastelLoop(&rainbow_hue);
+    WS2812B_Send();
     HAL_Delay(100 - global_speed);
 }
 
@@ -301,8 +478,8 @@ void WS2812B_PastelWave(void) {
  * @brief Turn off all LEDs.
  */
 void WS2812B_Off(void) {
-    WS2812_Clear();
-    WS2812_Send();
+    WS2812B_Clear();
+    WS2812B_Send();
 }
 
 /**
@@ -324,4 +501,20 @@ void WS2812B_SetSpeed(uint8_t speed) {
     global_speed = speed;
     if (global_speed > 100) global_speed = 100;
     if (global_speed < 1) global_speed = 1;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Get global brightness.
+ * @return Brightness in percent (0–100).
+ */
+uint8_t WS2812B_GetBrightness(void) {
+    return global_brightness;
+}
+
+/**
+ * @brief Get animation speed.
+ * @return Speed level (1–100).
+ */
+uint8_t WS2812B_GetSpeed(void) {
+    return global_speed;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file WS2812B_Frame.c
+ * @brief Ring-buffer RGB framebuffer with scroll offset applied at encode time.
+ *
+ * Logical pixel i is stored at slot (frame_offset + i) mod frame_len. The
+ * encoder walks the ring in two linear runs, so no per-pixel modulo is needed.
+ * With a render scale > 1 only the first frame_len slots are used and the
+ * encoder interpolates between neighbouring samples.
+ */
+
+#include "WS2812B_Frame.h"
+#include <string.h>
+
+/** @brief Framebuffer in R, G, B byte order (ring, see frame_offset). */
+static uint8_t frame_buf[LED_NUM][3];
+
+/** @brief Storage slot of logical pixel 0. */
+static uint16_t frame_offset = 0;
+
+/** @brief log2 of the render scale, see WS2812B_Frame_SetScale(). */
+static uint8_t frame_shift = 0;
+
+/** @brief Logical pixels (samples) in the framebuffer ring. */
+static uint16_t frame_len = LED_NUM;
+
+/**
+ * @brief Map a logical pixel to its storage slot.
+ * @param pixel Logical LED index (must be < LED_NUM)
+ * @return Storage slot.
+ */
+static inline uint16_t frame_slot(uint16_t pixel)
+{
+    uint32_t slot = (uint32_t)frame_offset + pixel;
+    return (slot >= frame_len) ? (uint16_t)(slot - frame_len) : (uint16_t)slot;
+}
+
+/**
+ * @brief Clear the framebuffer to black and reset the scroll offset.
+ */
+void WS2812B_Frame_Clear(void)
+{
+    memset(frame_buf, 0, sizeof(frame_buf));
+    frame_offset = 0;
+}
+
+/**
+ * @brief Set the render scale (samples are this many LEDs apart).
+ * @param scale 1, 2, 4 or 8; other values are rounded down to one of these
+ * @note Clears the framebuffer. The last sample lies at or past the last LED,
+ *       so the strip end is never extrapolated.
+ */
+void WS2812B_Frame_SetScale(uint8_t scale)
+{
+    uint8_t shift = 0;
+    while (shift < 3 && (scale >> (shift + 1)) != 0) shift++;
+
+    frame_shift = shift;
+    frame_len = (uint16_t)(((LED_NUM - 1 + (1u << shift) - 1) >> shift) + 1);
+    WS2812B_Frame_Clear();
+}
+
+/**
+ * @brief Current render scale.
+ * @return 1, 2, 4 or 8.
+ */
+uint8_t WS2812B_Frame_GetScale(void)
+{
+    return (uint8_t)(1u << frame_shift);
+}
+
+/**
+ * @brief Number of logical pixels an effect has to render.
+ * @return LED_NUM at scale 1, about LED_NUM / scale otherwise.
+ */
+uint16_t WS2812B_Frame_Length(void)
+{
+    return frame_len;
+}
+
+/**
+ * @brief Set one logical pixel.
+ * @param pixel Logical LED index (0 to WS2812B_Frame_Length() - 1)
+ * @param red Red (0–255)
+ * @param green Green (0–255)
+ * @param blue Blue (0–255)
+ * @note Does nothing if pixel index is out of bounds.
+ */
+void WS2812B_Frame_SetPixelRGB(uint16_t pixel, uint8_t red, uint8_t green, uint8_t blue)
+{
+    if (pixel >= frame_len) return;
+
+    uint8_t *px = frame_buf[frame_slot(pixel)];
+    px[0] = red;
+    px[1] = green;
+    px[2] = blue;
+}
+
+/**
+ * @brief Set one logical pixel from HSV.
+ * @param pixel Logical LED index
+ * @param hue Hue (0–359)
+ * @param sat Saturation (0–100%)
+ * @param val Value (0–100%)
+ */
+void WS2812B_Frame_SetPixelHSV(uint16_t pixel, uint16_t hue, uint8_t sat, uint8_t val)
+{
+    uint8_t r, g, b;
+    WS2812B_HSVToRGB(hue, sat, val, &r, &g, &b);
+    WS2812B_Frame_SetPixelRGB(pixel, r, g, b);
+}
+
+/**
+ * @brief Set one logical pixel from HSL.
+ * @param pixel Logical LED index
+ * @param hue Hue (0–359)
+ * @param sat Saturation (0–100%)
+ * @param light Lightness (0–100%)
+ */
+void WS2812B_Frame_SetPixelHSL(uint16_t pixel, uint16_t hue, uint8_t sat, uint8_t light)
+{
+    uint8_t r, g, b;
+    WS2812B_HSLToRGB(hue, sat, light, &r, &g, &b);
+    WS2812B_Frame_SetPixelRGB(pixel, r, g, b);
+}
+
+/**
+ * @brief Read one logical pixel.
+ * @param pixel Logical LED index
+ * @param[out] red Red
+ * @param[out] green Green
+ * @param[out] blue Blue
+ * @note Returns black if pixel index is out of bounds.
+ */
+void WS2812B_Frame_GetPixelRGB(uint16_t pixel, uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    if (pixel >= frame_len)
+    {
+        *red = *green = *blue = 0;
+        return;
+    }
+
+    const uint8_t *px = frame_buf[frame_slot(pixel)];
+    *red = px[0];
+    *green = px[1];
+    *blue = px[2];
+}
+
+/**
+ * @brief Scroll the whole frame in O(1) by moving the ring start.
+ * @param steps Pixels to scroll (positive = towards higher indices).
+ */
+void WS2812B_Frame_Scroll(int16_t steps)
+{
+    int32_t offset = ((int32_t)frame_offset - steps) % frame_len;
+    if (offset < 0) offset += frame_len;
+    frame_offset = (uint16_t)offset;
+}
+
+/**
+ * @brief Encode with linear interpolation between samples (scale > 1).
+ * @note Integer lerp with weights that sum to the scale, so a run between two
+ *       equal samples is exact and there is no division.
+ */
+static WS2812B_RAMFUNC void frame_encode_scaled(void)
+{
+    const uint32_t step = 1u << frame_shift;
+    ws2812b_pwm_t *dst = pwmData;
+    uint32_t pixel = 0;
+    const uint8_t *a = frame_buf[frame_slot(0)];
+
+    for (uint16_t k = 0; pixel < LED_NUM; k++)
+    {
+        const uint8_t *b = (k + 1 < frame_len) ? frame_buf[frame_slot(k + 1)] : a;
+
+        for (uint32_t j = 0; j < step && pixel < LED_NUM; j++, pixel++, dst += 24)
+        {
+            uint32_t wa = step - j;
+            WS2812B_EncodeRGB(dst,
+                              (uint8_t)((a[0] * wa + b[0] * j) >> frame_shift),
+                              (uint8_t)((a[1] * wa + b[1] * j) >> frame_shift),
+                              (uint8_t)((a[2] * wa + b[2] * j) >> frame_shift));
+        }
+        a = b;
+    }
+}
+
+/**
+ * @brief Encode the framebuffer (with scroll offset) into the PWM buffer.
+ * @note Two linear runs over the ring: [offset, LED_NUM) then [0, offset).
+ *       With a render scale > 1 the samples are upscaled while encoding.
+ */
+WS2812B_RAMFUNC void WS2812B_Frame_Encode(void)
+{
+    ws2812b_pwm_t *dst = pwmData;
+
+    if (frame_shift != 0)
+    {
+        frame_encode_scaled();
+        return;
+    }
+
+    for (uint16_t slot = frame_offset; slot < LED_NUM; slot++, dst += 24)
+    {
+        WS2812B_EncodeRGB(dst, frame_buf[slot][0], frame_buf[slot][1], frame_buf[slot][2]);
+    }
+    for (uint16_t slot = 0; slot < frame_offset; slot++, dst += 24)
+    {
+        WS2812B_EncodeRGB(dst, frame_buf[slot][0], frame_buf[slot][1], frame_buf[slot][2]);
+    }
+}
+
+/**
+ * @brief Encode and transmit the framebuffer.
+ */
+void WS2812B_Frame_Show(void)
+{
+    WS2812B_Frame_Encode();
+    WS2812B_Send();
+}
+
+/**
+ * @brief Pixel shader reading the framebuffer (scroll offset and scale applied).
+ * @note LEDs beyond LED_NUM are black. ctx is unused.
+ */
+WS2812B_RAMFUNC void WS2812B_Shader_Frame(uint16_t index, uint32_t time, const void *ctx,
+                                          uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    (void)time;
+    (void)ctx;
+
+    if (frame_shift == 0 || index >= LED_NUM)
+    {
+        WS2812B_Frame_GetPixelRGB(index, red, green, blue);
+        return;
+    }
+
+    uint16_t k = index >> frame_shift;
+    uint32_t j = index & ((1u << frame_shift) - 1);
+    const uint8_t *a = frame_buf[frame_slot(k)];
+    const uint8_t *b = (k + 1 < frame_len) ? frame_buf[frame_slot(k + 1)] : a;
+    uint32_t wa = (1u << frame_shift) - j;
+
+    *red = (uint8_t)((a[0] * wa + b[0] * j) >> frame_shift);
+    *green = (uint8_t)((a[1] * wa + b[1] * j) >> frame_shift);
+    *blue = (uint8_t)((a[2] * wa + b[2] * j) >> frame_shift);
+}
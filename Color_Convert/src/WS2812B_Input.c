@@ -0,0 +1,168 @@
+/**
+ * @file WS2812B_Input.c
+ * @brief Debounced button and quadrature encoder input via EXTI + SysTick.
+ *
+ * Every variable has a single writer so no interrupt masking is needed:
+ * - EXTI (button): btn_edges, btn_edge_time
+ * - EXTI (encoder): enc_state, enc_steps
+ * - SysTick: everything else, and the only producer of input_queue
+ *
+ * Button: the tick waits until WS2812B_INPUT_DEBOUNCE_MS passed since the last
+ * edge, then accepts the current level. Encoder: a Gray-code transition table
+ * turns each edge into -1/0/+1, so contact bounce on one line cancels out.
+ */
+
+#include "WS2812B_Input.h"
+
+/** @brief Quadrature step for transition (previous AB << 2 | current AB). */
+static const int8_t quad_table[16] = {
+     0, +1, -1,  0,
+    -1,  0,  0, +1,
+    +1,  0,  0, -1,
+     0, -1, +1,  0
+};
+
+static ws2812b_cmd_queue_t input_queue;
+
+// Written by the button EXTI
+static volatile uint32_t btn_edges = 0;
+static volatile uint32_t btn_edge_time = 0;
+
+// Written by the encoder EXTI
+static volatile uint8_t enc_state = 0;
+static volatile int32_t enc_steps = 0;
+
+// Written by the tick
+static uint32_t btn_seen_edges = 0;
+static bool btn_stable = false;
+static bool btn_long_fired = false;
+static uint32_t btn_press_time = 0;
+static int32_t enc_reported = 0;
+
+/**
+ * @brief Reset the core state.
+ * @param ab Current encoder levels (bit 1 = A, bit 0 = B)
+ */
+void WS2812B_Input_Reset(uint8_t ab)
+{
+    btn_edges = 0;
+    btn_seen_edges = 0;
+    btn_stable = false;
+    btn_long_fired = false;
+    enc_state = ab & 3U;
+    enc_steps = 0;
+    enc_reported = 0;
+}
+
+/**
+ * @brief Button edge seen by EXTI.
+ * @param now Current time in ms
+ */
+void WS2812B_Input_ButtonEdge(uint32_t now)
+{
+    btn_edge_time = now;
+    btn_edges++;
+}
+
+/**
+ * @brief Encoder edge seen by EXTI.
+ * @param ab Current encoder levels: bit 1 = A, bit 0 = B
+ */
+void WS2812B_Input_EncoderEdge(uint8_t ab)
+{
+    ab &= 3U;
+    enc_steps += quad_table[(enc_state << 2) | ab];
+    enc_state = ab;
+}
+
+/**
+ * @brief Debounce, long-press and detent processing.
+ * @param now Current time in ms
+ * @param pressed Current button level, true = pressed
+ * @note Runs in SysTick context; constant time.
+ */
+void WS2812B_Input_Tick(uint32_t now, bool pressed)
+{
+    // Read the count before the time: an edge in between only delays acceptance
+    uint32_t edges = btn_edges;
+    if (edges != btn_seen_edges && (now - btn_edge_time) >= WS2812B_INPUT_DEBOUNCE_MS)
+    {
+        btn_seen_edges = edges;
+        if (pressed != btn_stable)
+        {
+            btn_stable = pressed;
+            if (pressed)
+            {
+                btn_press_time = now;
+                btn_long_fired = false;
+            }
+            else if (!btn_long_fired)
+            {
+                WS2812B_CmdQueue_Push(&input_queue, CMD_NEXT_EFFECT, 0);
+            }
+        }
+    }
+
+    if (btn_stable && !btn_long_fired && (now - btn_press_time) >= WS2812B_INPUT_LONG_PRESS_MS)
+    {
+        btn_long_fired = true;
+        WS2812B_CmdQueue_Push(&input_queue, CMD_POWER, -1);
+    }
+
+    int32_t detents = (enc_steps - enc_reported) / WS2812B_INPUT_STEPS_PER_DETENT;
+    if (detents != 0)
+    {
+        if (WS2812B_CmdQueue_Push(&input_queue, CMD_ADJUST_BRIGHTNESS, detents * WS2812B_INPUT_BRIGHTNESS_STEP))
+        {
+            enc_reported += detents * WS2812B_INPUT_STEPS_PER_DETENT;
+        }
+    }
+}
+
+// ===================================================================
+// ============================ HAL GLUE =============================
+// ===================================================================
+
+/**
+ * @brief Read the encoder pins.
+ * @return bit 1 = A, bit 0 = B
+ */
+static uint8_t read_encoder(void)
+{
+    uint8_t a = (HAL_GPIO_ReadPin(ENC_A_GPIO_Port, ENC_A_Pin) == GPIO_PIN_SET);
+    uint8_t b = (HAL_GPIO_ReadPin(ENC_B_GPIO_Port, ENC_B_Pin) == GPIO_PIN_SET);
+    return (uint8_t)((a << 1) | b);
+}
+
+/**
+ * @brief Register the input command queue and latch the initial encoder state.
+ */
+void WS2812B_Input_Init(void)
+{
+    WS2812B_Input_Reset(read_encoder());
+    WS2812B_Control_AddQueue(&input_queue);
+}
+
+/**
+ * @brief 1 ms tick (call from SysTick_Handler).
+ */
+void WS2812B_Input_Tick1ms(void)
+{
+    WS2812B_Input_Tick(HAL_GetTick(), HAL_GPIO_ReadPin(BTN_GPIO_Port, BTN_Pin) == GPIO_PIN_RESET);
+}
+
+/**
+ * @brief EXTI callback for the button and encoder lines.
+ * @param GPIO_Pin Pin that triggered the interrupt.
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    if (GPIO_Pin == BTN_Pin)
+    {
+        WS2812B_Input_ButtonEdge(HAL_GetTick());
+    }
+    else if (GPIO_Pin == ENC_A_Pin || GPIO_Pin == ENC_B_Pin)
+    {
+        WS2812B_Input_EncoderEdge(read_encoder());
+    }
+}
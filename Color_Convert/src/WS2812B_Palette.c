@@ -0,0 +1,225 @@
+/**
+ * @file WS2812B_Palette.c
+ * @brief Indexed-color framebuffer and palette for WS2812B strips.
+ *
+ * Pixels hold palette indices; the palette is resolved during encode or
+ * streaming. Color cycling never rewrites the palette either: it advances a
+ * rotation offset that the lookup adds to indices inside the cycled range.
+ * The range and offset are packed into one word, so the stream DMA ISR always
+ * sees a consistent rotation, and it latches that word at LED 0 so a whole
+ * frame is resolved with the same rotation.
+ */
+
+#include "WS2812B_Palette.h"
+#include <string.h>
+
+_Static_assert(WS2812B_PALETTE_SIZE >= 2 && WS2812B_PALETTE_SIZE <= 256 &&
+               (WS2812B_PALETTE_SIZE & (WS2812B_PALETTE_SIZE - 1)) == 0,
+               "WS2812B_PALETTE_SIZE must be a power of two between 2 and 256");
+
+#define PALETTE_MASK    (WS2812B_PALETTE_SIZE - 1)
+
+/** @brief Palette in R, G, B byte order. */
+static uint8_t palette[WS2812B_PALETTE_SIZE][3];
+
+/** @brief One palette index per LED. */
+static uint8_t indexed_buf[WS2812B_INDEXED_LED_NUM];
+
+/**
+ * @brief Cycled range, one word for atomic reads from the stream ISR:
+ *        bits 0–7 first entry, bits 8–16 entry count (0 = none), bits 17–24 rotation.
+ */
+static volatile uint32_t palette_cycle = 0;
+
+#define CYCLE_PACK(first, count, offset) \
+    ((uint32_t)(first) | ((uint32_t)(count) << 8) | ((uint32_t)(offset) << 17))
+#define CYCLE_FIRST(cycle)  ((cycle) & 0xFFU)
+#define CYCLE_COUNT(cycle)  (((cycle) >> 8) & 0x1FFU)
+#define CYCLE_OFFSET(cycle) ((cycle) >> 17)
+
+/**
+ * @brief Palette entry shown for an index under a given rotation.
+ * @param index Palette index stored in the framebuffer
+ * @param cycle Snapshot of palette_cycle
+ */
+static inline const uint8_t *palette_lookup(uint8_t index, uint32_t cycle)
+{
+    uint32_t pos = (uint32_t)index - CYCLE_FIRST(cycle);   // Wraps high below the range
+
+    if (pos < CYCLE_COUNT(cycle))
+    {
+        pos += CYCLE_OFFSET(cycle);
+        if (pos >= CYCLE_COUNT(cycle)) pos -= CYCLE_COUNT(cycle);
+        index = (uint8_t)(CYCLE_FIRST(cycle) + pos);
+    }
+    return palette[index & PALETTE_MASK];
+}
+
+// ===================================================================
+// ============================= PALETTE =============================
+// ===================================================================
+
+/**
+ * @brief Set one palette entry.
+ * @param index Palette index (wrapped to the palette size)
+ * @param red Red (0–255)
+ * @param green Green (0–255)
+ * @param blue Blue (0–255)
+ */
+void WS2812B_Palette_Set(uint8_t index, uint8_t red, uint8_t green, uint8_t blue)
+{
+    uint8_t *entry = palette[index & PALETTE_MASK];
+    entry[0] = red;
+    entry[1] = green;
+    entry[2] = blue;
+}
+
+/**
+ * @brief Set one palette entry from HSV.
+ * @param index Palette index
+ * @param hue Hue (0–359)
+ * @param sat Saturation (0–100%)
+ * @param val Value (0–100%)
+ */
+void WS2812B_Palette_SetHSV(uint8_t index, uint16_t hue, uint8_t sat, uint8_t val)
+{
+    uint8_t *entry = palette[index & PALETTE_MASK];
+    WS2812B_HSVToRGB(hue, sat, val, &entry[0], &entry[1], &entry[2]);
+}
+
+/**
+ * @brief Fill a palette range with a full hue wheel.
+ * @param first First palette index
+ * @param count Number of entries (clamped to the palette end)
+ * @param sat Saturation (0–100%)
+ * @param val Value (0–100%)
+ */
+void WS2812B_Palette_Rainbow(uint8_t first, uint16_t count, uint8_t sat, uint8_t val)
+{
+#if WS2812B_PALETTE_SIZE < 256
+    if (first >= WS2812B_PALETTE_SIZE) return;
+#endif
+    if (count > WS2812B_PALETTE_SIZE - first) count = WS2812B_PALETTE_SIZE - first;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        WS2812B_Palette_SetHSV(first + i, (i * 360U) / count, sat, val);
+    }
+}
+
+/**
+ * @brief Rotate a palette range (color cycling).
+ * @param first First palette index of the range
+ * @param count Number of entries in the range (clamped to the palette end)
+ * @param steps Entries to rotate (positive = colors move to lower indices)
+ * @note O(1): only the rotation offset changes, published with one store.
+ *       A different range than the active one restarts the rotation at 0.
+ */
+void WS2812B_Palette_Cycle(uint8_t first, uint16_t count, int16_t steps)
+{
+#if WS2812B_PALETTE_SIZE < 256
+    if (first >= WS2812B_PALETTE_SIZE) return;
+#endif
+    if (count > WS2812B_PALETTE_SIZE - first) count = WS2812B_PALETTE_SIZE - first;
+    if (count < 2) return;
+
+    uint32_t cycle = palette_cycle;
+    int32_t offset = (CYCLE_FIRST(cycle) == first && CYCLE_COUNT(cycle) == count) ? (int32_t)CYCLE_OFFSET(cycle) : 0;
+
+    offset = (offset + steps) % (int32_t)count;
+    if (offset < 0) offset += count;
+    palette_cycle = CYCLE_PACK(first, count, offset);
+}
+
+/**
+ * @brief Stop color cycling: every index shows its own palette entry again.
+ */
+void WS2812B_Palette_ResetCycle(void)
+{
+    palette_cycle = 0;
+}
+
+// ===================================================================
+// ======================== INDEXED FRAMEBUFFER ======================
+// ===================================================================
+
+/**
+ * @brief Set the palette index of one LED.
+ * @param pixel LED index (0 to WS2812B_INDEXED_LED_NUM - 1)
+ * @param index Palette index
+ * @note Does nothing if pixel index is out of bounds.
+ */
+void WS2812B_Indexed_SetPixel(uint16_t pixel, uint8_t index)
+{
+    if (pixel >= WS2812B_INDEXED_LED_NUM) return;
+    indexed_buf[pixel] = index;
+}
+
+/**
+ * @brief Read the palette index of one LED.
+ * @param pixel LED index
+ * @return Palette index, or 0 if pixel index is out of bounds.
+ */
+uint8_t WS2812B_Indexed_GetPixel(uint16_t pixel)
+{
+    return (pixel < WS2812B_INDEXED_LED_NUM) ? indexed_buf[pixel] : 0;
+}
+
+/**
+ * @brief Set every LED to the same palette index.
+ * @param index Palette index
+ */
+void WS2812B_Indexed_Fill(uint8_t index)
+{
+    memset(indexed_buf, index, sizeof(indexed_buf));
+}
+
+/**
+ * @brief Resolve the palette and encode the first LED_NUM LEDs into the PWM buffer.
+ */
+WS2812B_RAMFUNC void WS2812B_Indexed_Encode(void)
+{
+    uint16_t count = (WS2812B_INDEXED_LED_NUM < LED_NUM) ? WS2812B_INDEXED_LED_NUM : LED_NUM;
+    ws2812b_pwm_t *dst = pwmData;
+    const uint32_t cycle = palette_cycle;
+
+    for (uint16_t i = 0; i < count; i++, dst += 24)
+    {
+        const uint8_t *entry = palette_lookup(indexed_buf[i], cycle);
+        WS2812B_EncodeRGB(dst, entry[0], entry[1], entry[2]);
+    }
+}
+
+/**
+ * @brief Encode and transmit the indexed framebuffer.
+ */
+void WS2812B_Indexed_Show(void)
+{
+    WS2812B_Indexed_Encode();
+    WS2812B_Send();
+}
+
+/**
+ * @brief Pixel shader resolving the indexed framebuffer.
+ * @note LEDs beyond WS2812B_INDEXED_LED_NUM are black. ctx is unused.
+ */
+WS2812B_RAMFUNC void WS2812B_Shader_Indexed(uint16_t index, uint32_t time, const void *ctx,
+                                            uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    static uint32_t frame_cycle = 0;   // Rotation of the frame being streamed
+
+    (void)time;
+    (void)ctx;
+
+    if (index == 0) frame_cycle = palette_cycle;
+    if (index >= WS2812B_INDEXED_LED_NUM)
+    {
+        *red = *green = *blue = 0;
+        return;
+    }
+
+    const uint8_t *entry = palette_lookup(indexed_buf[index], frame_cycle);
+    *red = entry[0];
+    *green = entry[1];
+    *blue = entry[2];
+}
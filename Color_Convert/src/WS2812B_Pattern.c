@@ -0,0 +1,143 @@
+/**
+ * @file WS2812B_Pattern.c
+ * @brief Run-length chase patterns encoded without per-pixel arithmetic.
+ *
+ * The phase is reduced to a (run, LEDs left in run) starting point once per
+ * frame; the encoder then copies pre-encoded color blocks and steps to the
+ * next run whenever the down-counter expires.
+ */
+
+#include "WS2812B_Pattern.h"
+#include <string.h>
+
+/**
+ * @brief Install a run-length template.
+ * @return false if the template is invalid (the pattern is left unchanged).
+ */
+bool WS2812B_Pattern_SetRuns(ws2812b_pattern_t *p, const ws2812b_pattern_run_t *runs, uint8_t count)
+{
+    uint16_t period = 0;
+
+    if (count == 0 || count > WS2812B_PATTERN_MAX_RUNS) return false;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (runs[i].length == 0 || runs[i].color >= WS2812B_PATTERN_MAX_COLORS) return false;
+        period += runs[i].length;
+    }
+
+    memcpy(p->runs, runs, count * sizeof(runs[0]));
+    p->run_count = count;
+    p->period = period;
+    p->phase = 0;
+    return true;
+}
+
+/**
+ * @brief Install a two-color template from a bitmask.
+ * @return false if period is out of range.
+ */
+bool WS2812B_Pattern_FromMask(ws2812b_pattern_t *p, uint32_t mask, uint8_t period)
+{
+    ws2812b_pattern_run_t runs[WS2812B_PATTERN_MAX_RUNS];
+    uint8_t count = 0;
+
+    if (period == 0 || period > 32) return false;
+
+    for (uint8_t bit = 0; bit < period; bit++)
+    {
+        uint8_t color = (mask >> bit) & 1U;
+        if (count > 0 && runs[count - 1].color == color)
+        {
+            runs[count - 1].length++;
+        }
+        else
+        {
+            runs[count].length = 1;
+            runs[count].color = color;
+            count++;
+        }
+    }
+    return WS2812B_Pattern_SetRuns(p, runs, count);
+}
+
+/**
+ * @brief Set one color of the pattern.
+ * @note Does nothing if index is out of range.
+ */
+void WS2812B_Pattern_SetColor(ws2812b_pattern_t *p, uint8_t index, uint8_t red, uint8_t green, uint8_t blue)
+{
+    if (index >= WS2812B_PATTERN_MAX_COLORS) return;
+
+    p->colors[index][0] = red;
+    p->colors[index][1] = green;
+    p->colors[index][2] = blue;
+}
+
+/**
+ * @brief Set the phase directly.
+ */
+void WS2812B_Pattern_SetPhase(ws2812b_pattern_t *p, uint16_t phase)
+{
+    p->phase = (p->period != 0) ? phase % p->period : 0;
+}
+
+/**
+ * @brief Move the pattern (one modulo per call, not per LED).
+ */
+void WS2812B_Pattern_Step(ws2812b_pattern_t *p, int16_t steps)
+{
+    if (p->period == 0) return;
+
+    int32_t phase = ((int32_t)p->phase + steps) % p->period;
+    if (phase < 0) phase += p->period;
+    p->phase = (uint16_t)phase;
+}
+
+/**
+ * @brief Encode the pattern into the PWM buffer.
+ * @note LED 0 starts at template position (period - phase) mod period.
+ */
+WS2812B_RAMFUNC void WS2812B_Pattern_Encode(const ws2812b_pattern_t *p)
+{
+    ws2812b_pwm_t encoded[WS2812B_PATTERN_MAX_COLORS][24];
+    const uint16_t n = WS2812B_RenderLength();
+    ws2812b_pwm_t *dst = pwmData;
+
+    for (uint8_t c = 0; c < WS2812B_PATTERN_MAX_COLORS; c++)
+    {
+        WS2812B_EncodeRGB(encoded[c], p->colors[c][0], p->colors[c][1], p->colors[c][2]);
+    }
+
+    if (p->run_count == 0)
+    {
+        for (uint16_t i = 0; i < n; i++, dst += 24)
+        {
+            memcpy(dst, encoded[0], sizeof(encoded[0]));
+        }
+        WS2812B_ApplyMirror();
+        return;
+    }
+
+    // Locate the run holding the first LED
+    uint16_t pos = (p->phase == 0) ? 0 : p->period - p->phase;
+    uint8_t run = 0;
+    while (pos >= p->runs[run].length)
+    {
+        pos -= p->runs[run].length;
+        run++;
+    }
+    uint8_t left = (uint8_t)(p->runs[run].length - pos);
+    const ws2812b_pwm_t *block = encoded[p->runs[run].color];
+
+    for (uint16_t i = 0; i < n; i++, dst += 24)
+    {
+        memcpy(dst, block, sizeof(encoded[0]));
+        if (--left == 0)
+        {
+            if (++run == p->run_count) run = 0;
+            left = p->runs[run].length;
+            block = encoded[p->runs[run].color];
+        }
+    }
+    WS2812B_ApplyMirror();
+}
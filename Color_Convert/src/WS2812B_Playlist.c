@@ -0,0 +1,366 @@
+/**
+ * @file WS2812B_Playlist.c
+ * @brief Playlist sequencing, weighted shuffle without repeats, and flash storage.
+ *
+ * The stored copy lives in a 1 KB flash page reserved by the linker script
+ * (_splaylist). An erased page reads as all 0xFF and fails the checksum.
+ * Tick compares one timestamp per frame; the entry selection (a weighted
+ * draw over the entries not yet played this round) only runs on a switch.
+ */
+
+#include "WS2812B_Playlist.h"
+#include "WS2812B_Preset.h"
+#include "WS2812B_Profile.h"
+#include <stddef.h>
+#include <string.h>
+
+_Static_assert(sizeof(ws2812b_playlist_entry_t) == 6, "ws2812b_playlist_entry_t must stay 6 bytes (flash layout)");
+_Static_assert(sizeof(ws2812b_playlist_t) <= 1024, "Playlist must fit one flash page");
+_Static_assert(WS2812B_PLAYLIST_MAX_ENTRIES <= 16, "played_mask holds 16 entries");
+
+/** @brief Start of the playlist page (linker script). */
+extern const ws2812b_playlist_t _splaylist[];
+
+extern RTC_HandleTypeDef hrtc;
+
+static ws2812b_playlist_t playlist;
+
+// Sequencer state (render loop only)
+static bool active = false;
+static bool switch_pending = false;
+static int current = -1;
+static uint16_t played_mask = 0;    ///< Entries played in this shuffle round
+static uint32_t entry_start = 0;
+static uint32_t entry_ms = 0;
+static uint32_t rng_state = 0x2545F491UL;
+
+/**
+ * @brief Checksum of a playlist (all bytes except @c check).
+ */
+static uint8_t playlist_checksum(const ws2812b_playlist_t *pl)
+{
+    const uint8_t *p = (const uint8_t *)pl;
+    uint8_t sum = 0xA5;
+
+    for (uint32_t i = 0; i < sizeof(*pl); i++)
+    {
+        if (i == offsetof(ws2812b_playlist_t, check)) continue;
+        sum = (uint8_t)(((sum << 1) | (sum >> 7)) + p[i]);
+    }
+    return (uint8_t)~sum;
+}
+
+/**
+ * @brief Validate every entry in use.
+ */
+static bool playlist_valid(const ws2812b_playlist_t *pl)
+{
+    if (pl->count > WS2812B_PLAYLIST_MAX_ENTRIES) return false;
+
+    for (uint8_t i = 0; i < pl->count; i++)
+    {
+        const ws2812b_playlist_entry_t *e = &pl->entries[i];
+        if (e->duration_ds == 0) return false;
+        if (e->type == PLAYLIST_ENTRY_EFFECT && e->index >= WS2812B_EFFECT_COUNT) return false;
+        if (e->type == PLAYLIST_ENTRY_PRESET && e->index >= WS2812B_PRESET_COUNT) return false;
+        if (e->type > PLAYLIST_ENTRY_PRESET) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief xorshift32 step.
+ */
+static uint32_t playlist_random(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/**
+ * @brief Pick the entry to play after @c current.
+ * @return Entry index, or -1 if every weight is zero.
+ */
+static int playlist_pick(void)
+{
+    if (!(playlist.flags & PLAYLIST_FLAG_SHUFFLE))
+    {
+        for (uint8_t n = 1; n <= playlist.count; n++)
+        {
+            int i = (current + n) % playlist.count;
+            if (playlist.entries[i].weight != 0) return i;
+        }
+        return -1;
+    }
+
+    // Weighted draw among the entries not played in this round
+    uint16_t skip = played_mask;
+    for (int round = 0; round < 2; round++)
+    {
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < playlist.count; i++)
+        {
+            if (!(skip & (1U << i))) total += playlist.entries[i].weight;
+        }
+
+        if (total > 0)
+        {
+            uint32_t r = playlist_random() % total;
+            for (uint8_t i = 0; i < playlist.count; i++)
+            {
+                if (skip & (1U << i)) continue;
+                if (r < playlist.entries[i].weight) return i;
+                r -= playlist.entries[i].weight;
+            }
+        }
+
+        // Round complete: start a new one, but not with the entry that just played
+        played_mask = 0;
+        skip = (current >= 0) ? (uint16_t)(1U << current) : 0;
+    }
+
+    return (current >= 0 && playlist.entries[current].weight != 0) ? current : -1;
+}
+
+/**
+ * @brief Boot entropy for the shuffle seed.
+ * @note The DWT cycle count (enabled early in main()) varies with the LSE
+ *       start-up time, and the battery-backed RTC counter differs on every
+ *       boot. The mix is spread with the murmur3 finalizer.
+ */
+static uint32_t boot_entropy(void)
+{
+    uint32_t x = WS2812B_Profile_Cycles() ^ (HAL_GetTick() * 0x9E3779B9UL);
+
+    if (hrtc.Instance != NULL)
+    {
+        x ^= (((uint32_t)hrtc.Instance->CNTH << 16) | (hrtc.Instance->CNTL & 0xFFFFU)) * 0x85EBCA6BUL;
+    }
+    x ^= x >> 16;
+    x *= 0x85EBCA6BUL;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35UL;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Seed the shuffle from boot entropy, load the playlist stored in
+ *        flash and start it if requested.
+ */
+void WS2812B_Playlist_Init(void)
+{
+    const ws2812b_playlist_t *stored = _splaylist;
+
+    WS2812B_Playlist_Seed(boot_entropy());
+
+    if (stored->check != playlist_checksum(stored) || !WS2812B_Playlist_Set(stored)) return;
+    if (playlist.flags & PLAYLIST_FLAG_AUTOSTART)
+    {
+        WS2812B_Playlist_Start();
+    }
+}
+
+/**
+ * @brief Install a playlist (stops the running one).
+ * @return false if it is invalid.
+ */
+bool WS2812B_Playlist_Set(const ws2812b_playlist_t* pl)
+{
+    if (!playlist_valid(pl)) return false;
+
+    WS2812B_Playlist_Stop();
+    playlist = *pl;
+    memset(&playlist.entries[playlist.count], 0,
+           (WS2812B_PLAYLIST_MAX_ENTRIES - playlist.count) * sizeof(playlist.entries[0]));
+    playlist.reserved = 0;
+    playlist.check = 0;
+    return true;
+}
+
+/**
+ * @brief Install a playlist from its serial form.
+ * @return false if the payload is malformed or the playlist invalid.
+ */
+bool WS2812B_Playlist_Load(const uint8_t* data, uint16_t len)
+{
+    ws2812b_playlist_t pl;
+
+    if (len < 2 || data[0] > WS2812B_PLAYLIST_MAX_ENTRIES || len != WS2812B_PLAYLIST_WIRE_SIZE(data[0])) return false;
+
+    memset(&pl, 0, sizeof(pl));
+    pl.count = data[0];
+    pl.flags = data[1];
+    for (uint8_t i = 0; i < pl.count; i++)
+    {
+        const uint8_t *p = &data[2 + 6 * i];
+        pl.entries[i].type = p[0];
+        pl.entries[i].index = p[1];
+        pl.entries[i].weight = p[2];
+        pl.entries[i].fade_frames = p[3];
+        pl.entries[i].duration_ds = (uint16_t)(p[4] | (p[5] << 8));
+    }
+    return WS2812B_Playlist_Set(&pl);
+}
+
+/**
+ * @brief Current playlist.
+ */
+const ws2812b_playlist_t* WS2812B_Playlist_Get(void)
+{
+    return &playlist;
+}
+
+/**
+ * @brief Start the playlist; the first entry is applied on the next Tick.
+ * @return false if no entry has a non-zero weight.
+ */
+bool WS2812B_Playlist_Start(void)
+{
+    bool playable = false;
+    for (uint8_t i = 0; i < playlist.count; i++)
+    {
+        if (playlist.entries[i].weight != 0) playable = true;
+    }
+    if (!playable) return false;
+
+    current = -1;
+    played_mask = 0;
+    switch_pending = true;
+    active = true;
+    return true;
+}
+
+/**
+ * @brief Stop the playlist.
+ */
+void WS2812B_Playlist_Stop(void)
+{
+    active = false;
+    switch_pending = false;
+    current = -1;
+}
+
+/**
+ * @brief Switch to the next entry on the next Tick.
+ */
+void WS2812B_Playlist_Next(void)
+{
+    if (active) switch_pending = true;
+}
+
+/**
+ * @brief Check whether the playlist is running.
+ */
+bool WS2812B_Playlist_IsActive(void)
+{
+    return active;
+}
+
+/**
+ * @brief Index of the entry playing now, or -1.
+ */
+int WS2812B_Playlist_Current(void)
+{
+    return active ? current : -1;
+}
+
+/**
+ * @brief Seed the shuffle generator.
+ */
+void WS2812B_Playlist_Seed(uint32_t seed)
+{
+    rng_state = (seed != 0) ? seed : 0x2545F491UL;
+}
+
+/**
+ * @brief Advance the playlist at an explicit time.
+ * @param effects Effect state owned by the render loop.
+ * @param now Time in ms
+ */
+void WS2812B_Playlist_TickAt(ws2812b_effects_t* effects, uint32_t now)
+{
+    if (!active) return;
+
+    effects->auto_cycle = false;    // The playlist owns effect changes
+    if (!switch_pending && (now - entry_start) < entry_ms) return;
+
+    switch_pending = false;
+    int next = playlist_pick();
+    if (next < 0)
+    {
+        WS2812B_Playlist_Stop();
+        return;
+    }
+
+    const ws2812b_playlist_entry_t *e = &playlist.entries[next];
+    current = next;
+    played_mask |= (uint16_t)(1U << next);
+    entry_start = now;
+    entry_ms = (uint32_t)e->duration_ds * 100U;
+
+    if (e->type == PLAYLIST_ENTRY_EFFECT)
+    {
+        WS2812B_Effects_SetEffect(effects, (ws2812b_effect_t)e->index);
+    }
+    else if (!WS2812B_Preset_Recall(effects, e->index, e->fade_frames))
+    {
+        switch_pending = true;  // Empty user slot: skip it on the next frame
+    }
+    effects->auto_cycle = false;    // A recalled preset may have enabled it
+}
+
+/**
+ * @brief Advance the playlist (call once per frame, after WS2812B_Preset_Tick()).
+ * @param effects Effect state owned by the render loop.
+ */
+void WS2812B_Playlist_Tick(ws2812b_effects_t* effects)
+{
+    WS2812B_Playlist_TickAt(effects, HAL_GetTick());
+}
+
+// ===================================================================
+// ============================== FLASH ==============================
+// ===================================================================
+
+/**
+ * @brief Flash address of the playlist page, as the HAL takes it.
+ * @note uintptr_t: 32 bits on the target, and no truncation on a 64-bit host.
+ */
+static inline uintptr_t playlist_flash_addr(void)
+{
+    return (uintptr_t)_splaylist;
+}
+
+/**
+ * @brief Store the current playlist in its flash page.
+ * @return false on a flash error.
+ */
+bool WS2812B_Playlist_Save(void)
+{
+    static ws2812b_playlist_t record;
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_PAGES,
+        .PageAddress = playlist_flash_addr(),
+        .NbPages = 1
+    };
+    uint32_t page_error;
+    bool ok;
+
+    record = playlist;
+    record.check = playlist_checksum(&record);
+
+    HAL_FLASH_Unlock();
+    ok = (HAL_FLASHEx_Erase(&erase, &page_error) == HAL_OK);
+
+    const uint16_t *p = (const uint16_t *)&record;
+    for (uint32_t i = 0; ok && i < sizeof(record) / 2; i++)
+    {
+        ok = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, playlist_flash_addr() + i * 2, p[i]) == HAL_OK);
+    }
+    HAL_FLASH_Lock();
+
+    return ok;
+}
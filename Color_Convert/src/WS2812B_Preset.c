@@ -0,0 +1,265 @@
+/**
+ * @file WS2812B_Preset.c
+ * @brief Scene preset tables, recall with dip-to-black crossfade, and flash storage.
+ *
+ * User slots live in a 1 KB flash page reserved by the linker script
+ * (_spresets). An erased slot reads as all 0xFF and fails the checksum, so
+ * no separate "used" flag is needed.
+ */
+
+#define _POSIX_C_SOURCE 200809L     // strnlen() under -std=c11
+
+#include "WS2812B_Preset.h"
+#include "WS2812B_Palette.h"
+#include <stddef.h>
+#include <string.h>
+
+_Static_assert(sizeof(ws2812b_preset_t) == 20, "ws2812b_preset_t must stay 20 bytes (flash layout)");
+_Static_assert(WS2812B_PRESET_USER_SLOTS * sizeof(ws2812b_preset_t) <= 1024, "User presets must fit one flash page");
+
+/** @brief Start of the user preset page (linker script). */
+extern const ws2812b_preset_t _spresets[];
+
+/**
+ * @brief Built-in presets.
+ */
+static const ws2812b_preset_t builtin_presets[WS2812B_PRESET_BUILTIN_COUNT] = {
+    // name       effect                brt  spd  flags                                        hue  cycle psat pval
+    { "Rainbow",  EFFECT_RAINBOW_CHASE,  80,  40, 0,                                            0,   0,    0,   0,  0, 0 },
+    { "Fire",     EFFECT_FIRE,           70,  60, 0,                                            20,  0,    0,   0,  0, 0 },
+    { "Calm",     EFFECT_BREATHE,        50,  15, 0,                                            200, 0,    0,   0,  0, 0 },
+    { "Party",    EFFECT_THEATER_CHASE,  100, 90, PRESET_FLAG_AUTO_CYCLE,                       0,   40,   0,   0,  0, 0 },
+    { "Stars",    EFFECT_TWINKLE,        60,  30, 0,                                            240, 0,    0,   0,  0, 0 },
+    { "Demo",     EFFECT_RAINBOW_CHASE,  80,  40, PRESET_FLAG_AUTO_CYCLE | PRESET_FLAG_PALETTE, 0,   40,   100, 100, 0, 0 },
+};
+
+// Crossfade state (render loop only)
+static const ws2812b_preset_t *fade_target = NULL;
+static uint16_t fade_pos = 0;
+static uint16_t fade_out = 0;       ///< Frames fading to black
+static uint16_t fade_total = 0;     ///< Total fade frames
+static uint8_t fade_start = 0;      ///< Brightness when the fade started
+
+/**
+ * @brief Checksum of a record (all bytes before @c check).
+ * @note Never 0xFF for an erased (all 0xFF) record.
+ */
+static uint8_t preset_checksum(const ws2812b_preset_t *preset)
+{
+    const uint8_t *p = (const uint8_t *)preset;
+    uint8_t sum = 0x5A;
+
+    for (uint32_t i = 0; i < offsetof(ws2812b_preset_t, check); i++)
+    {
+        sum = (uint8_t)(((sum << 1) | (sum >> 7)) + p[i]);
+    }
+    return (uint8_t)~sum;
+}
+
+/**
+ * @brief Get a preset record.
+ * @param index Preset index
+ * @return Pointer into flash, or NULL if the index is out of range or the user slot is empty.
+ */
+const ws2812b_preset_t* WS2812B_Preset_Get(uint8_t index)
+{
+    if (index < WS2812B_PRESET_BUILTIN_COUNT) return &builtin_presets[index];
+    if (index >= WS2812B_PRESET_COUNT) return NULL;
+
+    const ws2812b_preset_t *preset = &_spresets[index - WS2812B_PRESET_BUILTIN_COUNT];
+    if (preset->check != preset_checksum(preset) || preset->effect >= WS2812B_EFFECT_COUNT) return NULL;
+    return preset;
+}
+
+/**
+ * @brief Load a record into the engine (brightness is set by the caller).
+ */
+static void preset_apply(ws2812b_effects_t *effects, const ws2812b_preset_t *preset)
+{
+    WS2812B_Effects_SetEffect(effects, (ws2812b_effect_t)preset->effect);
+    effects->auto_cycle = (preset->flags & PRESET_FLAG_AUTO_CYCLE) != 0;
+    effects->hue = preset->hue % 360;
+    effects->effect_speed = preset->speed;
+    if (preset->cycle_ds != 0)
+    {
+        effects->cycle_duration = (uint32_t)preset->cycle_ds * 100U;
+    }
+    WS2812B_SetSpeed(preset->speed);
+
+    if (preset->flags & PRESET_FLAG_PALETTE)
+    {
+        WS2812B_Palette_Rainbow(0, WS2812B_PALETTE_SIZE, preset->palette_sat, preset->palette_val);
+    }
+}
+
+/**
+ * @brief Set engine and global brightness together.
+ */
+static void preset_set_brightness(ws2812b_effects_t *effects, uint8_t brightness)
+{
+    effects->brightness = brightness;
+    WS2812B_SetBrightness(brightness);
+}
+
+/**
+ * @brief Recall a preset.
+ * @param effects Effect state owned by the render loop.
+ * @param index Preset index
+ * @param fade_frames Crossfade length in frames (0 = switch immediately)
+ * @return false if the preset does not exist (state unchanged).
+ * @note A recall during a running fade restarts it from the current brightness.
+ */
+bool WS2812B_Preset_Recall(ws2812b_effects_t* effects, uint8_t index, uint16_t fade_frames)
+{
+    const ws2812b_preset_t *preset = WS2812B_Preset_Get(index);
+    if (preset == NULL) return false;
+
+    if (fade_frames < 2)
+    {
+        fade_target = NULL;
+        preset_apply(effects, preset);
+        preset_set_brightness(effects, preset->brightness);
+        return true;
+    }
+
+    fade_target = preset;
+    fade_pos = 0;
+    fade_out = fade_frames / 2;
+    fade_total = fade_frames;
+    fade_start = WS2812B_GetBrightness();
+    return true;
+}
+
+/**
+ * @brief Advance a running crossfade by one frame.
+ * @param effects Effect state owned by the render loop.
+ */
+void WS2812B_Preset_Tick(ws2812b_effects_t* effects)
+{
+    if (fade_target == NULL) return;
+
+    fade_pos++;
+    if (fade_pos <= fade_out)
+    {
+        preset_set_brightness(effects, (uint8_t)((uint32_t)fade_start * (fade_out - fade_pos) / fade_out));
+        if (fade_pos == fade_out)
+        {
+            preset_apply(effects, fade_target);
+        }
+    }
+    else
+    {
+        uint16_t fade_in = fade_total - fade_out;
+        preset_set_brightness(effects, (uint8_t)((uint32_t)fade_target->brightness * (fade_pos - fade_out) / fade_in));
+        if (fade_pos >= fade_total)
+        {
+            fade_target = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Check whether a crossfade is in progress.
+ */
+bool WS2812B_Preset_IsFading(void)
+{
+    return fade_target != NULL;
+}
+
+/**
+ * @brief Serialize the current engine state into a preset record.
+ * @param effects Current effect state.
+ * @param name Name (truncated to WS2812B_PRESET_NAME_LEN)
+ * @param[out] preset Record to fill (palette fields are left disabled).
+ */
+void WS2812B_Preset_Capture(const ws2812b_effects_t* effects, const char* name, ws2812b_preset_t* preset)
+{
+    memset(preset, 0, sizeof(*preset));
+    memcpy(preset->name, name, strnlen(name, WS2812B_PRESET_NAME_LEN));    // Zero-padded, unterminated if full
+    preset->effect = (uint8_t)effects->current_effect;
+    preset->brightness = WS2812B_GetBrightness();
+    preset->speed = WS2812B_GetSpeed();
+    preset->flags = effects->auto_cycle ? PRESET_FLAG_AUTO_CYCLE : 0;
+    preset->hue = effects->hue;
+    preset->cycle_ds = (uint16_t)((effects->cycle_duration + 50U) / 100U);
+    preset->check = preset_checksum(preset);
+}
+
+// ===================================================================
+// ============================== FLASH ==============================
+// ===================================================================
+
+/**
+ * @brief Flash address of a record in the preset page, as the HAL takes it.
+ * @note uintptr_t: 32 bits on the target, and no truncation on a 64-bit host.
+ */
+static inline uintptr_t preset_flash_addr(const ws2812b_preset_t *record)
+{
+    return (uintptr_t)record;
+}
+
+/**
+ * @brief Program records half-word by half-word.
+ * @param addr Flash address (erased)
+ * @param data Records to write
+ * @param len Length in bytes (multiple of 2)
+ * @return true on success.
+ */
+static bool preset_program(uintptr_t addr, const void *data, uint32_t len)
+{
+    const uint16_t *p = data;
+
+    for (uint32_t i = 0; i < len / 2; i++)
+    {
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, addr + i * 2, p[i]) != HAL_OK) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Store a record in a user slot.
+ * @param slot User slot (0 .. WS2812B_PRESET_USER_SLOTS-1)
+ * @param preset Record to store (the stored copy gets a fresh checksum).
+ * @return false on an invalid slot or a flash error.
+ */
+bool WS2812B_Preset_Save(uint8_t slot, const ws2812b_preset_t* preset)
+{
+    static ws2812b_preset_t page[WS2812B_PRESET_USER_SLOTS];
+
+    if (slot >= WS2812B_PRESET_USER_SLOTS) return false;
+
+    ws2812b_preset_t record = *preset;
+    record.check = preset_checksum(&record);
+
+    // An erased slot can be programmed directly
+    const uint8_t *dst = (const uint8_t *)&_spresets[slot];
+    bool erased = true;
+    for (uint32_t i = 0; i < sizeof(record); i++)
+    {
+        if (dst[i] != 0xFF) { erased = false; break; }
+    }
+
+    bool ok;
+    HAL_FLASH_Unlock();
+    if (erased)
+    {
+        ok = preset_program(preset_flash_addr(&_spresets[slot]), &record, sizeof(record));
+    }
+    else
+    {
+        FLASH_EraseInitTypeDef erase = {
+            .TypeErase = FLASH_TYPEERASE_PAGES,
+            .PageAddress = preset_flash_addr(_spresets),
+            .NbPages = 1
+        };
+        uint32_t page_error;
+
+        memcpy(page, _spresets, sizeof(page));
+        page[slot] = record;
+        ok = (HAL_FLASHEx_Erase(&erase, &page_error) == HAL_OK)
+          && preset_program(preset_flash_addr(_spresets), page, sizeof(page));
+    }
+    HAL_FLASH_Lock();
+
+    return ok;
+}
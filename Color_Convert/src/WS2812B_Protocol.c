@@ -0,0 +1,630 @@
+/**
+ * @file WS2812B_Protocol.c
+ * @brief Byte-stream parser for the serial protocol and its USART/DMA glue.
+ *
+ * The payload is staged in a buffer sized for the largest valid packet; the
+ * length field is checked before a single payload byte is stored, and frame
+ * payloads are validated in full (offset, pixel count, RLE run total) before
+ * the framebuffer is touched. Payload bytes are copied and CRC'd in chunks,
+ * not one state-machine step per byte.
+ */
+
+#include "WS2812B_Protocol.h"
+#include "WS2812B_Frame.h"
+#include "WS2812B_Playlist.h"
+#include "WS2812B_Tween.h"
+#include "WS2812B_Current.h"
+#include <string.h>
+
+_Static_assert((WS2812B_PROTOCOL_RX_SIZE & (WS2812B_PROTOCOL_RX_SIZE - 1)) == 0,
+               "WS2812B_PROTOCOL_RX_SIZE must be a power of two");
+_Static_assert(WS2812B_PROTOCOL_MAX_PAYLOAD >= 5 && WS2812B_PROTOCOL_MAX_PAYLOAD <= 0xFFFF,
+               "WS2812B_PROTOCOL_MAX_PAYLOAD must hold a command and fit the length field");
+
+/** @brief CRC-8, polynomial 0x07, init 0x00. */
+static const uint8_t crc8_table[256] = {
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
+    0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65, 0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D,
+    0xE0, 0xE7, 0xEE, 0xE9, 0xFC, 0xFB, 0xF2, 0xF5, 0xD8, 0xDF, 0xD6, 0xD1, 0xC4, 0xC3, 0xCA, 0xCD,
+    0x90, 0x97, 0x9E, 0x99, 0x8C, 0x8B, 0x82, 0x85, 0xA8, 0xAF, 0xA6, 0xA1, 0xB4, 0xB3, 0xBA, 0xBD,
+    0xC7, 0xC0, 0xC9, 0xCE, 0xDB, 0xDC, 0xD5, 0xD2, 0xFF, 0xF8, 0xF1, 0xF6, 0xE3, 0xE4, 0xED, 0xEA,
+    0xB7, 0xB0, 0xB9, 0xBE, 0xAB, 0xAC, 0xA5, 0xA2, 0x8F, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9D, 0x9A,
+    0x27, 0x20, 0x29, 0x2E, 0x3B, 0x3C, 0x35, 0x32, 0x1F, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0D, 0x0A,
+    0x57, 0x50, 0x59, 0x5E, 0x4B, 0x4C, 0x45, 0x42, 0x6F, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7D, 0x7A,
+    0x89, 0x8E, 0x87, 0x80, 0x95, 0x92, 0x9B, 0x9C, 0xB1, 0xB6, 0xBF, 0xB8, 0xAD, 0xAA, 0xA3, 0xA4,
+    0xF9, 0xFE, 0xF7, 0xF0, 0xE5, 0xE2, 0xEB, 0xEC, 0xC1, 0xC6, 0xCF, 0xC8, 0xDD, 0xDA, 0xD3, 0xD4,
+    0x69, 0x6E, 0x67, 0x60, 0x75, 0x72, 0x7B, 0x7C, 0x51, 0x56, 0x5F, 0x58, 0x4D, 0x4A, 0x43, 0x44,
+    0x19, 0x1E, 0x17, 0x10, 0x05, 0x02, 0x0B, 0x0C, 0x21, 0x26, 0x2F, 0x28, 0x3D, 0x3A, 0x33, 0x34,
+    0x4E, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5C, 0x5B, 0x76, 0x71, 0x78, 0x7F, 0x6A, 0x6D, 0x64, 0x63,
+    0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B, 0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13,
+    0xAE, 0xA9, 0xA0, 0xA7, 0xB2, 0xB5, 0xBC, 0xBB, 0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
+    0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB, 0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3,
+};
+
+/**
+ * @brief Parser states.
+ */
+typedef enum {
+    PARSE_SYNC,
+    PARSE_TYPE,
+    PARSE_LEN_LO,
+    PARSE_LEN_HI,
+    PARSE_PAYLOAD,
+    PARSE_CRC
+} parse_state_t;
+
+static parse_state_t parse_state = PARSE_SYNC;
+static uint8_t packet_type;
+static uint16_t packet_len;
+static uint16_t packet_pos;
+static uint8_t packet_crc;
+static uint8_t packet_buf[WS2812B_PROTOCOL_MAX_PAYLOAD];
+
+static ws2812b_protocol_stats_t stats;
+static bool frame_received = false;
+static uint32_t feed_tick = 0;      ///< Arrival time of the bytes being parsed
+
+static ws2812b_cmd_queue_t protocol_queue;
+
+/**
+ * @brief Update a CRC-8 over a block.
+ */
+static uint8_t crc8_update(uint8_t crc, const uint8_t *data, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        crc = crc8_table[crc ^ data[i]];
+    }
+    return crc;
+}
+
+/**
+ * @brief Read a little-endian uint16.
+ */
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// ===================================================================
+// ============================ DECODERS =============================
+// ===================================================================
+
+/**
+ * @brief Apply a command packet.
+ * @return false if the payload is malformed.
+ */
+static bool decode_command(const uint8_t *p, uint16_t len)
+{
+    if (len != 5) return false;
+
+    int32_t value = (int32_t)((uint32_t)p[1] | ((uint32_t)p[2] << 8) | ((uint32_t)p[3] << 16) | ((uint32_t)p[4] << 24));
+    if (WS2812B_CmdQueue_Push(&protocol_queue, p[0], value))
+    {
+        stats.commands++;
+    }
+    return true;
+}
+
+/**
+ * @brief Apply a raw frame packet.
+ * @return false if the payload is malformed or exceeds the strip.
+ */
+static bool decode_frame(const uint8_t *p, uint16_t len)
+{
+    if (len < 2 || (len - 2) % 3 != 0) return false;
+
+    uint32_t first = read_u16(p);
+    uint32_t count = (len - 2U) / 3U;
+    if (first > LED_NUM || count > LED_NUM - first) return false;
+    if (WS2812B_Frame_GetScale() != 1) WS2812B_Frame_SetScale(1);  // Streamed pixels are physical LEDs
+
+    p += 2;
+    for (uint32_t i = 0; i < count; i++, p += 3)
+    {
+        WS2812B_Frame_SetPixelRGB((uint16_t)(first + i), p[0], p[1], p[2]);
+    }
+    return true;
+}
+
+/**
+ * @brief Apply a run-length encoded frame packet.
+ * @return false if the payload is malformed or its runs exceed the strip.
+ * @note Validates the run total in a first pass so a bad packet writes nothing.
+ */
+static bool decode_frame_rle(const uint8_t *p, uint16_t len)
+{
+    if (len < 2 || (len - 2) % 4 != 0) return false;
+
+    uint32_t first = read_u16(p);
+    if (first > LED_NUM) return false;
+
+    const uint8_t *runs = p + 2;
+    uint32_t run_count = (len - 2U) / 4U;
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < run_count; i++)
+    {
+        uint8_t n = runs[i * 4];
+        if (n == 0) return false;
+        total += n;
+    }
+    if (total > LED_NUM - first) return false;
+    if (WS2812B_Frame_GetScale() != 1) WS2812B_Frame_SetScale(1);
+
+    uint32_t pixel = first;
+    for (uint32_t i = 0; i < run_count; i++, runs += 4)
+    {
+        for (uint8_t n = runs[0]; n > 0; n--)
+        {
+            WS2812B_Frame_SetPixelRGB((uint16_t)pixel++, runs[1], runs[2], runs[3]);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Dispatch a packet whose CRC matched.
+ */
+static void dispatch_packet(void)
+{
+    bool ok;
+
+    switch (packet_type)
+    {
+        case PACKET_COMMAND:
+            ok = decode_command(packet_buf, packet_len);
+            break;
+
+        case PACKET_FRAME:
+            ok = decode_frame(packet_buf, packet_len);
+            break;
+
+        case PACKET_FRAME_RLE:
+            ok = decode_frame_rle(packet_buf, packet_len);
+            break;
+
+        case PACKET_PLAYLIST:
+            ok = WS2812B_Playlist_Load(packet_buf, packet_len);
+            break;
+
+        default:
+            ok = false;
+            break;
+    }
+
+    if (!ok)
+    {
+        stats.decode_errors++;
+        return;
+    }
+
+    stats.packets++;
+    if (packet_type == PACKET_FRAME || packet_type == PACKET_FRAME_RLE)
+    {
+        stats.frames++;
+        frame_received = true;
+        WS2812B_Tween_Push(feed_tick);
+    }
+}
+
+// ===================================================================
+// ========================== PARSER CORE ============================
+// ===================================================================
+
+/**
+ * @brief Reset the parser to the sync-hunting state (statistics are kept).
+ */
+void WS2812B_Protocol_Reset(void)
+{
+    parse_state = PARSE_SYNC;
+    packet_pos = 0;
+    frame_received = false;
+}
+
+/**
+ * @brief Parse received bytes that arrived at a known time.
+ * @param data Received bytes
+ * @param len Number of bytes
+ * @param now Arrival time in ms (timestamps frames for WS2812B_Tween)
+ */
+void WS2812B_Protocol_FeedAt(const uint8_t *data, uint32_t len, uint32_t now)
+{
+    feed_tick = now;
+    WS2812B_Protocol_Feed(data, len);
+}
+
+/**
+ * @brief Parse received bytes and apply every complete, valid packet.
+ * @param data Received bytes (any split across calls is allowed)
+ * @param len Number of bytes
+ */
+void WS2812B_Protocol_Feed(const uint8_t *data, uint32_t len)
+{
+    uint32_t i = 0;
+
+    while (i < len)
+    {
+        uint8_t byte = data[i];
+
+        switch (parse_state)
+        {
+            case PARSE_SYNC:
+            {
+                // Skip to the next sync byte in one scan
+                const uint8_t *sync = memchr(&data[i], WS2812B_PROTOCOL_SYNC, len - i);
+                if (sync == NULL)
+                {
+                    stats.dropped_bytes += len - i;
+                    return;
+                }
+                stats.dropped_bytes += (uint32_t)(sync - &data[i]);
+                i = (uint32_t)(sync - data) + 1;
+                parse_state = PARSE_TYPE;
+                continue;
+            }
+
+            case PARSE_TYPE:
+                packet_type = byte;
+                packet_crc = crc8_table[byte];
+                parse_state = PARSE_LEN_LO;
+                break;
+
+            case PARSE_LEN_LO:
+                packet_len = byte;
+                packet_crc = crc8_table[packet_crc ^ byte];
+                parse_state = PARSE_LEN_HI;
+                break;
+
+            case PARSE_LEN_HI:
+                packet_len |= (uint16_t)(byte << 8);
+                packet_crc = crc8_table[packet_crc ^ byte];
+                if (packet_len > WS2812B_PROTOCOL_MAX_PAYLOAD)
+                {
+                    stats.length_errors++;
+                    parse_state = PARSE_SYNC;
+                }
+                else
+                {
+                    packet_pos = 0;
+                    parse_state = (packet_len == 0) ? PARSE_CRC : PARSE_PAYLOAD;
+                }
+                break;
+
+            case PARSE_PAYLOAD:
+            {
+                uint32_t n = packet_len - packet_pos;
+                if (n > len - i) n = len - i;
+
+                memcpy(&packet_buf[packet_pos], &data[i], n);
+                packet_crc = crc8_update(packet_crc, &data[i], n);
+                packet_pos += (uint16_t)n;
+                i += n;
+                if (packet_pos == packet_len)
+                {
+                    parse_state = PARSE_CRC;
+                }
+                continue;
+            }
+
+            case PARSE_CRC:
+                if (byte == packet_crc)
+                {
+                    dispatch_packet();
+                }
+                else
+                {
+                    stats.crc_errors++;
+                }
+                parse_state = PARSE_SYNC;
+                break;
+        }
+        i++;
+    }
+}
+
+/**
+ * @brief Check for and clear the "new frame received" flag.
+ * @return true if at least one frame packet was applied since the last call.
+ */
+bool WS2812B_Protocol_TakeFrame(void)
+{
+    bool received = frame_received;
+    frame_received = false;
+    return received;
+}
+
+/**
+ * @brief Copy the parser statistics.
+ * @param[out] out Statistics
+ */
+void WS2812B_Protocol_GetStats(ws2812b_protocol_stats_t *out)
+{
+    *out = stats;
+}
+
+/**
+ * @brief Build a packet.
+ * @param type @ref ws2812b_packet_type_t
+ * @param payload Payload bytes
+ * @param len Payload length
+ * @param[out] out Buffer of at least len + WS2812B_PROTOCOL_OVERHEAD bytes
+ * @return Packet length in bytes.
+ */
+uint32_t WS2812B_Protocol_BuildPacket(uint8_t type, const uint8_t *payload, uint16_t len, uint8_t *out)
+{
+    out[0] = WS2812B_PROTOCOL_SYNC;
+    out[1] = type;
+    out[2] = (uint8_t)len;
+    out[3] = (uint8_t)(len >> 8);
+    memmove(&out[4], payload, len);
+    out[4 + len] = crc8_update(0, &out[1], 3U + len);
+    return WS2812B_PROTOCOL_OVERHEAD + len;
+}
+
+static uint8_t *put_le16(uint8_t *out, uint16_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    return out + 2;
+}
+
+static uint8_t *put_le32(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+    return out + 4;
+}
+
+static uint16_t get_le16(const uint8_t **in)
+{
+    const uint8_t *p = *in;
+    *in = p + 2;
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_le32(const uint8_t **in)
+{
+    const uint8_t *p = *in;
+    *in = p + 4;
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Collect the device status from the modules.
+ * @param[out] status Status
+ */
+void WS2812B_Protocol_GetStatus(ws2812b_status_t *status)
+{
+    status->version = WS2812B_STATUS_VERSION;
+    status->clock_path = (uint8_t)system_clock_path;
+    status->timer_period = (uint16_t)htim3.Init.Period;
+    status->uptime_ms = HAL_GetTick();
+    status->output_scale = WS2812B_GetOutputScale();
+    status->protocol = stats;
+    WS2812B_Tween_GetStats(&status->tween);
+    WS2812B_Current_GetStats(&status->current);
+}
+
+/**
+ * @brief Serialize a status, little-endian, fields in declaration order.
+ * @param status Status
+ * @param[out] out Buffer of WS2812B_STATUS_SIZE bytes
+ */
+void WS2812B_Protocol_PackStatus(const ws2812b_status_t *status, uint8_t *out)
+{
+    const ws2812b_protocol_stats_t *p = &status->protocol;
+    const ws2812b_tween_stats_t *t = &status->tween;
+    const ws2812b_current_stats_t *c = &status->current;
+
+    *out++ = status->version;
+    *out++ = status->clock_path;
+    out = put_le16(out, status->timer_period);
+    out = put_le32(out, status->uptime_ms);
+    out = put_le16(out, status->output_scale);
+
+    out = put_le32(out, p->packets);
+    out = put_le32(out, p->frames);
+    out = put_le32(out, p->commands);
+    out = put_le32(out, p->crc_errors);
+    out = put_le32(out, p->length_errors);
+    out = put_le32(out, p->decode_errors);
+    out = put_le32(out, p->dropped_bytes);
+    out = put_le32(out, p->uart_errors);
+
+    out = put_le32(out, t->frames);
+    out = put_le32(out, t->overflows);
+    out = put_le32(out, t->underruns);
+    out = put_le32(out, t->resyncs);
+    out = put_le16(out, t->interval_ms);
+    out = put_le16(out, t->jitter_ms);
+    out = put_le16(out, t->latency_ms);
+    out = put_le16(out, t->latency_avg_ms);
+    out = put_le16(out, t->latency_max_ms);
+
+    out = put_le16(out, c->current_ma);
+    out = put_le16(out, c->peak_ma);
+    out = put_le16(out, c->limit_ma);
+    out = put_le16(out, c->scale);
+    out = put_le32(out, c->limited_frames);
+    put_le32(out, c->attacks);
+}
+
+/**
+ * @brief Deserialize a PACKET_STATUS payload.
+ * @return false if the length or version does not match.
+ */
+bool WS2812B_Protocol_UnpackStatus(const uint8_t *in, uint16_t len, ws2812b_status_t *status)
+{
+    ws2812b_protocol_stats_t *p = &status->protocol;
+    ws2812b_tween_stats_t *t = &status->tween;
+    ws2812b_current_stats_t *c = &status->current;
+
+    if (len != WS2812B_STATUS_SIZE || in[0] != WS2812B_STATUS_VERSION) return false;
+
+    status->version = *in++;
+    status->clock_path = *in++;
+    status->timer_period = get_le16(&in);
+    status->uptime_ms = get_le32(&in);
+    status->output_scale = get_le16(&in);
+
+    p->packets = get_le32(&in);
+    p->frames = get_le32(&in);
+    p->commands = get_le32(&in);
+    p->crc_errors = get_le32(&in);
+    p->length_errors = get_le32(&in);
+    p->decode_errors = get_le32(&in);
+    p->dropped_bytes = get_le32(&in);
+    p->uart_errors = get_le32(&in);
+
+    t->frames = get_le32(&in);
+    t->overflows = get_le32(&in);
+    t->underruns = get_le32(&in);
+    t->resyncs = get_le32(&in);
+    t->interval_ms = get_le16(&in);
+    t->jitter_ms = get_le16(&in);
+    t->latency_ms = get_le16(&in);
+    t->latency_avg_ms = get_le16(&in);
+    t->latency_max_ms = get_le16(&in);
+
+    c->current_ma = get_le16(&in);
+    c->peak_ma = get_le16(&in);
+    c->limit_ma = get_le16(&in);
+    c->scale = get_le16(&in);
+    c->limited_frames = get_le32(&in);
+    c->attacks = get_le32(&in);
+    return true;
+}
+
+// ===================================================================
+// ============================ UART GLUE ============================
+// ===================================================================
+
+static UART_HandleTypeDef *protocol_uart = NULL;
+static uint8_t rx_ring[WS2812B_PROTOCOL_RX_SIZE];
+static uint16_t rx_tail = 0;
+static uint32_t last_frame_tick = 0;
+static bool stream_seen = false;
+static volatile bool rx_restarted = false;  ///< Set by the error callback, cleared by Poll
+
+/**
+ * @brief (Re)start circular reception from the start of the ring.
+ */
+static bool protocol_receive(void)
+{
+    return HAL_UART_Receive_DMA(protocol_uart, rx_ring, WS2812B_PROTOCOL_RX_SIZE) == HAL_OK;
+}
+
+/**
+ * @brief Start circular DMA reception and register the command queue.
+ * @param huart UART handle (its RX DMA channel is switched to circular mode)
+ * @return true on success; false if no RX DMA channel is linked to @p huart.
+ */
+bool WS2812B_Protocol_Start(UART_HandleTypeDef *huart)
+{
+    if (huart->hdmarx == NULL) return false;   // HAL_UART_MspInit() did not link one
+
+    protocol_uart = huart;
+    WS2812B_Protocol_Reset();
+    WS2812B_Control_AddQueue(&protocol_queue);
+
+    huart->hdmarx->Init.Mode = DMA_CIRCULAR;
+    HAL_DMA_Init(huart->hdmarx);
+    rx_tail = 0;
+    return protocol_receive();
+}
+
+/**
+ * @brief Send a packet to the host: header, payload and CRC as three blocking transmits.
+ * @return false if the protocol is not started or a transmit failed.
+ */
+bool WS2812B_Protocol_Send(uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    if (protocol_uart == NULL) return false;
+
+    uint8_t header[4] = { WS2812B_PROTOCOL_SYNC, type, (uint8_t)len, (uint8_t)(len >> 8) };
+    uint8_t crc = crc8_update(crc8_update(0, &header[1], 3), payload, len);
+
+    return HAL_UART_Transmit(protocol_uart, header, sizeof(header), WS2812B_PROTOCOL_TX_TIMEOUT_MS) == HAL_OK &&
+           HAL_UART_Transmit(protocol_uart, (uint8_t *)payload, len, WS2812B_PROTOCOL_TX_TIMEOUT_MS) == HAL_OK &&
+           HAL_UART_Transmit(protocol_uart, &crc, 1, WS2812B_PROTOCOL_TX_TIMEOUT_MS) == HAL_OK;
+}
+
+/**
+ * @brief Send the device status as a PACKET_STATUS packet.
+ * @return false if the protocol is not started or the transmit failed.
+ */
+bool WS2812B_Protocol_SendStatus(void)
+{
+    ws2812b_status_t status;
+    uint8_t payload[WS2812B_STATUS_SIZE];
+
+    WS2812B_Protocol_GetStatus(&status);
+    WS2812B_Protocol_PackStatus(&status, payload);
+    return WS2812B_Protocol_Send(PACKET_STATUS, payload, sizeof(payload));
+}
+
+/**
+ * @brief Feed everything the DMA received since the last call to the parser.
+ * @note Call once per frame from the render loop. Bytes are lost if more than
+ *       WS2812B_PROTOCOL_RX_SIZE arrive between two calls.
+ */
+void WS2812B_Protocol_Poll(void)
+{
+    if (protocol_uart == NULL) return;
+
+    if (rx_restarted)
+    {
+        // Reception restarted at the ring start; drop the partial packet
+        rx_restarted = false;
+        rx_tail = 0;
+        parse_state = PARSE_SYNC;
+    }
+
+    const uint32_t now = HAL_GetTick();
+    uint16_t head = (uint16_t)((WS2812B_PROTOCOL_RX_SIZE - __HAL_DMA_GET_COUNTER(protocol_uart->hdmarx))
+                               & (WS2812B_PROTOCOL_RX_SIZE - 1));
+
+    if (head < rx_tail)
+    {
+        WS2812B_Protocol_FeedAt(&rx_ring[rx_tail], WS2812B_PROTOCOL_RX_SIZE - rx_tail, now);
+        rx_tail = 0;
+    }
+    if (head > rx_tail)
+    {
+        WS2812B_Protocol_FeedAt(&rx_ring[rx_tail], head - rx_tail, now);
+        rx_tail = head;
+    }
+
+    if (frame_received)
+    {
+        last_frame_tick = now;
+        stream_seen = true;
+    }
+}
+
+/**
+ * @brief Check whether streamed frames currently own the strip.
+ * @return true if a frame arrived within WS2812B_PROTOCOL_HOLD_MS.
+ */
+bool WS2812B_Protocol_StreamActive(void)
+{
+    return stream_seen && (HAL_GetTick() - last_frame_tick) < WS2812B_PROTOCOL_HOLD_MS;
+}
+
+/**
+ * @brief UART error callback: count the error and restart reception.
+ * @param huart UART handle
+ * @note The HAL aborts DMA reception on overrun/framing errors. Reception
+ *       restarts at once; the next WS2812B_Protocol_Poll() drops the partial
+ *       packet and the parser resynchronizes on the next sync byte.
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != protocol_uart) return;
+
+    stats.uart_errors++;
+    rx_restarted = true;
+    protocol_receive();
+}
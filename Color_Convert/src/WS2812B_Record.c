@@ -0,0 +1,311 @@
+/**
+ * @file WS2812B_Record.c
+ * @brief Input/frame log in RAM, its wire format and the UART dump.
+ *
+ * Entries store the time since the previous entry, so a frame without input
+ * costs one 8-byte entry. All entries of a frame carry the tick taken by
+ * WS2812B_Record_BeginFrame(): the replay sets its clock to that tick once
+ * per frame, before applying the frame's inputs and rendering it.
+ *
+ * The ring holds entries record_head .. record_head + record_count - 1
+ * (modulo WS2812B_RECORD_SIZE), and record_head is always the marker of a
+ * keyframe. Keyframes are written between frames, every
+ * RECORD_KEYFRAME_SPACING entries, so when the ring is full and the oldest
+ * keyframe's stretch is dropped, at least the newest keyframe is left.
+ */
+
+#include "WS2812B_Record.h"
+#include "WS2812B_Protocol.h"
+
+#define RECORD_KEYFRAME_ENTRIES (FIELD_COUNT + 1U)          ///< Marker + snapshot
+#define RECORD_KEYFRAME_SPACING (WS2812B_RECORD_SIZE / 2U)  ///< Entries from one keyframe to the next
+
+_Static_assert(WS2812B_RECORD_SIZE >= 3U * RECORD_KEYFRAME_ENTRIES && WS2812B_RECORD_SIZE <= 0xFFFF,
+               "WS2812B_RECORD_SIZE must hold keyframes half a ring apart and fit a uint16_t count");
+
+#define FNV_OFFSET  2166136261U
+#define FNV_PRIME   16777619U
+
+static ws2812b_record_entry_t record_buf[WS2812B_RECORD_SIZE];
+static uint16_t record_head = 0;        ///< Oldest entry, a keyframe marker
+static uint16_t record_count = 0;
+static uint16_t record_since_key = 0;   ///< Entries since the newest keyframe marker
+static bool record_active = false;
+static const ws2812b_effects_t *record_effects; ///< Effect state snapshotted by keyframes
+static uint32_t record_last_tick = 0;   ///< Tick of the previous entry
+static uint32_t record_frame_tick = 0;  ///< Tick of the frame being recorded
+static uint16_t record_scale = 256;     ///< Output scale as of the last RECORD_SCALE
+
+static inline bool record_is_keyframe(const ws2812b_record_entry_t *entry)
+{
+    return entry->kind == RECORD_START_MARK || entry->kind == RECORD_KEYFRAME;
+}
+
+/**
+ * @brief Drop the oldest keyframe and the entries up to the next one.
+ * @return false if there is no later keyframe (one frame logged more than
+ *         half the ring); the log is kept as it is and recording stops.
+ */
+static bool record_drop_oldest(void)
+{
+    uint16_t n = 1;
+
+    while (n < record_count && !record_is_keyframe(&record_buf[(record_head + n) % WS2812B_RECORD_SIZE])) n++;
+    if (n == record_count)
+    {
+        record_active = false;
+        return false;
+    }
+    record_head = (uint16_t)((record_head + n) % WS2812B_RECORD_SIZE);
+    record_count -= n;
+    return true;
+}
+
+/**
+ * @brief Append an entry, making room by dropping the oldest keyframe's stretch.
+ */
+static void record_push(ws2812b_record_entry_t entry)
+{
+    if (record_count == WS2812B_RECORD_SIZE && !record_drop_oldest()) return;
+
+    record_buf[(record_head + record_count) % WS2812B_RECORD_SIZE] = entry;
+    record_count++;
+    record_since_key++;
+}
+
+/**
+ * @brief Append an entry at the current frame tick.
+ */
+static void record_put(uint8_t kind, uint8_t type, int32_t value)
+{
+    if (!record_active) return;
+
+    uint32_t dt = record_frame_tick - record_last_tick;
+    record_last_tick = record_frame_tick;
+
+    if (dt > 0xFFFFU)
+    {
+        record_push((ws2812b_record_entry_t){ 0, RECORD_TIME, 0, (int32_t)dt });
+        dt = 0;
+    }
+    record_push((ws2812b_record_entry_t){ (uint16_t)dt, kind, type, value });
+}
+
+/**
+ * @brief Write a keyframe: the marker, then the effect state at the end of the current frame.
+ * @param kind RECORD_START_MARK or RECORD_KEYFRAME
+ * @param output_enabled Current CMD_POWER state
+ */
+static void record_keyframe(uint8_t kind, bool output_enabled)
+{
+    const ws2812b_effects_t *effects = record_effects;
+    ws2812b_effects_phase_t phase;
+
+    WS2812B_Effects_GetPhase(&phase);
+    phase.cycle_elapsed -= HAL_GetTick() - record_frame_tick;  // Replay restores at the frame tick
+    const int32_t state[FIELD_COUNT] = {
+        [FIELD_LED_NUM] = LED_NUM,
+        [FIELD_TIMER_PERIOD] = (int32_t)htim3.Init.Period,
+        [FIELD_OUTPUT] = output_enabled,
+        [FIELD_EFFECT] = effects->current_effect,
+        [FIELD_HUE] = effects->hue,
+        [FIELD_HUE16] = effects->hue16,
+        [FIELD_HUE_STEP] = effects->hue_step,
+        [FIELD_BRIGHTNESS] = effects->brightness,
+        [FIELD_BREATHE_DIRECTION] = effects->breathe_direction,
+        [FIELD_THEATER_FRAME] = effects->theater_frame,
+        [FIELD_EFFECT_SPEED] = (int32_t)effects->effect_speed,
+        [FIELD_AUTO_CYCLE] = effects->auto_cycle,
+        [FIELD_CYCLE_DURATION] = (int32_t)effects->cycle_duration,
+        [FIELD_GLOBAL_BRIGHTNESS] = WS2812B_GetBrightness(),
+        [FIELD_GLOBAL_SPEED] = WS2812B_GetSpeed(),
+        [FIELD_MIRROR] = WS2812B_GetMirror(),
+        [FIELD_RAINBOW_HUE] = phase.rainbow_hue,
+        [FIELD_CHASE_OFFSET] = phase.chase_offset,
+        [FIELD_BREATHE_LEVEL] = phase.breathe_val,
+        [FIELD_BREATHE_STEP] = phase.breathe_dir,
+        [FIELD_CYCLE_ELAPSED] = (int32_t)phase.cycle_elapsed,
+        [FIELD_FIRE_SEED] = (int32_t)phase.fire_seed,
+    };
+
+    record_put(kind, WS2812B_RECORD_VERSION, (int32_t)record_frame_tick);
+    record_since_key = 1;
+    for (uint8_t field = 0; field < FIELD_COUNT; field++)
+    {
+        record_put(RECORD_STATE, field, state[field]);
+    }
+    record_scale = 256;     // Replay starts unscaled; the next frame logs any other scale
+}
+
+/**
+ * @brief Clear the log, write the first keyframe and start recording.
+ * @param effects Effect state owned by the render loop
+ * @param output_enabled Current CMD_POWER state
+ */
+void WS2812B_Record_Start(const ws2812b_effects_t *effects, bool output_enabled)
+{
+    record_head = 0;
+    record_count = 0;
+    record_effects = effects;
+    record_frame_tick = HAL_GetTick();
+    record_last_tick = record_frame_tick;
+    record_active = true;
+
+    record_keyframe(RECORD_START_MARK, output_enabled);
+}
+
+/**
+ * @brief Stop recording (the log is kept).
+ */
+void WS2812B_Record_Stop(void)
+{
+    record_active = false;
+}
+
+/**
+ * @brief Check whether recording is on.
+ */
+bool WS2812B_Record_Active(void)
+{
+    return record_active;
+}
+
+/**
+ * @brief Take the tick for the entries of this frame.
+ */
+void WS2812B_Record_BeginFrame(void)
+{
+    if (record_active) record_frame_tick = HAL_GetTick();
+}
+
+/**
+ * @brief Log a parameter block (two entries).
+ */
+void WS2812B_Record_Params(const ws2812b_params_t *params)
+{
+    record_put(RECORD_PARAMS, (uint8_t)params->effect,
+               (int32_t)((uint32_t)params->hue | ((uint32_t)params->brightness << 16) | ((uint32_t)params->speed << 24)));
+    record_put(RECORD_PARAMS_CYCLE, params->auto_cycle, (int32_t)params->cycle_duration);
+}
+
+/**
+ * @brief Log a command (CMD_RECORD and CMD_STATUS change no state and are not logged).
+ */
+void WS2812B_Record_Command(uint8_t type, int32_t value)
+{
+    if (type != CMD_RECORD && type != CMD_STATUS) record_put(RECORD_COMMAND, type, value);
+}
+
+/**
+ * @brief Log the end of a frame with the checksum of what was sent, then a
+ *        keyframe if half a ring has been written since the last one.
+ * @param source @ref ws2812b_record_source_t; FRAME_OFF means the output is disabled
+ */
+void WS2812B_Record_EndFrame(uint8_t source)
+{
+    if (!record_active) return;
+
+    uint16_t scale = WS2812B_GetOutputScale();
+    if (scale != record_scale)
+    {
+        record_scale = scale;
+        record_put(RECORD_SCALE, 0, scale);
+    }
+    record_put(RECORD_FRAME, source, (int32_t)WS2812B_Record_FrameHash());
+
+    if (record_since_key >= RECORD_KEYFRAME_SPACING) record_keyframe(RECORD_KEYFRAME, source != FRAME_OFF);
+}
+
+/**
+ * @brief FNV-1a over the encoded frame, one byte per PWM value.
+ */
+WS2812B_RAMFUNC uint32_t WS2812B_Record_FrameHash(void)
+{
+    uint32_t hash = FNV_OFFSET;
+
+    for (uint32_t i = 0; i < WS2812B_DATA_SIZE; i++)
+    {
+        hash = (hash ^ pwmData[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Number of entries in the log.
+ */
+uint16_t WS2812B_Record_Count(void)
+{
+    return record_count;
+}
+
+/**
+ * @brief Copy one entry out of the log, oldest first.
+ */
+bool WS2812B_Record_Get(uint16_t index, ws2812b_record_entry_t *entry)
+{
+    if (index >= record_count) return false;
+    *entry = record_buf[(record_head + index) % WS2812B_RECORD_SIZE];
+    return true;
+}
+
+/**
+ * @brief Serialize an entry, little-endian.
+ */
+void WS2812B_Record_Pack(const ws2812b_record_entry_t *entry, uint8_t *out)
+{
+    uint32_t value = (uint32_t)entry->value;
+
+    out[0] = (uint8_t)entry->dt_ms;
+    out[1] = (uint8_t)(entry->dt_ms >> 8);
+    out[2] = entry->kind;
+    out[3] = entry->type;
+    out[4] = (uint8_t)value;
+    out[5] = (uint8_t)(value >> 8);
+    out[6] = (uint8_t)(value >> 16);
+    out[7] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief Deserialize an entry.
+ */
+void WS2812B_Record_Unpack(const uint8_t *in, ws2812b_record_entry_t *entry)
+{
+    entry->dt_ms = (uint16_t)(in[0] | (in[1] << 8));
+    entry->kind = in[2];
+    entry->type = in[3];
+    entry->value = (int32_t)((uint32_t)in[4] | ((uint32_t)in[5] << 8) | ((uint32_t)in[6] << 16) | ((uint32_t)in[7] << 24));
+}
+
+/**
+ * @brief Send the log as PACKET_RECORD packets.
+ * @return false if a transmit failed.
+ */
+bool WS2812B_Record_Dump(void)
+{
+    uint8_t payload[4 + WS2812B_RECORD_DUMP_ENTRIES * WS2812B_RECORD_ENTRY_SIZE];
+    uint16_t first = 0;
+
+    do
+    {
+        uint16_t n = record_count - first;
+        if (n > WS2812B_RECORD_DUMP_ENTRIES) n = WS2812B_RECORD_DUMP_ENTRIES;
+
+        payload[0] = (uint8_t)first;
+        payload[1] = (uint8_t)(first >> 8);
+        payload[2] = (uint8_t)record_count;
+        payload[3] = (uint8_t)(record_count >> 8);
+        for (uint16_t i = 0; i < n; i++)
+        {
+            WS2812B_Record_Pack(&record_buf[(record_head + first + i) % WS2812B_RECORD_SIZE],
+                                &payload[4 + i * WS2812B_RECORD_ENTRY_SIZE]);
+        }
+
+        if (!WS2812B_Protocol_Send(PACKET_RECORD, payload, (uint16_t)(4U + n * WS2812B_RECORD_ENTRY_SIZE)))
+        {
+            return false;
+        }
+        first += n;
+    } while (first < record_count);
+
+    return true;
+}
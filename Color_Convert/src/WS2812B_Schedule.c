@@ -0,0 +1,192 @@
+/**
+ * @file WS2812B_Schedule.c
+ * @brief Time-of-day schedule evaluated from the RTC second interrupt.
+ *
+ * The RTC counter runs from the 32.768 kHz LSE with a 1 s prescaler and is
+ * read raw (modulo one day); HAL_RTC_GetTime() is not used because the F1
+ * HAL rewrites the counter on day rollover. The evaluation state is written
+ * by the RTC interrupt only, and the table is installed before it is enabled.
+ */
+
+#include "WS2812B_Schedule.h"
+
+extern RTC_HandleTypeDef hrtc;
+
+static ws2812b_cmd_queue_t schedule_queue;
+
+static const ws2812b_schedule_entry_t *schedule_table = NULL;
+static uint8_t schedule_count = 0;
+
+// Written by the RTC interrupt
+static int last_entry = -1;
+static int last_brightness = -1;
+
+/**
+ * @brief Install a schedule without touching the RTC.
+ * @param table Entries sorted by time
+ * @param count Number of entries
+ */
+void WS2812B_Schedule_SetTable(const ws2812b_schedule_entry_t* table, uint8_t count)
+{
+    schedule_table = table;
+    schedule_count = (table != NULL) ? count : 0;
+    last_entry = -1;
+    last_brightness = -1;
+    WS2812B_CmdQueue_Init(&schedule_queue);
+}
+
+/**
+ * @brief Index of the active entry.
+ * @param now Seconds since midnight
+ * @return Entry index, or -1 if the table is empty.
+ */
+int WS2812B_Schedule_ActiveEntry(uint32_t now)
+{
+    if (schedule_count == 0) return -1;
+
+    now %= WS2812B_SCHEDULE_DAY;
+    for (int i = schedule_count - 1; i >= 0; i--)
+    {
+        if (schedule_table[i].time <= now) return i;
+    }
+    return schedule_count - 1;  // Before the first entry: still yesterday's last one
+}
+
+/**
+ * @brief Previous entry (cyclic) that sets a brightness, starting before @p from.
+ * @return Entry index, or -1 if none.
+ */
+static int brightness_entry_before(int from)
+{
+    for (int n = 0; n < schedule_count; n++)
+    {
+        from = (from == 0) ? schedule_count - 1 : from - 1;
+        if (schedule_table[from].brightness != WS2812B_SCHEDULE_KEEP) return from;
+    }
+    return -1;
+}
+
+/**
+ * @brief Scheduled brightness.
+ * @param now Seconds since midnight
+ * @return Brightness (0–100%), or -1 if no entry sets a brightness.
+ */
+int WS2812B_Schedule_BrightnessAt(uint32_t now)
+{
+    int active = WS2812B_Schedule_ActiveEntry(now);
+    if (active < 0) return -1;
+
+    now %= WS2812B_SCHEDULE_DAY;
+    int cur = (schedule_table[active].brightness != WS2812B_SCHEDULE_KEEP) ? active : brightness_entry_before(active);
+    if (cur < 0) return -1;
+
+    const ws2812b_schedule_entry_t *entry = &schedule_table[cur];
+    uint32_t elapsed = (now + WS2812B_SCHEDULE_DAY - entry->time) % WS2812B_SCHEDULE_DAY;
+    int prev = brightness_entry_before(cur);
+
+    if (entry->ramp_s == 0 || elapsed >= entry->ramp_s || prev == cur)
+    {
+        return entry->brightness;
+    }
+
+    int from = schedule_table[prev].brightness;
+    return from + (entry->brightness - from) * (int32_t)elapsed / (int32_t)entry->ramp_s;
+}
+
+/**
+ * @brief Evaluate the schedule and post commands for any change.
+ * @param now Seconds since midnight (values >= one day wrap)
+ * @note A command that does not fit in the queue is retried next second.
+ */
+void WS2812B_Schedule_Evaluate(uint32_t now)
+{
+    int entry = WS2812B_Schedule_ActiveEntry(now);
+    if (entry < 0) return;
+
+    if (entry != last_entry)
+    {
+        uint8_t preset = schedule_table[entry].preset;
+        if (preset != WS2812B_SCHEDULE_KEEP)
+        {
+            if (!WS2812B_CmdQueue_Push(&schedule_queue, CMD_RECALL_PRESET, preset)) return;
+            last_brightness = -1;   // The preset brought its own brightness
+        }
+        last_entry = entry;
+    }
+
+    int brightness = WS2812B_Schedule_BrightnessAt(now);
+    if (brightness >= 0 && brightness != last_brightness)
+    {
+        if (WS2812B_CmdQueue_Push(&schedule_queue, CMD_SET_BRIGHTNESS, brightness))
+        {
+            last_brightness = brightness;
+        }
+    }
+}
+
+/**
+ * @brief Command queue fed by the schedule.
+ */
+ws2812b_cmd_queue_t* WS2812B_Schedule_Queue(void)
+{
+    return &schedule_queue;
+}
+
+// ===================================================================
+// ============================ HAL GLUE =============================
+// ===================================================================
+
+/**
+ * @brief Install a schedule and start the RTC second interrupt.
+ * @param table Entries sorted by time (must stay valid, typically const)
+ * @param count Number of entries (0 disables the schedule)
+ */
+void WS2812B_Schedule_Init(const ws2812b_schedule_entry_t* table, uint8_t count)
+{
+    WS2812B_Schedule_SetTable(table, count);
+    WS2812B_Control_AddQueue(&schedule_queue);
+    if (hrtc.Instance != NULL)  // NULL if the LSE did not start
+    {
+        HAL_RTCEx_SetSecond_IT(&hrtc);
+    }
+}
+
+/**
+ * @brief Set the RTC time of day.
+ * @return false if the RTC rejected the time.
+ */
+bool WS2812B_Schedule_SetClock(uint8_t hours, uint8_t minutes, uint8_t seconds)
+{
+    RTC_TimeTypeDef time = { .Hours = hours, .Minutes = minutes, .Seconds = seconds };
+    if (hrtc.Instance == NULL) return false;
+    return HAL_RTC_SetTime(&hrtc, &time, RTC_FORMAT_BIN) == HAL_OK;
+}
+
+/**
+ * @brief Current RTC time of day.
+ * @return Seconds since midnight.
+ */
+uint32_t WS2812B_Schedule_Now(void)
+{
+    if (hrtc.Instance == NULL) return 0;
+
+    // The two halves are not latched together: re-read if the high half moved
+    uint16_t high = (uint16_t)hrtc.Instance->CNTH;
+    uint16_t low = (uint16_t)hrtc.Instance->CNTL;
+    if ((uint16_t)hrtc.Instance->CNTH != high)
+    {
+        high = (uint16_t)hrtc.Instance->CNTH;
+        low = (uint16_t)hrtc.Instance->CNTL;
+    }
+    return (((uint32_t)high << 16) | low) % WS2812B_SCHEDULE_DAY;
+}
+
+/**
+ * @brief RTC second interrupt callback.
+ * @param rtc RTC handle
+ */
+void HAL_RTCEx_RTCEventCallback(RTC_HandleTypeDef *rtc)
+{
+    (void)rtc;
+    WS2812B_Schedule_Evaluate(WS2812B_Schedule_Now());
+}
@@ -0,0 +1,160 @@
+/**
+ * @file WS2812B_Script.c
+ * @brief Fixed-pool scheduler for sequential WS2812B animation scripts.
+ *
+ * Scripts are stackless coroutines: each suspension stores the source line in
+ * `resume` and returns; the next WS2812B_Script_Tick() jumps back there through
+ * the switch opened by WS2812B_SCRIPT_BEGIN. Resuming a script costs one
+ * indirect call plus one switch dispatch, independent of the script length.
+ */
+
+#include "WS2812B_Script.h"
+#include <string.h>
+
+/** @brief Script state pool (replaces heap allocation of coroutine frames). */
+static ws2812b_script_t script_pool[WS2812B_SCRIPT_POOL_SIZE];
+
+/**
+ * @brief Start a script in a free pool slot.
+ * @param fn Script body.
+ * @param user User context stored in `script->user`.
+ * @return The script's state block, or NULL if the pool is full.
+ */
+ws2812b_script_t* WS2812B_Script_Start(ws2812b_script_fn_t fn, void *user)
+{
+    if (fn == NULL) return NULL;
+
+    for (int i = 0; i < WS2812B_SCRIPT_POOL_SIZE; i++)
+    {
+        ws2812b_script_t *script = &script_pool[i];
+        if (script->fn == NULL)
+        {
+            memset(script, 0, sizeof(*script));
+            script->fn = fn;
+            script->user = user;
+            return script;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Stop a running script and release its pool slot.
+ * @param script Script returned by WS2812B_Script_Start().
+ */
+void WS2812B_Script_Stop(ws2812b_script_t *script)
+{
+    if (script != NULL)
+    {
+        script->fn = NULL;
+    }
+}
+
+/**
+ * @brief Stop all running scripts.
+ */
+void WS2812B_Script_StopAll(void)
+{
+    for (int i = 0; i < WS2812B_SCRIPT_POOL_SIZE; i++)
+    {
+        script_pool[i].fn = NULL;
+    }
+}
+
+/**
+ * @brief Resume every running script once.
+ * @return Number of scripts still running.
+ * @note Call once per frame, before WS2812B_Send().
+ */
+uint8_t WS2812B_Script_Tick(void)
+{
+    uint8_t running = 0;
+
+    for (int i = 0; i < WS2812B_SCRIPT_POOL_SIZE; i++)
+    {
+        ws2812b_script_t *script = &script_pool[i];
+        if (script->fn == NULL) continue;
+
+        if (script->fn(script))
+        {
+            running++;
+        }
+        else
+        {
+            script->fn = NULL;
+        }
+    }
+    return running;
+}
+
+/**
+ * @brief Prepare a fade from the script's current color.
+ * @param script Script state.
+ * @param red Target red (0–255)
+ * @param green Target green (0–255)
+ * @param blue Target blue (0–255)
+ * @param frames Fade length in frames (0 = jump immediately).
+ */
+void WS2812B_Script_FadeBegin(ws2812b_script_t *script, uint8_t red, uint8_t green, uint8_t blue, uint16_t frames)
+{
+    memcpy(script->from, script->rgb, 3);
+    script->to[0] = red;
+    script->to[1] = green;
+    script->to[2] = blue;
+    script->fade_len = frames;
+    script->wait = frames;
+
+    if (frames == 0)
+    {
+        memcpy(script->rgb, script->to, 3);
+        WS2812B_SetColorRGB(red, green, blue);
+    }
+}
+
+/**
+ * @brief Render the next fade frame.
+ * @param script Script state.
+ * @return true if a frame was rendered, false when the fade is complete.
+ * @note The last rendered frame is exactly the target color.
+ */
+bool WS2812B_Script_FadeStep(ws2812b_script_t *script)
+{
+    if (script->wait == 0) return false;
+
+    script->wait--;
+    int32_t done = script->fade_len - script->wait;
+
+    for (int c = 0; c < 3; c++)
+    {
+        int32_t delta = (int32_t)script->to[c] - script->from[c];
+        script->rgb[c] = (uint8_t)(script->from[c] + (delta * done) / script->fade_len);
+    }
+
+    WS2812B_SetColorRGB(script->rgb[0], script->rgb[1], script->rgb[2]);
+    return true;
+}
+
+// ===================================================================
+// ========================= BUILT-IN SCRIPTS ========================
+// ===================================================================
+
+/**
+ * @brief Breathing effect written as a script.
+ * @param script Script state: `local[0..2]` = RGB color, `local[3]` = frames per half period.
+ * @return Always true (runs until stopped).
+ * @note Equivalent to WS2812B_Breathe() in RGB mode (10–100% brightness) without module statics.
+ */
+bool WS2812B_Script_Breathe(ws2812b_script_t *script)
+{
+    WS2812B_SCRIPT_BEGIN(script);
+
+    if (script->local[3] == 0) script->local[3] = WS2812B_SCRIPT_MS(2000);
+
+    for (;;)
+    {
+        WS2812B_SCRIPT_FADE_TO(script, script->local[0], script->local[1], script->local[2], script->local[3]);
+        WS2812B_SCRIPT_FADE_TO(script, script->local[0] / 10, script->local[1] / 10, script->local[2] / 10, script->local[3]);
+    }
+
+    WS2812B_SCRIPT_END(script);
+}
@@ -0,0 +1,221 @@
+/**
+ * @file WS2812B_Stream.c
+ * @brief Framebuffer-less shader streaming for WS2812B using circular TIM3 DMA.
+ *
+ * The PWM buffer holds two chunks of WS2812B_STREAM_CHUNK LEDs. While DMA
+ * transmits one half, the half/complete interrupt renders and encodes the next
+ * chunk into the other half. After the last LED, WS2812B_STREAM_RESET_SLOTS
+ * all-zero LED slots produce the latch gap and the next frame starts with a
+ * fresh timestamp.
+ *
+ * @note Budget assumes TIM3 runs from the 72 MHz core clock (prescaler 0),
+ *       so one timer tick equals one CPU cycle.
+ */
+
+#include "WS2812B_Stream.h"
+#include "WS2812B_Profile.h"
+#include <string.h>
+
+extern TIM_HandleTypeDef htim3;
+extern DMA_HandleTypeDef hdma_tim3_ch1_trig;
+
+#define STREAM_HALF_SIZE   (WS2812B_STREAM_CHUNK * 24)
+
+/** @brief Circular PWM buffer: two halves of one chunk each. */
+static ws2812b_pwm_t stream_buf[2 * STREAM_HALF_SIZE];
+
+static volatile bool stream_active = false;
+static ws2812b_shader_t stream_shader;
+static const void *stream_ctx;
+static uint16_t stream_led_count;
+static uint32_t stream_slot;        ///< Next LED slot of the frame (reset slots included)
+static uint32_t stream_time;        ///< Timestamp of the frame being rendered
+static ws2812b_stream_stats_t stream_stats;
+
+/**
+ * @brief Render and encode the next chunk into one buffer half.
+ * @param dst Buffer half to fill.
+ */
+WS2812B_RAMFUNC static void stream_fill(ws2812b_pwm_t *dst)
+{
+    uint32_t start = WS2812B_Profile_Cycles();
+
+    for (int k = 0; k < WS2812B_STREAM_CHUNK; k++, dst += 24)
+    {
+        if (stream_slot < stream_led_count)
+        {
+            uint8_t r, g, b;
+            stream_shader((uint16_t)stream_slot, stream_time, stream_ctx, &r, &g, &b);
+            WS2812B_EncodeRGB(dst, r, g, b);
+        }
+        else
+        {
+            memset(dst, 0, 24 * sizeof(ws2812b_pwm_t));  // Latch gap
+        }
+
+        if (++stream_slot >= (uint32_t)stream_led_count + WS2812B_STREAM_RESET_SLOTS)
+        {
+            stream_slot = 0;
+            stream_time = HAL_GetTick();
+            stream_stats.frames++;
+        }
+    }
+
+    uint32_t cycles = WS2812B_Profile_Cycles() - start;
+    if (cycles > stream_stats.max_chunk_cycles) stream_stats.max_chunk_cycles = cycles;
+    if (cycles > stream_stats.budget_cycles) stream_stats.over_budget++;
+}
+
+/**
+ * @brief DMA half-transfer callback: first half was sent, refill it.
+ * @param htim Timer handle that triggered the callback.
+ */
+WS2812B_RAMFUNC void HAL_TIM_PWM_PulseFinishedHalfCpltCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim == &htim3 && stream_active)
+    {
+        stream_fill(&stream_buf[0]);
+    }
+}
+
+/**
+ * @brief Refill the second buffer half (called from the PWM-finished callback).
+ */
+WS2812B_RAMFUNC void WS2812B_Stream_TransferComplete(void)
+{
+    stream_fill(&stream_buf[STREAM_HALF_SIZE]);
+}
+
+/**
+ * @brief Start continuous streaming of a shader.
+ * @param led_count Number of LEDs on the strip (may exceed LED_NUM).
+ * @param shader Pixel shader.
+ * @param ctx Context passed to the shader (may be NULL).
+ * @return HAL status of the DMA start.
+ * @note Aborts a single-shot transfer still in progress.
+ */
+HAL_StatusTypeDef WS2812B_Stream_Start(uint16_t led_count, ws2812b_shader_t shader, const void *ctx)
+{
+    if (led_count == 0 || shader == NULL) return HAL_ERROR;
+
+    WS2812B_Stream_Stop();
+
+    stream_shader = shader;
+    stream_ctx = ctx;
+    stream_led_count = led_count;
+    stream_slot = 0;
+    stream_time = HAL_GetTick();
+
+    memset(&stream_stats, 0, sizeof(stream_stats));
+    stream_stats.budget_cycles = WS2812B_STREAM_CHUNK * 24U * (htim3.Instance->ARR + 1U);
+    WS2812B_Profile_Init();
+
+    stream_fill(&stream_buf[0]);
+    stream_fill(&stream_buf[STREAM_HALF_SIZE]);
+
+    hdma_tim3_ch1_trig.Init.Mode = DMA_CIRCULAR;
+    HAL_DMA_Init(&hdma_tim3_ch1_trig);
+
+    stream_active = true;
+    HAL_StatusTypeDef status = HAL_TIM_PWM_Start_DMA(&htim3, TIM_CHANNEL_1, (uint32_t*)stream_buf, 2 * STREAM_HALF_SIZE);
+    if (status != HAL_OK)
+    {
+        WS2812B_Stream_Stop();
+    }
+    return status;
+}
+
+/**
+ * @brief Stop streaming and return TIM3/DMA to single-shot mode.
+ * @note The line goes low immediately, so a partially sent frame is latched.
+ */
+void WS2812B_Stream_Stop(void)
+{
+    stream_active = false;
+    HAL_TIM_PWM_Stop_DMA(&htim3, TIM_CHANNEL_1);
+
+    if (hdma_tim3_ch1_trig.Init.Mode != DMA_NORMAL)
+    {
+        hdma_tim3_ch1_trig.Init.Mode = DMA_NORMAL;
+        HAL_DMA_Init(&hdma_tim3_ch1_trig);
+    }
+}
+
+/**
+ * @brief Check whether a stream currently owns the DMA channel.
+ */
+bool WS2812B_Stream_IsActive(void)
+{
+    return stream_active;
+}
+
+/**
+ * @brief Get timing statistics of the running stream.
+ * @param[out] stats Copy of the current statistics.
+ */
+void WS2812B_Stream_GetStats(ws2812b_stream_stats_t *stats)
+{
+    *stats = stream_stats;
+}
+
+// ===================================================================
+// ========================= BUILT-IN SHADERS ========================
+// ===================================================================
+
+/**
+ * @brief Moving rainbow shader.
+ * @note ctx is a @ref ws2812b_shader_params_t.
+ */
+WS2812B_RAMFUNC void WS2812B_Shader_Rainbow(uint16_t index, uint32_t time, const void *ctx,
+                                            uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    const ws2812b_shader_params_t *p = ctx;
+    uint32_t phase = p->period_ms ? ((time % p->period_ms) * 360U) / p->period_ms : 0;
+    uint16_t hue = (p->hue + phase + (uint32_t)index * p->spacing) % 360U;
+
+    WS2812B_HSVToRGB(hue, p->sat, p->val, red, green, blue);
+}
+
+/**
+ * @brief Whole-strip breathing shader (10% to `val`).
+ * @note ctx is a @ref ws2812b_shader_params_t.
+ */
+WS2812B_RAMFUNC void WS2812B_Shader_Breathe(uint16_t index, uint32_t time, const void *ctx,
+                                            uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    const ws2812b_shader_params_t *p = ctx;
+    uint8_t val = p->val;
+    (void)index;
+
+    if (p->period_ms >= 2 && p->val > 10)
+    {
+        uint32_t half = p->period_ms / 2U;
+        uint32_t ph = time % p->period_ms;
+        uint32_t level = (ph < half) ? ph : (p->period_ms - ph);
+        if (level > half) level = half;
+        val = 10 + (uint8_t)((level * (p->val - 10U)) / half);
+    }
+
+    WS2812B_HSVToRGB(p->hue, p->sat, val, red, green, blue);
+}
+
+/**
+ * @brief Theater chase shader.
+ * @note ctx is a @ref ws2812b_shader_params_t.
+ */
+WS2812B_RAMFUNC void WS2812B_Shader_Chase(uint16_t index, uint32_t time, const void *ctx,
+                                          uint8_t *red, uint8_t *green, uint8_t *blue)
+{
+    const ws2812b_shader_params_t *p = ctx;
+    uint16_t spacing = p->spacing ? p->spacing : 3;
+    uint32_t step = p->period_ms ? ((time % p->period_ms) * spacing) / p->period_ms : 0;
+
+    if (index % spacing == step)
+    {
+        WS2812B_HSVToRGB(p->hue, p->sat, p->val, red, green, blue);
+    }
+    else
+    {
+        *red = *green = *blue = 0;
+    }
+}
@@ -0,0 +1,290 @@
+/**
+ * @file WS2812B_Tween.c
+ * @brief Jitter buffer with a smoothed presentation timeline and 8-bit lerp output.
+ *
+ * Frames are kept in a ring with their presentation time (pts) and arrival
+ * time. Encode drops every frame whose successor is already due, then blends
+ * the front frame towards the next one with a weight of
+ * (t - pts0) * 256 / (pts1 - pts0). The weight is a plain 0–256 integer, so
+ * the per-LED cost is two multiplies and a shift per channel on top of the
+ * normal encode.
+ */
+
+#include "WS2812B_Tween.h"
+#include "WS2812B_Frame.h"
+
+_Static_assert(WS2812B_TWEEN_DEPTH >= 2 && WS2812B_TWEEN_DEPTH <= 255, "WS2812B_TWEEN_DEPTH must be 2–255");
+
+static uint8_t tween_buf[WS2812B_TWEEN_DEPTH][LED_NUM][3];
+static uint32_t tween_pts[WS2812B_TWEEN_DEPTH];
+static uint32_t tween_arrival[WS2812B_TWEEN_DEPTH];
+static uint32_t tween_serial[WS2812B_TWEEN_DEPTH];    ///< Frame number, identifies the output
+static uint8_t tween_head = 0;
+static uint8_t tween_count = 0;
+
+static uint16_t tween_delay = WS2812B_TWEEN_DELAY_MS;
+static uint32_t last_pts = 0;
+static uint32_t last_arrival = 0;
+static uint32_t interval_q4 = 0;    ///< Average arrival interval, ms x 16
+static uint32_t jitter_q4 = 0;      ///< Average interval deviation, ms x 16
+static uint32_t latency_q4 = 0;     ///< Average latency, ms x 16
+static bool front_shown = false;    ///< Front frame has been output at full weight
+static bool holding = false;        ///< Underrun counted for the current hold
+
+// Last output, to skip sending identical frames
+static uint32_t out_serial = 0;
+static uint16_t out_weight = 0;
+static uint16_t out_scale = 256;
+static bool out_valid = false;
+
+static ws2812b_tween_stats_t stats;
+
+/**
+ * @brief Ring slot of the n-th buffered frame (0 = front).
+ */
+static inline uint8_t tween_slot(uint8_t n)
+{
+    uint32_t slot = (uint32_t)tween_head + n;
+    return (uint8_t)((slot >= WS2812B_TWEEN_DEPTH) ? slot - WS2812B_TWEEN_DEPTH : slot);
+}
+
+/**
+ * @brief Drop the front frame.
+ */
+static void tween_pop(void)
+{
+    tween_head = tween_slot(1);
+    tween_count--;
+    front_shown = false;
+}
+
+/**
+ * @brief Record the latency of the front frame, now shown at full weight.
+ */
+static void tween_record_latency(uint32_t now)
+{
+    uint32_t latency = now - tween_arrival[tween_head];
+    if (latency > 0xFFFF) latency = 0xFFFF;
+
+    if (latency_q4 == 0)
+    {
+        latency_q4 = latency << 4;
+    }
+    else
+    {
+        latency_q4 = (uint32_t)((int32_t)latency_q4 + ((int32_t)(latency << 4) - (int32_t)latency_q4) / 8);
+    }
+
+    stats.latency_ms = (uint16_t)latency;
+    stats.latency_avg_ms = (uint16_t)((latency_q4 + 8) >> 4);
+    if (latency > stats.latency_max_ms) stats.latency_max_ms = (uint16_t)latency;
+    front_shown = true;
+}
+
+/**
+ * @brief Empty the buffer and clear the statistics.
+ */
+void WS2812B_Tween_Reset(void)
+{
+    tween_head = 0;
+    tween_count = 0;
+    interval_q4 = 0;
+    jitter_q4 = 0;
+    latency_q4 = 0;
+    front_shown = false;
+    holding = false;
+    out_valid = false;
+    stats = (ws2812b_tween_stats_t){ 0 };
+}
+
+/**
+ * @brief Set the playout delay (empties the buffer).
+ */
+void WS2812B_Tween_SetDelay(uint16_t delay_ms)
+{
+    tween_delay = delay_ms;
+    tween_count = 0;
+    front_shown = false;
+    out_valid = false;
+}
+
+/**
+ * @brief Current playout delay in ms.
+ */
+uint16_t WS2812B_Tween_GetDelay(void)
+{
+    return tween_delay;
+}
+
+/**
+ * @brief Copy the framebuffer into the jitter buffer and give it a presentation time.
+ * @param now Arrival time in ms
+ */
+void WS2812B_Tween_Push(uint32_t now)
+{
+    uint32_t dt = now - last_arrival;
+    uint32_t pts = now;
+
+    if (tween_delay == 0)
+    {
+        tween_count = 0;    // Pass-through: only the newest frame
+    }
+    else if (tween_count == 0 || dt > WS2812B_TWEEN_RESYNC_MS)
+    {
+        if (tween_count != 0) stats.resyncs++;
+        tween_count = 0;    // (Re)start the timeline at this frame
+    }
+    else
+    {
+        int32_t err;
+        if (interval_q4 == 0)
+        {
+            interval_q4 = dt << 4;
+            err = 0;
+        }
+        else
+        {
+            err = (int32_t)(dt << 4) - (int32_t)interval_q4;
+            interval_q4 = (uint32_t)((int32_t)interval_q4 + err / 8);
+        }
+        if (err < 0) err = -err;
+        jitter_q4 = (uint32_t)((int32_t)jitter_q4 + (err - (int32_t)jitter_q4) / 8);
+
+        // Even spacing, pulled 1/8 of the way towards the real arrival so the
+        // timeline tracks the source clock, and never further than delay/2 from it
+        const int32_t half = tween_delay / 2;
+        pts = last_pts + ((interval_q4 + 8) >> 4);
+        int32_t lead = (int32_t)(pts - now);
+        pts -= (uint32_t)(lead / 8);
+        lead -= lead / 8;
+        if (lead > half || lead < -half)
+        {
+            pts = (lead > half) ? now + (uint32_t)half : now - (uint32_t)half;
+            stats.resyncs++;
+        }
+        if ((int32_t)(pts - last_pts) <= 0) pts = last_pts + 1;
+
+        // Held after an underrun: restart the held frame at the playout time so the output does not jump
+        uint32_t play = now - tween_delay;
+        if (tween_count == 1 && (int32_t)(play - tween_pts[tween_head]) > 0 && (int32_t)(pts - play) > 0)
+        {
+            tween_pts[tween_head] = play;
+        }
+
+        stats.interval_ms = (uint16_t)((interval_q4 + 8) >> 4);
+        stats.jitter_ms = (uint16_t)((jitter_q4 + 8) >> 4);
+    }
+
+    if (tween_count == WS2812B_TWEEN_DEPTH)
+    {
+        tween_pop();
+        stats.overflows++;
+    }
+    if (tween_count == 0)
+    {
+        tween_head = 0;
+        front_shown = false;
+    }
+
+    uint8_t slot = tween_slot(tween_count);
+    for (uint16_t i = 0; i < LED_NUM; i++)
+    {
+        WS2812B_Frame_GetPixelRGB(i, &tween_buf[slot][i][0], &tween_buf[slot][i][1], &tween_buf[slot][i][2]);
+    }
+    tween_pts[slot] = pts;
+    tween_arrival[slot] = now;
+    tween_serial[slot] = ++stats.frames;
+    tween_count++;
+
+    last_pts = pts;
+    last_arrival = now;
+    holding = false;
+}
+
+/**
+ * @brief Encode the output frame for time @p now into the PWM buffer.
+ * @return false if there is nothing new to send.
+ */
+WS2812B_RAMFUNC bool WS2812B_Tween_Encode(uint32_t now)
+{
+    if (tween_count == 0) return false;
+
+    const uint32_t play = now - tween_delay;
+
+    // Skip every frame whose successor is already due
+    while (tween_count >= 2 && (int32_t)(play - tween_pts[tween_slot(1)]) >= 0)
+    {
+        tween_pop();
+    }
+
+    const uint8_t front = tween_head;
+    const int32_t since = (int32_t)(play - tween_pts[front]);
+    uint16_t weight = 0;
+
+    if (since >= 0 && !front_shown)
+    {
+        tween_record_latency(now);
+    }
+
+    if (tween_count >= 2 && since > 0)
+    {
+        uint32_t span = tween_pts[tween_slot(1)] - tween_pts[front];
+        weight = (uint16_t)(((uint32_t)since << 8) / span);     // 1–255: play < pts1
+    }
+    else if (tween_count == 1 && front_shown && !holding && stats.interval_ms != 0 &&
+             tween_delay != 0 && since > stats.interval_ms)
+    {
+        stats.underruns++;  // Next frame overdue: hold this one
+        holding = true;
+    }
+
+    const uint16_t scale = WS2812B_GetOutputScale();
+    if (out_valid && out_serial == tween_serial[front] && out_weight == weight && out_scale == scale) return false;
+    out_valid = true;
+    out_serial = tween_serial[front];
+    out_weight = weight;
+    out_scale = scale;     // The current limiter changes it under a held frame
+
+    const uint8_t (*a)[3] = tween_buf[front];
+    ws2812b_pwm_t *dst = pwmData;
+
+    if (weight == 0)
+    {
+        for (uint16_t i = 0; i < LED_NUM; i++, dst += 24)
+        {
+            WS2812B_EncodeRGB(dst, a[i][0], a[i][1], a[i][2]);
+        }
+        return true;
+    }
+
+    const uint8_t (*b)[3] = tween_buf[tween_slot(1)];
+    const uint32_t wa = 256U - weight;
+    for (uint16_t i = 0; i < LED_NUM; i++, dst += 24)
+    {
+        WS2812B_EncodeRGB(dst,
+                          (uint8_t)((a[i][0] * wa + b[i][0] * weight) >> 8),
+                          (uint8_t)((a[i][1] * wa + b[i][1] * weight) >> 8),
+                          (uint8_t)((a[i][2] * wa + b[i][2] * weight) >> 8));
+    }
+    return true;
+}
+
+/**
+ * @brief Encode and transmit the output frame if it changed.
+ */
+void WS2812B_Tween_Show(void)
+{
+    if (WS2812B_Tween_Encode(HAL_GetTick()))
+    {
+        WS2812B_Send();
+    }
+}
+
+/**
+ * @brief Copy the statistics.
+ * @param[out] out Statistics
+ */
+void WS2812B_Tween_GetStats(ws2812b_tween_stats_t *out)
+{
+    *out = stats;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file WS2812B_Warm.c
+ * @brief Warm-restart support using checksummed .noinit RAM.
+ *
+ * pwmData itself is the saved frame (it is placed in .noinit), so saving a
+ * frame only costs one checksum pass at WS2812B_Send(). The engine snapshot
+ * is a copy of @ref ws2812b_effects_t, the phases the effect code keeps
+ * outside it (@ref ws2812b_effects_phase_t) and global brightness/speed.
+ */
+
+#include "WS2812B_Warm.h"
+#include <stddef.h>
+#include <string.h>
+
+/** @brief Magic value, mixed with the layout so a firmware change invalidates old data. */
+#define WARM_MAGIC  (0x57534232UL ^ ((uint32_t)LED_NUM << 8) ^ ((uint32_t)(sizeof(ws2812b_effects_t) + sizeof(ws2812b_effects_phase_t)) << 24))
+
+/**
+ * @brief Data preserved across warm resets.
+ */
+typedef struct {
+    uint32_t frame_magic;           ///< WARM_MAGIC when frame_sum is valid
+    uint32_t frame_sum;             ///< Checksum of pwmData at the last send
+    uint32_t state_magic;           ///< WARM_MAGIC when the snapshot is valid
+    ws2812b_effects_t effects;      ///< Engine state snapshot
+    ws2812b_effects_phase_t phase;  ///< Rainbow, chase, breathe, fire and auto-cycle phases
+    uint8_t brightness;             ///< Global brightness at snapshot time
+    uint8_t speed;                  ///< Global speed at snapshot time
+    uint32_t state_sum;             ///< Checksum of the snapshot fields
+} ws2812b_warm_t;
+
+static WS2812B_NOINIT ws2812b_warm_t warm;
+
+/** @brief HAL tick at which the first frame of this boot was latched (0 = none yet). */
+static uint32_t first_frame_tick = 0;
+
+/**
+ * @brief Rotate-and-add checksum (cheap enough to run on every send).
+ * @param data Data to check
+ * @param len Length in bytes (multiple of 2)
+ * @return Checksum.
+ */
+static uint32_t warm_checksum(const void *data, uint32_t len)
+{
+    const uint16_t *p = data;
+    uint32_t sum = WARM_MAGIC;
+
+    for (uint32_t i = 0; i < len / 2; i++)
+    {
+        sum = ((sum << 1) | (sum >> 31)) + p[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Checksum of the snapshot fields (everything between the magic and the sum).
+ */
+static uint32_t warm_state_checksum(void)
+{
+    return warm_checksum(&warm.effects, offsetof(ws2812b_warm_t, state_sum) - offsetof(ws2812b_warm_t, effects));
+}
+
+/**
+ * @brief Record the checksum of pwmData and the first-latch time.
+ * @note Called by WS2812B_Send() right before the DMA starts.
+ */
+void WS2812B_Warm_FrameSent(void)
+{
+    warm.frame_sum = warm_checksum(pwmData, sizeof(pwmData));
+    warm.frame_magic = WARM_MAGIC;
+
+    if (first_frame_tick == 0)
+    {
+        // Transmission time at 1.25 µs per slot, rounded up to whole ms (>= 1)
+        first_frame_tick = HAL_GetTick() + ((WS2812B_DATA_SIZE + 50) * 5U / 4U + 999U) / 1000U;
+    }
+}
+
+/**
+ * @brief Re-send the frame that was on the strip before the reset.
+ * @return true if a valid frame was found and sent, false on cold boot.
+ */
+bool WS2812B_Warm_ResendLastFrame(void)
+{
+    if (warm.frame_magic != WARM_MAGIC) return false;
+    if (warm.frame_sum != warm_checksum(pwmData, sizeof(pwmData)))
+    {
+        warm.frame_magic = 0;
+        return false;
+    }
+
+    WS2812B_Send();
+    return true;
+}
+
+/**
+ * @brief Snapshot the engine state.
+ * @param effects Current effect state.
+ * @note Call once per frame after WS2812B_Effects_Handle().
+ */
+void WS2812B_Warm_Save(const ws2812b_effects_t* effects)
+{
+    warm.state_magic = 0;  // Invalid while being written
+    memcpy(&warm.effects, effects, sizeof(warm.effects));
+    WS2812B_Effects_GetPhase(&warm.phase);
+    warm.brightness = WS2812B_GetBrightness();
+    warm.speed = WS2812B_GetSpeed();
+    warm.state_sum = warm_state_checksum();
+    warm.state_magic = WARM_MAGIC;
+}
+
+/**
+ * @brief Restore the engine state saved before the reset.
+ * @param[out] effects Effect state to restore into.
+ * @return true if a valid snapshot was restored, false on cold boot.
+ */
+bool WS2812B_Warm_Restore(ws2812b_effects_t* effects)
+{
+    if (warm.state_magic != WARM_MAGIC || warm.state_sum != warm_state_checksum())
+    {
+        warm.state_magic = 0;
+        return false;
+    }
+
+    memcpy(effects, &warm.effects, sizeof(*effects));
+    WS2812B_Effects_SetPhase(&warm.phase);
+    WS2812B_SetBrightness(warm.brightness);
+    WS2812B_SetSpeed(warm.speed);
+    return true;
+}
+
+/**
+ * @brief Invalidate the saved frame and state.
+ */
+void WS2812B_Warm_Invalidate(void)
+{
+    warm.frame_magic = 0;
+    warm.state_magic = 0;
+}
+
+/**
+ * @brief HAL tick at which the first frame after HAL_Init() was latched.
+ * @return Tick of the first latch, or 0 if no frame was sent yet.
+ */
+uint32_t WS2812B_Warm_FirstFrameTick(void)
+{
+    return first_frame_tick;
+}
@@ -24,19 +24,63 @@
 #include <stdlib.h>
 #include "WS2812B.h"          // Note: updated to uppercase filename
 #include "WS2812B_Effects.h"  // Consistent with new naming
+#include "WS2812B_Script.h"
+#include "WS2812B_Profile.h"
+#include "WS2812B_Frame.h"
+#include "WS2812B_Palette.h"
+#include "WS2812B_Warm.h"
+#include "WS2812B_Control.h"
+#include "WS2812B_Input.h"
+#include "WS2812B_Preset.h"
+#include "WS2812B_Schedule.h"
+#include "WS2812B_Protocol.h"
+#include "WS2812B_Cycle.h"
+#include "WS2812B_Blend.h"
+#include "WS2812B_Pattern.h"
+#include "WS2812B_Playlist.h"
+#include "WS2812B_Tween.h"
+#include "WS2812B_Record.h"
+#include "WS2812B_Current.h"
 
 /* Private variables ---------------------------------------------------------*/
 TIM_HandleTypeDef htim3;
 DMA_HandleTypeDef hdma_tim3_ch1_trig;
+RTC_HandleTypeDef hrtc;
+UART_HandleTypeDef huart1;
+DMA_HandleTypeDef hdma_usart1_rx;
+#ifdef WS2812B_CURRENT
+ADC_HandleTypeDef hadc1;
+DMA_HandleTypeDef hdma_adc1;
+#endif
 
 // Effect manager (replaces manual state machine)
 ws2812b_effects_t led_effects;
 
+// Clock path actually running (HSE, or HSI fallback if the crystal fails)
+volatile clock_path_t system_clock_path = CLOCK_PATH_HSE_72MHZ;
+
+#ifdef WS2812B_SCHEDULE
+// Shop-front day plan: preset index, brightness target, ramp length
+static const ws2812b_schedule_entry_t led_schedule[] = {
+    { WS2812B_SCHEDULE_TIME(7, 0),  0,                     80, 15 * 60 },  // Open: rainbow, ramp up
+    { WS2812B_SCHEDULE_TIME(19, 0), 2,                     40, 30 * 60 },  // Evening: calm
+    { WS2812B_SCHEDULE_TIME(23, 0), WS2812B_SCHEDULE_KEEP, 5,  60 * 60 },  // Night: dim slowly
+};
+#endif
+
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_DMA_Init(void);
 static void MX_TIM3_Init(void);
+static void MX_RTC_Init(void);
+static void MX_USART1_UART_Init(void);
+#ifdef WS2812B_CURRENT
+static void MX_ADC1_Init(void);
+#endif
+#ifdef WS2812B_BENCHMARK
+static void WS2812B_RunBenchmarks(void);
+#endif
 
 /* Private user code ---------------------------------------------------------*/
 
@@ -52,17 +96,64 @@ int main(void)
   MX_TIM3_Init();
 
   /* USER CODE BEGIN 2 */
-  // Initialize LED driver
-  WS2812B_Clear();
-  WS2812B_Send();
+  // Cycle counter from here on: profiling, and the LSE start-up jitter seeds the playlist shuffle
+  WS2812B_Profile_Init();
+
+  // Match bit timings to the clock tree that actually started (HSE or HSI fallback)
+  WS2812B_InitTiming();
+
+  // Initialize LED driver (after a warm reset, re-latch the last frame first).
+  // Needs only TIM3 + DMA, so it runs before the slower peripherals below
+  if (!WS2812B_Warm_ResendLastFrame())
+  {
+    WS2812B_Clear();
+    WS2812B_Send();
+  }
+
+  // RTC after the re-send: MX_RTC_Init() waits up to 5 s for the LSE on a cold start
+  MX_RTC_Init();
+  MX_USART1_UART_Init();
+
+  // Button/encoder events are posted from EXTI + SysTick, applied once per frame
+  WS2812B_Input_Init();
+
+  // Resume the effect engine after a warm reset, otherwise start fresh
+  if (!WS2812B_Warm_Restore(&led_effects))
+  {
+    // Optional: configure global settings
+    WS2812B_SetBrightness(80);  // 80% brightness for HSV effects
+    WS2812B_SetSpeed(40);       // Medium animation speed
+
+    // Initialize effect system (auto-cycling every 4 seconds)
+    WS2812B_Effects_Init(&led_effects);
+    led_effects.cycle_duration = 4000;
+  }
+
+  // Host commands and streamed frames over USART1 (parsed in the render loop)
+  WS2812B_Protocol_Start(&huart1);
+
+  // Stored playlist (starts itself if it was saved with PLAYLIST_FLAG_AUTOSTART)
+  WS2812B_Playlist_Init();
+
+#ifdef WS2812B_SCHEDULE
+  // Time-of-day scenes: evaluated by the RTC second interrupt
+  WS2812B_Schedule_Init(led_schedule, sizeof(led_schedule) / sizeof(led_schedule[0]));
+#endif
+
+#ifdef WS2812B_CURRENT
+  // Closed-loop supply current limit: shunt amplifier on PA0, sampled by ADC1 + DMA
+  MX_ADC1_Init();
+  WS2812B_Current_Start(&hadc1);
+#endif
 
-  // Optional: configure global settings
-  WS2812B_SetBrightness(80);  // 80% brightness for HSV effects
-  WS2812B_SetSpeed(40);       // Medium animation speed
+#ifdef WS2812B_RECORD
+  // Log inputs and frame checksums from boot (dump with CMD_RECORD, replay on the host)
+  WS2812B_Record_Start(&led_effects, true);
+#endif
 
-  // Initialize effect system (auto-cycling every 4 seconds)
-  WS2812B_Effects_Init(&led_effects);
-  led_effects.cycle_duration = 4000;
+#ifdef WS2812B_BENCHMARK
+  WS2812B_RunBenchmarks();
+#endif
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -70,8 +161,34 @@ int main(void)
   while (1)
   {
     /* OPTION 1: Use built-in effect manager (recommended) */
-    WS2812B_Effects_Handle(&led_effects);
-    HAL_Delay(50); // Small delay to reduce CPU load
+    // Take ISR-published parameters/commands once per frame, never mid-frame
+    WS2812B_Protocol_Poll();
+    WS2812B_Record_BeginFrame();
+    WS2812B_Current_Tick();   // Output scale from the current drawn by the last frame
+    if (WS2812B_Control_Apply(&led_effects))
+    {
+      if (WS2812B_Protocol_StreamActive())
+      {
+        // Host is streaming: play its frames out of the jitter buffer, tweened to the local rate
+        WS2812B_Protocol_TakeFrame();
+        WS2812B_Tween_Show();
+        WS2812B_Record_EndFrame(FRAME_STREAM);
+      }
+      else
+      {
+        WS2812B_Preset_Tick(&led_effects);  // Advances a preset crossfade, if any
+        WS2812B_Playlist_Tick(&led_effects);
+        WS2812B_Effects_Handle(&led_effects);
+        WS2812B_Record_EndFrame(FRAME_EFFECTS);
+      }
+    }
+    else
+    {
+      WS2812B_Off();
+      WS2812B_Record_EndFrame(FRAME_OFF);
+    }
+    WS2812B_Warm_Save(&led_effects);
+    HAL_Delay(WS2812B_Protocol_StreamActive() ? WS2812B_TWEEN_FRAME_MS : 50); // Small delay to reduce CPU load
 
     /*
      * OPTION 2: Manual color demos (uncomment to test specific conversions)
@@ -135,7 +252,22 @@ void SystemClock_Config(void)
   RCC_OscInitStruct.PLL.PLLMUL = RCC_PLL_MUL9;
   if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
   {
-    Error_Handler();
+    /* USER CODE BEGIN HSE_Fallback */
+    /* HSE did not start: run from HSI/2 x 16 = 64 MHz instead of halting.
+     * WS2812B_InitTiming() recomputes the TIM3 period and pulse widths. */
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE | RCC_OSCILLATORTYPE_HSI;
+    RCC_OscInitStruct.HSEState = RCC_HSE_OFF;
+    RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+    RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+    RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+    RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI_DIV2;
+    RCC_OscInitStruct.PLL.PLLMUL = RCC_PLL_MUL16;
+    if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+    {
+      Error_Handler();
+    }
+    system_clock_path = CLOCK_PATH_HSI_64MHZ;
+    /* USER CODE END HSE_Fallback */
   }
 
   /** Initializes the CPU, AHB and APB buses clocks
@@ -212,6 +344,96 @@ static void MX_TIM3_Init(void)
 
 }
 
+/**
+  * @brief RTC Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_RTC_Init(void)
+{
+
+  /* USER CODE BEGIN RTC_Init 0 */
+  /* The RTC runs from the 32.768 kHz LSE in the backup domain, so it keeps
+   * counting across resets. Without a crystal the RTC stays disabled and
+   * the schedule never fires. */
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_PeriphCLKInitTypeDef PeriphClkInit = {0};
+
+  __HAL_RCC_PWR_CLK_ENABLE();
+  __HAL_RCC_BKP_CLK_ENABLE();
+  HAL_PWR_EnableBkUpAccess();
+
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_LSE;
+  RCC_OscInitStruct.LSEState = RCC_LSE_ON;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+  {
+    return;
+  }
+
+  PeriphClkInit.PeriphClockSelection = RCC_PERIPHCLK_RTC;
+  PeriphClkInit.RTCClockSelection = RCC_RTCCLKSOURCE_LSE;
+  if (HAL_RCCEx_PeriphCLKConfig(&PeriphClkInit) != HAL_OK)
+  {
+    return;
+  }
+  __HAL_RCC_RTC_ENABLE();
+  /* USER CODE END RTC_Init 0 */
+
+  /* USER CODE BEGIN RTC_Init 1 */
+
+  /* USER CODE END RTC_Init 1 */
+
+  /** Initialize RTC Only
+  */
+  hrtc.Instance = RTC;
+  hrtc.Init.AsynchPrediv = RTC_AUTO_1_SECOND;
+  hrtc.Init.OutPut = RTC_OUTPUTSOURCE_NONE;
+  if (HAL_RTC_Init(&hrtc) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN RTC_Init 2 */
+  // Below the button/encoder EXTIs; the schedule only posts commands
+  HAL_NVIC_SetPriority(RTC_IRQn, 2, 0);
+  HAL_NVIC_EnableIRQ(RTC_IRQn);
+  /* USER CODE END RTC_Init 2 */
+
+}
+
+/**
+  * @brief USART1 Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_USART1_UART_Init(void)
+{
+
+  /* USER CODE BEGIN USART1_Init 0 */
+
+  /* USER CODE END USART1_Init 0 */
+
+  /* USER CODE BEGIN USART1_Init 1 */
+
+  /* USER CODE END USART1_Init 1 */
+  huart1.Instance = USART1;
+  huart1.Init.BaudRate = WS2812B_PROTOCOL_BAUD;
+  huart1.Init.WordLength = UART_WORDLENGTH_8B;
+  huart1.Init.StopBits = UART_STOPBITS_1;
+  huart1.Init.Parity = UART_PARITY_NONE;
+  huart1.Init.Mode = UART_MODE_TX_RX;
+  huart1.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+  huart1.Init.OverSampling = UART_OVERSAMPLING_16;
+  if (HAL_UART_Init(&huart1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN USART1_Init 2 */
+
+  /* USER CODE END USART1_Init 2 */
+
+}
+
 /**
   * Enable DMA controller clock
   */
@@ -223,6 +445,9 @@ static void MX_DMA_Init(void)
 
   /* DMA interrupt init */
   /* DMA1_Channel6_IRQn interrupt configuration */
+  /* DMA1_Channel5_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel5_IRQn, 3, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel5_IRQn);
   HAL_NVIC_SetPriority(DMA1_Channel6_IRQn, 0, 0);
   HAL_NVIC_EnableIRQ(DMA1_Channel6_IRQn);
 
@@ -235,6 +460,7 @@ static void MX_DMA_Init(void)
   */
 static void MX_GPIO_Init(void)
 {
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
   /* USER CODE BEGIN MX_GPIO_Init_1 */
 
   /* USER CODE END MX_GPIO_Init_1 */
@@ -242,6 +468,26 @@ static void MX_GPIO_Init(void)
   /* GPIO Ports Clock Enable */
   __HAL_RCC_GPIOD_CLK_ENABLE();
   __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+
+  /*Configure GPIO pin : BTN_Pin */
+  GPIO_InitStruct.Pin = BTN_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  HAL_GPIO_Init(BTN_GPIO_Port, &GPIO_InitStruct);
+
+  /*Configure GPIO pins : ENC_A_Pin ENC_B_Pin */
+  GPIO_InitStruct.Pin = ENC_A_Pin|ENC_B_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+
+  /* EXTI interrupt init*/
+  HAL_NVIC_SetPriority(EXTI0_IRQn, 1, 0);
+  HAL_NVIC_EnableIRQ(EXTI0_IRQn);
+
+  HAL_NVIC_SetPriority(EXTI9_5_IRQn, 1, 0);
+  HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
 
   /* USER CODE BEGIN MX_GPIO_Init_2 */
 
@@ -249,6 +495,340 @@ static void MX_GPIO_Init(void)
 }
 
 /* USER CODE BEGIN 4 */
+#ifdef WS2812B_BENCHMARK
+/**
+ * @brief Benchmark results in CPU cycles (inspect with the debugger).
+ */
+typedef struct {
+  uint32_t script_resume;     ///< One WS2812B_Script_Tick() resuming one idle script
+  uint32_t pixel_rgb;         ///< WS2812B_SetPixelRGB() (24-bit encode)
+  uint32_t pixel_hsv;         ///< WS2812B_SetPixelHSV() (conversion + encode)
+  uint32_t pixel_hsl;         ///< WS2812B_SetPixelHSL() (conversion + encode)
+  uint32_t pixel_hsv16;       ///< WS2812B_SetPixelHSV16() (16-bit hue conversion + encode)
+  uint32_t rainbow_recompute; ///< Rainbow frame, HSV conversion + encode for every LED
+  uint32_t rainbow_scroll;    ///< Rainbow frame via WS2812B_Frame_Scroll() + encode
+  uint32_t rainbow_mirror2;   ///< Rainbow frame at WS2812B_MIRROR_2 (half the LEDs + mirror copy)
+  uint32_t rainbow_scale2;    ///< Rainbow frame at render scale 2 (half the conversions + lerp encode)
+  uint32_t rainbow_scale4;    ///< Rainbow frame at render scale 4
+  uint32_t rainbow_cached;    ///< Rainbow frame played back from WS2812B_Cycle (encode only)
+  uint32_t blend_rgb;         ///< Crossfade frame, RGB lerp into WS2812B_Frame + encode
+  uint32_t blend_hsv;         ///< Crossfade frame, HSV lerp into WS2812B_HSVFrame + convert/encode
+  uint32_t chase_modulo;      ///< Theater chase frame, i % 3 test + WS2812B_SetPixelRGB() per LED
+  uint32_t chase_pattern;     ///< Theater chase frame via WS2812B_Pattern_Encode()
+  uint32_t fill_rgb;          ///< WS2812B_SetColorRGB() (encode once + replicate)
+  uint32_t indexed_encode;    ///< WS2812B_Indexed_Encode() (palette lookup + encode)
+  uint32_t first_frame_ms;    ///< HAL_Init() to first latched frame, ms (startup code before main() excluded)
+  uint32_t protocol_frame;    ///< WS2812B_Protocol_Feed() of one full raw frame packet
+  uint32_t protocol_rle;      ///< WS2812B_Protocol_Feed() of one full frame as 4-LED runs
+  uint32_t tween_push;        ///< WS2812B_Tween_Push() (framebuffer copy into the jitter buffer)
+  uint32_t tween_lerp;        ///< WS2812B_Tween_Encode() between two frames (lerp + encode)
+} ws2812b_bench_t;
+
+volatile ws2812b_bench_t ws2812b_bench;
+
+/**
+ * @brief Script that only yields, used to measure pure resume overhead.
+ */
+static bool Bench_YieldScript(ws2812b_script_t *s)
+{
+  WS2812B_SCRIPT_BEGIN(s);
+  for (;;)
+  {
+    WS2812B_SCRIPT_YIELD(s);
+  }
+  WS2812B_SCRIPT_END(s);
+}
+
+/**
+ * @brief Measure driver hot paths with the DWT cycle counter.
+ * @note Build with -DWS2812B_BENCHMARK; results land in @ref ws2812b_bench.
+ */
+static void WS2812B_RunBenchmarks(void)
+{
+  uint32_t cycles;
+
+  WS2812B_Profile_Init();
+
+  ws2812b_bench.first_frame_ms = WS2812B_Warm_FirstFrameTick();
+
+  WS2812B_Script_StopAll();
+  WS2812B_Script_Start(Bench_YieldScript, NULL);
+  WS2812B_PROFILE(cycles, for (int i = 0; i < 1000; i++) WS2812B_Script_Tick());
+  ws2812b_bench.script_resume = cycles / 1000;
+  WS2812B_Script_StopAll();
+
+  /* Compare against a -DWS2812B_NO_RAMFUNC build to see the flash wait-state cost */
+  WS2812B_PROFILE(cycles, WS2812B_SetPixelRGB(0, 0x55, 0xAA, 0x0F));
+  ws2812b_bench.pixel_rgb = cycles;
+  WS2812B_PROFILE(cycles, WS2812B_SetPixelHSV(0, 200, 80, 90));
+  ws2812b_bench.pixel_hsv = cycles;
+  WS2812B_PROFILE(cycles, WS2812B_SetPixelHSL(0, 200, 80, 40));
+  ws2812b_bench.pixel_hsl = cycles;
+  WS2812B_PROFILE(cycles, WS2812B_SetPixelHSV16(0, WS2812B_HUE16(200) + 91, 80, 90));
+  ws2812b_bench.pixel_hsv16 = cycles;
+
+  /* Build with -DLED_NUM=300 for the long-strip comparison */
+  WS2812B_PROFILE(cycles, for (int i = 0; i < LED_NUM; i++) WS2812B_SetPixelHSV(i, (2 + (i * 360) / LED_NUM) % 360, 100, 80));
+  ws2812b_bench.rainbow_recompute = cycles;
+  WS2812B_SetMirror(WS2812B_MIRROR_2);
+  WS2812B_PROFILE(cycles, for (int i = 0; i < WS2812B_RenderLength(); i++) WS2812B_SetPixelHSV(i, (2 + (i * 360) / WS2812B_RenderLength()) % 360, 100, 80); WS2812B_ApplyMirror());
+  ws2812b_bench.rainbow_mirror2 = cycles;
+  WS2812B_SetMirror(WS2812B_MIRROR_NONE);
+  for (int i = 0; i < LED_NUM; i++)
+  {
+    WS2812B_Frame_SetPixelHSV(i, (i * 360) / LED_NUM, 100, 80);
+  }
+  WS2812B_PROFILE(cycles, WS2812B_Frame_Scroll(1); WS2812B_Frame_Encode());
+  ws2812b_bench.rainbow_scroll = cycles;
+
+  /* Full-frame render + encode cost per scale; compare against rainbow_recompute */
+  WS2812B_Frame_SetScale(2);
+  WS2812B_PROFILE(cycles, for (int i = 0; i < WS2812B_Frame_Length(); i++) WS2812B_Frame_SetPixelHSV(i, (i * 360) / WS2812B_Frame_Length(), 100, 80); WS2812B_Frame_Encode());
+  ws2812b_bench.rainbow_scale2 = cycles;
+  WS2812B_Frame_SetScale(4);
+  WS2812B_PROFILE(cycles, for (int i = 0; i < WS2812B_Frame_Length(); i++) WS2812B_Frame_SetPixelHSV(i, (i * 360) / WS2812B_Frame_Length(), 100, 80); WS2812B_Frame_Encode());
+  ws2812b_bench.rainbow_scale4 = cycles;
+  WS2812B_Frame_SetScale(1);
+
+  /* Playback cost once the period is cached; 0 if it does not fit the budget */
+  static const ws2812b_shader_params_t bench_rainbow = { 0, 100, 80, 360 / LED_NUM, 180 };
+  ws2812b_bench.rainbow_cached = 0;
+  if (WS2812B_Cycle_Prepare(0xFFFFFFFFUL, 180, LED_NUM, WS2812B_Shader_Rainbow, &bench_rainbow))
+  {
+    WS2812B_PROFILE(cycles, WS2812B_Cycle_Encode(7));
+    ws2812b_bench.rainbow_cached = cycles;
+    WS2812B_Cycle_Invalidate();
+  }
+
+  /*
+   * One scratch frame, one test at a time, so a -DLED_NUM=300 build still fits
+   * in RAM: the second crossfade source is the framebuffer itself, and the
+   * parser payload is built in place inside the packet.
+   */
+  static union {
+    uint8_t rgb[LED_NUM][3];
+    ws2812b_hsv_t hsv[LED_NUM];
+    uint8_t packet[WS2812B_PROTOCOL_MAX_PAYLOAD + WS2812B_PROTOCOL_OVERHEAD];
+  } scratch;
+
+  /* Crossfade cost per frame, RGB space vs HSV space (build with -DLED_NUM=300) */
+  for (int i = 0; i < LED_NUM; i++)
+  {
+    uint8_t r, g, b;
+    WS2812B_HSV16ToRGB((uint16_t)(i * 218), 100, 80, &scratch.rgb[i][0], &scratch.rgb[i][1], &scratch.rgb[i][2]);
+    WS2812B_HSV16ToRGB((uint16_t)(40000 - i * 100), 90, 50, &r, &g, &b);
+    WS2812B_Frame_SetPixelRGB(i, r, g, b);
+  }
+  WS2812B_PROFILE(cycles,
+    for (int i = 0; i < LED_NUM; i++)
+    {
+      uint8_t to[3];
+      uint8_t mix[3];
+      WS2812B_Frame_GetPixelRGB(i, &to[0], &to[1], &to[2]);
+      WS2812B_Blend_RGB(scratch.rgb[i], to, 100, mix);
+      WS2812B_Frame_SetPixelRGB(i, mix[0], mix[1], mix[2]);
+    }
+    WS2812B_Frame_Encode());
+  ws2812b_bench.blend_rgb = cycles;
+  for (int i = 0; i < LED_NUM; i++)
+  {
+    scratch.hsv[i] = (ws2812b_hsv_t){ (uint16_t)(i * 218), 100, 80 };
+    WS2812B_HSVFrame_SetPixel(i, (ws2812b_hsv_t){ (uint16_t)(40000 - i * 100), 90, 50 });
+  }
+  WS2812B_PROFILE(cycles, WS2812B_HSVFrame_Crossfade(scratch.hsv, WS2812B_HSVFrame_Buffer(), 100, WS2812B_HUE_SHORTEST); WS2812B_HSVFrame_Encode());
+  ws2812b_bench.blend_hsv = cycles;
+
+  static ws2812b_pattern_t bench_chase;
+  WS2812B_Pattern_FromMask(&bench_chase, 0x1, 3);
+  WS2812B_Pattern_SetColor(&bench_chase, 1, 255, 120, 0);
+  WS2812B_Pattern_SetPhase(&bench_chase, 1);
+  WS2812B_PROFILE(cycles,
+    for (int i = 0; i < LED_NUM; i++)
+    {
+      if (i % 3 == 1) WS2812B_SetPixelRGB(i, 255, 120, 0);
+      else WS2812B_SetPixelRGB(i, 0, 0, 0);
+    });
+  ws2812b_bench.chase_modulo = cycles;
+  WS2812B_PROFILE(cycles, WS2812B_Pattern_Encode(&bench_chase));
+  ws2812b_bench.chase_pattern = cycles;
+
+  /* Per-pixel fill cost for comparison: LED_NUM * pixel_rgb */
+  WS2812B_PROFILE(cycles, WS2812B_SetColorRGB(0x55, 0xAA, 0x0F));
+  ws2812b_bench.fill_rgb = cycles;
+
+  WS2812B_Palette_Rainbow(0, WS2812B_PALETTE_SIZE, 100, 80);
+  for (int i = 0; i < LED_NUM; i++)
+  {
+    WS2812B_Indexed_SetPixel(i, (uint8_t)i);
+  }
+  WS2812B_PROFILE(cycles, WS2812B_Indexed_Encode());
+  ws2812b_bench.indexed_encode = cycles;
+
+  /* Parser throughput on valid input; bytes/cycle = packet size / cycles */
+  uint8_t *packet = scratch.packet;
+  uint8_t *payload = &packet[4];
+  uint16_t payload_len = 2;
+  payload[0] = 0;
+  payload[1] = 0;
+  for (int i = 0; i < LED_NUM; i++)
+  {
+    payload[payload_len++] = (uint8_t)i;
+    payload[payload_len++] = (uint8_t)(i * 3);
+    payload[payload_len++] = (uint8_t)(255 - i);
+  }
+  uint32_t packet_len = WS2812B_Protocol_BuildPacket(PACKET_FRAME, payload, payload_len, packet);
+  WS2812B_PROFILE(cycles, WS2812B_Protocol_Feed(packet, packet_len));
+  ws2812b_bench.protocol_frame = cycles;
+
+  payload_len = 2;
+  for (int i = 0; i < LED_NUM; i += 4)
+  {
+    payload[payload_len++] = (uint8_t)((LED_NUM - i < 4) ? LED_NUM - i : 4);
+    payload[payload_len++] = (uint8_t)i;
+    payload[payload_len++] = 0x40;
+    payload[payload_len++] = 0x80;
+  }
+  packet_len = WS2812B_Protocol_BuildPacket(PACKET_FRAME_RLE, payload, payload_len, packet);
+  WS2812B_PROFILE(cycles, WS2812B_Protocol_Feed(packet, packet_len));
+  ws2812b_bench.protocol_rle = cycles;
+  WS2812B_Protocol_TakeFrame();
+
+  /* Tween overhead per streamed frame and per local frame; compare tween_lerp with rainbow_scroll */
+  WS2812B_Tween_Reset();
+  WS2812B_Tween_Push(0);
+  WS2812B_PROFILE(cycles, WS2812B_Tween_Push(40));
+  ws2812b_bench.tween_push = cycles;
+  WS2812B_PROFILE(cycles, WS2812B_Tween_Encode(40 + WS2812B_Tween_GetDelay() - 20));
+  ws2812b_bench.tween_lerp = cycles;
+  WS2812B_Tween_Reset();
+}
+#endif /* WS2812B_BENCHMARK */
+
+/**
+  * @brief UART MSP Initialization: USART1 pins, RX DMA1 channel 5 and the USART1 interrupt
+  * @note  WS2812B_Protocol_Start() switches the RX channel to circular mode and
+  *        fails if no channel is linked here. The USART1 interrupt reports
+  *        overrun/framing errors to HAL_UART_ErrorCallback().
+  * @param huart UART handle pointer
+  * @retval None
+  */
+void HAL_UART_MspInit(UART_HandleTypeDef *huart)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  if (huart->Instance == USART1)
+  {
+    __HAL_RCC_USART1_CLK_ENABLE();
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+
+    /* PA9 TX, PA10 RX */
+    GPIO_InitStruct.Pin = GPIO_PIN_9;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    GPIO_InitStruct.Pin = GPIO_PIN_10;
+    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    hdma_usart1_rx.Instance = DMA1_Channel5;
+    hdma_usart1_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_usart1_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart1_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart1_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart1_rx.Init.Mode = DMA_CIRCULAR;
+    hdma_usart1_rx.Init.Priority = DMA_PRIORITY_MEDIUM;
+    if (HAL_DMA_Init(&hdma_usart1_rx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(huart, hdmarx, hdma_usart1_rx);
+
+    HAL_NVIC_SetPriority(USART1_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
+  }
+}
+
+#ifdef WS2812B_CURRENT
+/**
+  * @brief ADC1 Initialization Function: ISENSE on channel 0, continuous, longest sample time
+  * @param None
+  * @retval None
+  */
+static void MX_ADC1_Init(void)
+{
+  ADC_ChannelConfTypeDef sConfig = {0};
+  RCC_PeriphCLKInitTypeDef PeriphClkInit = {0};
+
+  /* ADC clock: PCLK2 / 6 = 12 MHz (10.7 MHz on the HSI fallback), below the 14 MHz limit */
+  PeriphClkInit.PeriphClockSelection = RCC_PERIPHCLK_ADC;
+  PeriphClkInit.AdcClockSelection = RCC_ADCPCLK2_DIV6;
+  if (HAL_RCCEx_PeriphCLKConfig(&PeriphClkInit) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  hadc1.Instance = ADC1;
+  hadc1.Init.ScanConvMode = ADC_SCAN_DISABLE;
+  hadc1.Init.ContinuousConvMode = ENABLE;
+  hadc1.Init.DiscontinuousConvMode = DISABLE;
+  hadc1.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+  hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
+  hadc1.Init.NbrOfConversion = 1;
+  if (HAL_ADC_Init(&hadc1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  sConfig.Channel = ADC_CHANNEL_0;
+  sConfig.Rank = ADC_REGULAR_RANK_1;
+  sConfig.SamplingTime = ADC_SAMPLETIME_239CYCLES_5;
+  if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+/**
+  * @brief ADC MSP Initialization: ISENSE pin and DMA1 channel 1
+  * @note  The DMA interrupt stays disabled: the circular buffer is only read
+  *        by WS2812B_Current_Tick(), no transfer callbacks are needed.
+  * @param hadc ADC handle pointer
+  * @retval None
+  */
+void HAL_ADC_MspInit(ADC_HandleTypeDef *hadc)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  if (hadc->Instance == ADC1)
+  {
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+
+    GPIO_InitStruct.Pin = ISENSE_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+    HAL_GPIO_Init(ISENSE_GPIO_Port, &GPIO_InitStruct);
+
+    hdma_adc1.Instance = DMA1_Channel1;
+    hdma_adc1.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_adc1.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_adc1.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_adc1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_adc1.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_adc1.Init.Mode = DMA_CIRCULAR;
+    hdma_adc1.Init.Priority = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&hdma_adc1) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(hadc, DMA_Handle, hdma_adc1);
+  }
+}
+#endif /* WS2812B_CURRENT */
 
 /* USER CODE END 4 */
 